@@ -17,10 +17,12 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBTimeStampUtils.h"
+#include "CCDB/CCDBAsyncCache.h"
 #include <string>
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 // #include <FairLogger.h>
 
@@ -44,10 +46,24 @@ class CCDBManagerInstance
     std::string uuid;
     long startvalidity = 0;
     long endvalidity = 0;
-    bool isValid(long ts) { return ts < endvalidity && ts > startvalidity; }
+    size_t size = 0;    // estimated memory footprint (size of the serialized object)
+    size_t lastUse = 0; // for LRU eviction
+    bool isValid(long ts) { return ts < endvalidity && ts >= startvalidity; }
   };
 
  public:
+  /// cache statistics: queries served from the cache (incl. confirmed by the server as not modified), objects downloaded,
+  /// objects evicted to respect the memory limit, currently cached objects and their estimated size
+  struct CacheStat {
+    size_t nHits = 0;
+    size_t nMisses = 0;
+    size_t nEvictions = 0;
+    size_t nObjects = 0;
+    size_t nBytes = 0;
+  };
+  static constexpr size_t DefaultCacheMemoryLimit = 1024 * 1024 * 1024;
+
+
   CCDBManagerInstance(std::string const& path) : mCCDBAccessor{}
   {
     mCCDBAccessor.init(path);
@@ -94,10 +110,31 @@ class CCDBManagerInstance
   bool isHostReachable() const { return mCCDBAccessor.isHostReachable(); }
 
   /// clear all entries in the cache
-  void clearCache() { mCache.clear(); }
+  void clearCache();
+
+  /// clear particular entry (all its validity intervals) in the cache
+  void clearCache(std::string const& path);
+
+  /// Set the memory budget for the cached objects (0 = no limit): when it is exceeded, the least recently used objects
+  /// are evicted. The last object served for every path is never evicted, so that the pointers held by the user stay valid
+  /// as long as the same path is not queried again.
+  void setCacheMemoryLimit(size_t bytes)
+  {
+    mCacheMemoryLimit = bytes;
+    evictCache();
+  }
+
+  /// get the memory budget for the cached objects
+  size_t getCacheMemoryLimit() const { return mCacheMemoryLimit; }
 
-  /// clear particular entry in the cache
-  void clearCache(std::string const& path) { mCache.erase(path); }
+  /// get cache statistics
+  const CacheStat& getCacheStat() const { return mCacheStat; }
+
+  /// reset hits/misses/evictions counters
+  void resetCacheStat();
+
+  /// print cache statistics
+  void printCacheStat() const;
 
   /// check if caching is enabled
   bool isCachingEnabled() const { return mCachingEnabled; }
@@ -135,10 +172,36 @@ class CCDBManagerInstance
   /// reset the object upper validity limit
   void resetCreatedNotBefore() { mCreatedNotBefore = 0; }
 
+  /// Serve the queries via the asynchronous cache: objects are persisted in the cacheDir (if not empty), the object of the
+  /// next validity interval is prefetched in background by nThreads workers. The current URL is used, the TimeMachine limits
+  /// valid at the moment of every query.
+  void setAsyncCache(std::string const& cacheDir, int nThreads = 2);
+
+  /// disable asynchronous cache
+  void resetAsyncCache() { mAsyncCache.reset(); }
+
+  /// get asynchronous cache, if any
+  CCDBAsyncCache* getAsyncCache() const { return mAsyncCache.get(); }
+
+  /// request concurrent fetching of the objects for several paths for given timestamp (or the timestamp member), requires asynchronous cache
+  void prefetch(std::vector<std::string> const& paths, long timestamp = -1);
+
  private:
+  template <typename T>
+  T* getFromAsyncCache(std::string const& path, long timestamp);
+
+  /// cached object of the path valid for the timestamp, if any
+  CachedObject* findCachedObject(std::string const& path, long timestamp);
+  /// mark cached object as the most recently used one
+  void touchCachedObject(CachedObject& cached) { cached.lastUse = ++mCacheTick; }
+  /// add new object to the cache, replacing the cached objects of the path with overlapping validity
+  void cacheObject(std::string const& path, std::shared_ptr<void> objPtr, std::string const& uuid, long start, long end, size_t size);
+  /// evict least recently used objects until the memory limit is respected
+  void evictCache();
+
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
-  std::unordered_map<std::string, CachedObject> mCache; //! map for {path, CachedObject} associations
+  std::unordered_map<std::string, std::vector<CachedObject>> mCache; //! map for {path, CachedObjects of different validity intervals} associations
   std::map<std::string, std::string> mMetaData;         // some dummy object needed to talk to CCDB API
   std::map<std::string, std::string> mHeaders;          // headers to retrieve tags
   long mTimestamp{o2::ccdb::getCurrentTimestamp()};     // timestamp to be used for query (by default "now")
@@ -147,39 +210,79 @@ class CCDBManagerInstance
   bool mCheckObjValidityEnabled = false;                // wether the validity of cached object is checked before proceeding to a CCDB API query
   long mCreatedNotAfter = 0;                            // upper limit for object creation timestamp (TimeMachine mode) - If-Not-After HTTP header
   long mCreatedNotBefore = 0;                           // lower limit for object creation timestamp (TimeMachine mode) - If-Not-Before HTTP header
+  std::shared_ptr<CCDBAsyncCache> mAsyncCache;          //! optional asynchronous, persistent cache
+  std::string mAsyncCacheDir;                           //! directory of asynchronous cache
+  int mAsyncCacheThreads = 0;                           //! number of workers of asynchronous cache
+  size_t mCacheMemoryLimit = DefaultCacheMemoryLimit;   // memory budget of cached objects, 0 = no limit
+  size_t mCacheTick = 0;                                //! counter for LRU ordering
+  CacheStat mCacheStat;                                 //! cache statistics
 };
 
 template <typename T>
 T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
 {
+  if (mAsyncCache) {
+    return getFromAsyncCache<T>(path, timestamp);
+  }
   if (!isCachingEnabled()) {
     return mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, nullptr, "",
                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
   }
-  auto& cached = mCache[path];
-  if (mCheckObjValidityEnabled && cached.isValid(timestamp)) {
-    return reinterpret_cast<T*>(cached.objPtr.get());
+  auto cached = findCachedObject(path, timestamp);
+  if (mCheckObjValidityEnabled && cached) {
+    mCacheStat.nHits++;
+    touchCachedObject(*cached);
+    return reinterpret_cast<T*>(cached->objPtr.get());
   }
 
-  T* ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
+  T* ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached ? cached->uuid : "",
                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
-  if (ptr) { // new object was shipped, old one (if any) is not valid anymore
-    cached.objPtr.reset(ptr);
-    cached.uuid = mHeaders["ETag"];
-    cached.startvalidity = std::stol(mHeaders["Valid-From"]);
-    cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
+  if (ptr) { // new object was shipped, old one for this timestamp (if any) is not valid anymore
+    mCacheStat.nMisses++;
+    cacheObject(path, std::shared_ptr<void>(ptr), mHeaders["ETag"], std::stol(mHeaders["Valid-From"]), std::stol(mHeaders["Valid-Until"]),
+                std::stoul(mHeaders["Object-Size"]));
   } else if (mHeaders.count("Error")) { // in case of errors the pointer is 0 and headers["Error"] should be set
     clearCache(path);                   // in case of any error clear cache for this object
-  } else {                              // the old object is valid
-    ptr = reinterpret_cast<T*>(cached.objPtr.get());
+  } else if (cached) {                  // the cached object is valid
+    mCacheStat.nHits++;
+    touchCachedObject(*cached);
+    ptr = reinterpret_cast<T*>(cached->objPtr.get());
   }
   mHeaders.clear();
   mMetaData.clear();
   return ptr;
 }
 
+template <typename T>
+T* CCDBManagerInstance::getFromAsyncCache(std::string const& path, long timestamp)
+{
+  auto blob = mAsyncCache->get(path, timestamp, mMetaData, {mCreatedNotAfter, mCreatedNotBefore});
+  mMetaData.clear();
+  if (!blob) {
+    clearCache(path);
+    return nullptr;
+  }
+  if (!isCachingEnabled()) {
+    return CcdbApi::extractFromImage<T>(blob->image);
+  }
+  auto cached = findCachedObject(path, timestamp);
+  if (cached && cached->uuid == blob->etag && cached->startvalidity == blob->startValidity) { // the same object as before
+    mCacheStat.nHits++;
+    touchCachedObject(*cached);
+    return reinterpret_cast<T*>(cached->objPtr.get());
+  }
+  T* ptr = CcdbApi::extractFromImage<T>(blob->image);
+  if (!ptr) {
+    clearCache(path);
+    return nullptr;
+  }
+  mCacheStat.nMisses++;
+  cacheObject(path, std::shared_ptr<void>(ptr), blob->etag, blob->startValidity, blob->endValidity, blob->image.size());
+  return ptr;
+}
+
 class BasicCCDBManager : public CCDBManagerInstance
 {
  public:
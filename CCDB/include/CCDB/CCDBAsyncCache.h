@@ -0,0 +1,186 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBAsyncCache.h
+/// \brief  Persistent on-disk cache of CCDB objects with asynchronous fetching and prefetching of the next validity interval
+///
+
+#ifndef O2_CCDB_ASYNCCACHE_H
+#define O2_CCDB_ASYNCCACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::ccdb
+{
+
+class CcdbApi;
+
+/// serialized CCDB object (image of the TFile) together with the headers of the reply
+struct CCDBBlob {
+  std::vector<char> image;
+  std::map<std::string, std::string> headers;
+  long startValidity = 0;
+  long endValidity = 0;
+  std::string etag;
+
+  bool isValid(long ts) const { return ts >= startValidity && ts < endValidity; }
+  /// extract validity and ETag from the Valid-From, Valid-Until and ETag headers, return false if validity is missing
+  bool setFromHeaders();
+};
+
+/// TimeMachine mode limits on the object creation time (If-Not-After and If-Not-Before HTTP headers), 0 means no limit
+struct CCDBCreationLimits {
+  long notAfter = 0;
+  long notBefore = 0;
+
+  bool isSet() const { return notAfter || notBefore; }
+};
+
+/// source of the CCDB blobs, by default the CCDB server (see CcdbApiBlobSource), can be replaced e.g. by a local stand-in
+class CCDBBlobSource
+{
+ public:
+  virtual ~CCDBBlobSource() = default;
+  /// fetch the object stored under the path, valid for the timestamp and created within the limits, return false if there is none
+  virtual bool fetch(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBCreationLimits const& limits, CCDBBlob& blob) const = 0;
+};
+
+/// blob source querying the CCDB via CcdbApi (server or file:// snapshot)
+class CcdbApiBlobSource : public CCDBBlobSource
+{
+ public:
+  CcdbApiBlobSource(std::string const& url);
+  ~CcdbApiBlobSource() override;
+  bool fetch(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBCreationLimits const& limits, CCDBBlob& blob) const final;
+
+ private:
+  std::unique_ptr<CcdbApi> mApi;
+};
+
+/// Cache of CCDB blobs which does not block the caller more than necessary:
+/// - the blobs are kept in memory (up to MaxBlobsInMemory validity intervals per path) and, if the cache directory is
+///   provided, on disk in the files content-addressed by path, metadata, TimeMachine limits, validity and ETag, so that they
+///   survive the process;
+/// - requests are served by a pool of worker threads, so that several paths can be fetched concurrently;
+/// - once the object for some timestamp was served, the object of the next validity interval is prefetched in background.
+/// The requests still queued when the cache is destroyed are rejected with an exception.
+/// The class is thread safe.
+class CCDBAsyncCache
+{
+ public:
+  using BlobPtr = std::shared_ptr<const CCDBBlob>;
+  using Metadata = std::map<std::string, std::string>;
+  static constexpr size_t MaxBlobsInMemory = 3;
+
+  CCDBAsyncCache(std::shared_ptr<const CCDBBlobSource> source, std::string const& cacheDir = "", int nThreads = 2);
+  ~CCDBAsyncCache();
+  CCDBAsyncCache(const CCDBAsyncCache&) = delete;
+  CCDBAsyncCache& operator=(const CCDBAsyncCache&) = delete;
+
+  /// blob valid for the timestamp, from memory, disk or, blocking, from the source; nullptr if it does not exist
+  BlobPtr get(std::string const& path, long timestamp, Metadata const& metadata = {}, CCDBCreationLimits const& limits = {});
+
+  /// asynchronous version of get, executed by the worker threads
+  std::shared_future<BlobPtr> request(std::string const& path, long timestamp, Metadata const& metadata = {}, CCDBCreationLimits const& limits = {});
+
+  /// request concurrently the objects of all paths valid for the timestamp
+  void prefetch(std::vector<std::string> const& paths, long timestamp, Metadata const& metadata = {}, CCDBCreationLimits const& limits = {});
+
+  /// wait until all pending requests are served
+  void waitPending();
+
+  /// enable/disable prefetching of the next validity interval
+  void setPrefetchNext(bool v) { mPrefetchNext = v; }
+  bool isPrefetchNext() const { return mPrefetchNext; }
+
+  /// drop blobs kept in memory, the disk cache is kept
+  void clearMemory();
+
+  const std::string& getCacheDir() const { return mCacheDir; }
+  int getNThreads() const { return mWorkers.size(); }
+  size_t getNMemoryHits() const { return mNMemoryHits; }
+  size_t getNDiskHits() const { return mNDiskHits; }
+  size_t getNFetches() const { return mNFetches; }
+  size_t getNPrefetches() const { return mNPrefetches; }
+
+  /// name of the cache file of the blob
+  static std::string getCacheFileName(std::string const& cacheDir, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits,
+                                      long startValidity, long endValidity, std::string const& etag);
+
+ private:
+  struct DiskItem {
+    long startValidity = 0;
+    long endValidity = 0;
+    std::string etag;
+    std::string fileName;
+  };
+  struct PathCache {
+    std::deque<BlobPtr> blobs; // in memory, most recently used last
+    std::vector<DiskItem> disk;
+    bool diskScanned = false;
+    int nPending = 0; // number of requests being served
+    long failedPrefetch = -1; // timestamp of the last unsuccessful prefetch, not to repeat it
+  };
+
+  struct Task {
+    std::function<void()> run;
+    std::function<void()> reject; // called instead of run if the cache is destroyed before the task started, may be empty
+  };
+
+  static std::string getKey(std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits);
+  static std::string getCacheDirName(std::string const& cacheDir, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits);
+
+  BlobPtr serve(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits, bool isPrefetch);
+  BlobPtr findInMemory(PathCache& pc, long timestamp);
+  BlobPtr loadFromDisk(PathCache& pc, std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits, std::unique_lock<std::mutex>& lock);
+  void scanDisk(PathCache& pc, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits);
+  void addToMemory(PathCache& pc, BlobPtr blob);
+  void schedulePrefetch(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits);
+  void submit(Task&& task);
+  void workerLoop();
+
+  std::shared_ptr<const CCDBBlobSource> mSource;
+  std::string mCacheDir;
+  bool mPrefetchNext = true;
+
+  std::mutex mMutex;
+  std::condition_variable mPendingCV; // notified when a request for some path is served
+  std::unordered_map<std::string, PathCache> mCache;
+
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueCV;
+  std::deque<Task> mQueue;
+  size_t mNRunning = 0;
+  std::condition_variable mIdleCV;
+  bool mStop = false;
+  std::vector<std::thread> mWorkers;
+
+  std::atomic<size_t> mNMemoryHits{0};
+  std::atomic<size_t> mNDiskHits{0};
+  std::atomic<size_t> mNFetches{0};
+  std::atomic<size_t> mNPrefetches{0};
+};
+
+} // namespace o2::ccdb
+
+#endif // O2_CCDB_ASYNCCACHE_H
@@ -137,7 +137,8 @@ class CcdbApi //: public DatabaseInterface
    * @param path The path where the object is to be found.
    * @param metadata Key-values representing the metadata to filter out objects.
    * @param timestamp Timestamp of the object to retrieve. If omitted, current timestamp is used.
-   * @param headers Map to be populated with the headers we received, if it is not null.
+   * @param headers Map to be populated with the headers we received, if it is not null. If the object is returned,
+   *                the size of its serialized image is stored in the Object-Size entry.
    * @param optional etag from previous call
    * @param optional createdNotAfter upper time limit for the object creation timestamp (TimeMachine mode)
    * @param optional createdNotBefore lower time limit for the object creation timestamp (TimeMachine mode)
@@ -148,6 +149,28 @@ class CcdbApi //: public DatabaseInterface
                           long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                           const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * Retrieve the serialized image (TFile content) of the object at the given path for the given timestamp,
+   * without deserializing it. Redirections are followed, the headers of the reply (Valid-From, Valid-Until, ETag...)
+   * are stored in the headers map. In snapshot mode the snapshot file and its stored headers are returned.
+   *
+   * @return true if the object was found
+   */
+  bool retrieveImage(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp,
+                     std::vector<char>& image, std::map<std::string, std::string>& headers,
+                     const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
+
+  /**
+   * Extract the object of type T from the serialized image obtained e.g. by retrieveImage.
+   * @return the object, or nullptr if the image is not a valid TFile or type does not match serialized type.
+   */
+  template <typename T>
+  static T* extractFromImage(std::vector<char> const& image)
+  {
+    return static_cast<T*>(extractFromImage(image, typeid(T)));
+  }
+  static void* extractFromImage(std::vector<char> const& image, std::type_info const& tinfo);
+
   /**
    * Delete all versions of the object at this path.
    *
@@ -354,9 +377,10 @@ class CcdbApi //: public DatabaseInterface
    * Helper function to download binary content from alien:// storage
    * @param fullUrl The alien URL
    * @param tcl The TClass object describing the serialized type
+   * @param contentSize if not null, set to the size of the downloaded file
    * @return raw pointer to created object
    */
-  void* downloadAlienContent(std::string const& fullUrl, std::type_info const& tinfo) const;
+  void* downloadAlienContent(std::string const& fullUrl, std::type_info const& tinfo, size_t* contentSize = nullptr) const;
 
   // initialize the TGrid (Alien connection)
   bool initTGrid() const;
@@ -364,8 +388,8 @@ class CcdbApi //: public DatabaseInterface
   bool checkAlienToken() const;
 
   /// Queries the CCDB server and navigates through possible redirects until binary content is found; Retrieves content as instance
-  /// given by tinfo if that is possible. Returns nullptr if something fails...
-  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers) const;
+  /// given by tinfo if that is possible. Returns nullptr if something fails... The size of the downloaded content is stored in contentSize, if not null
+  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers, size_t* contentSize = nullptr) const;
 
   // helper that interprets a content chunk as TMemFile and extracts the object therefrom
   void* interpretAsTMemFileAndExtract(char* contentptr, size_t contentsize, std::type_info const& tinfo) const;
@@ -13,7 +13,9 @@
 // Created by Sandro Wenzel on 2019-08-14.
 //
 #include "CCDB/BasicCCDBManager.h"
+#include <FairLogger.h>
 #include <string>
+#include <algorithm>
 
 namespace o2
 {
@@ -23,6 +25,117 @@ namespace ccdb
 void CCDBManagerInstance::setURL(std::string const& url)
 {
   mCCDBAccessor.init(url);
+  if (mAsyncCache) { // the cache must query the new URL
+    setAsyncCache(mAsyncCacheDir, mAsyncCacheThreads);
+  }
+}
+
+void CCDBManagerInstance::setAsyncCache(std::string const& cacheDir, int nThreads)
+{
+  mAsyncCacheDir = cacheDir;
+  mAsyncCacheThreads = nThreads;
+  mAsyncCache.reset(); // finish the pending requests of the previous cache first
+  auto source = std::make_shared<CcdbApiBlobSource>(getURL());
+  mAsyncCache = std::make_shared<CCDBAsyncCache>(source, cacheDir, nThreads);
+  clearCache();
+}
+
+void CCDBManagerInstance::clearCache()
+{
+  mCache.clear();
+  mCacheStat.nObjects = mCacheStat.nBytes = 0;
+}
+
+void CCDBManagerInstance::clearCache(std::string const& path)
+{
+  auto it = mCache.find(path);
+  if (it == mCache.end()) {
+    return;
+  }
+  for (const auto& cached : it->second) {
+    mCacheStat.nObjects--;
+    mCacheStat.nBytes -= cached.size;
+  }
+  mCache.erase(it);
+}
+
+CCDBManagerInstance::CachedObject* CCDBManagerInstance::findCachedObject(std::string const& path, long timestamp)
+{
+  auto it = mCache.find(path);
+  if (it == mCache.end()) {
+    return nullptr;
+  }
+  for (auto& cached : it->second) {
+    if (cached.isValid(timestamp)) {
+      return &cached;
+    }
+  }
+  return nullptr;
+}
+
+void CCDBManagerInstance::cacheObject(std::string const& path, std::shared_ptr<void> objPtr, std::string const& uuid, long start, long end, size_t size)
+{
+  auto& objects = mCache[path];
+  // objects with overlapping validity were superseded (at least for some timestamps), drop them
+  auto overlapping = std::remove_if(objects.begin(), objects.end(), [start, end](const CachedObject& c) { return c.startvalidity < end && start < c.endvalidity; });
+  for (auto it = overlapping; it != objects.end(); ++it) {
+    mCacheStat.nObjects--;
+    mCacheStat.nBytes -= it->size;
+  }
+  objects.erase(overlapping, objects.end());
+  objects.push_back(CachedObject{std::move(objPtr), uuid, start, end, size, ++mCacheTick});
+  mCacheStat.nObjects++;
+  mCacheStat.nBytes += size;
+  evictCache();
+}
+
+void CCDBManagerInstance::evictCache()
+{
+  while (mCacheMemoryLimit && mCacheStat.nBytes > mCacheMemoryLimit) {
+    // find the least recently used object which is not the last one served for its path
+    std::vector<CachedObject>* lruObjects = nullptr;
+    size_t lruIndex = 0, lruTick = -1;
+    for (auto& [path, objects] : mCache) {
+      if (objects.size() < 2) {
+        continue;
+      }
+      auto latest = std::max_element(objects.begin(), objects.end(), [](const CachedObject& a, const CachedObject& b) { return a.lastUse < b.lastUse; });
+      for (size_t i = 0; i < objects.size(); i++) {
+        if (objects.begin() + i != latest && objects[i].lastUse < lruTick) {
+          lruObjects = &objects;
+          lruIndex = i;
+          lruTick = objects[i].lastUse;
+        }
+      }
+    }
+    if (!lruObjects) { // only objects in use are left
+      break;
+    }
+    mCacheStat.nEvictions++;
+    mCacheStat.nObjects--;
+    mCacheStat.nBytes -= (*lruObjects)[lruIndex].size;
+    lruObjects->erase(lruObjects->begin() + lruIndex);
+  }
+}
+
+void CCDBManagerInstance::resetCacheStat()
+{
+  mCacheStat.nHits = mCacheStat.nMisses = mCacheStat.nEvictions = 0;
+}
+
+void CCDBManagerInstance::printCacheStat() const
+{
+  LOG(INFO) << "CCDB cache: " << mCacheStat.nHits << " hits, " << mCacheStat.nMisses << " misses, " << mCacheStat.nEvictions << " evictions, "
+            << mCacheStat.nObjects << " objects of " << mCacheStat.nBytes << " bytes cached, limit " << mCacheMemoryLimit << " bytes";
+}
+
+void CCDBManagerInstance::prefetch(std::vector<std::string> const& paths, long timestamp)
+{
+  if (!mAsyncCache) {
+    LOG(WARNING) << "Prefetching requires asynchronous cache, see setAsyncCache";
+    return;
+  }
+  mAsyncCache->prefetch(paths, timestamp < 0 ? mTimestamp : timestamp, {}, {mCreatedNotAfter, mCreatedNotBefore});
 }
 
 } // namespace ccdb
@@ -0,0 +1,405 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBAsyncCache.cxx
+/// \brief  Persistent on-disk cache of CCDB objects with asynchronous fetching and prefetching of the next validity interval
+///
+
+#include "CCDB/CCDBAsyncCache.h"
+#include "CCDB/CcdbApi.h"
+#include <FairLogger.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace o2::ccdb
+{
+
+namespace
+{
+// keep only characters which are safe in file names
+std::string sanitizeETag(std::string const& etag)
+{
+  std::string res;
+  std::copy_if(etag.begin(), etag.end(), std::back_inserter(res), [](char c) { return std::isalnum(c) || c == '-'; });
+  return res;
+}
+
+// among the entries valid for the timestamp select the one with the latest start of validity
+template <typename IT, typename GET>
+IT findValid(IT first, IT last, long timestamp, GET get)
+{
+  IT best = last;
+  for (auto it = first; it != last; ++it) {
+    const auto& item = get(*it);
+    if (timestamp >= item.startValidity && timestamp < item.endValidity && (best == last || item.startValidity > get(*best).startValidity)) {
+      best = it;
+    }
+  }
+  return best;
+}
+} // namespace
+
+//______________________________________________________________________
+bool CCDBBlob::setFromHeaders()
+{
+  auto from = headers.find("Valid-From"), until = headers.find("Valid-Until");
+  if (from == headers.end() || until == headers.end()) {
+    return false;
+  }
+  try {
+    startValidity = std::stol(from->second);
+    endValidity = std::stol(until->second);
+  } catch (std::exception const& e) {
+    LOG(ERROR) << "Failed to parse validity " << from->second << " : " << until->second;
+    return false;
+  }
+  auto tag = headers.find("ETag");
+  etag = tag == headers.end() ? "" : sanitizeETag(tag->second);
+  return true;
+}
+
+//______________________________________________________________________
+CcdbApiBlobSource::CcdbApiBlobSource(std::string const& url) : mApi(std::make_unique<CcdbApi>())
+{
+  mApi->init(url);
+}
+
+CcdbApiBlobSource::~CcdbApiBlobSource() = default;
+
+bool CcdbApiBlobSource::fetch(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBCreationLimits const& limits, CCDBBlob& blob) const
+{
+  return mApi->retrieveImage(path, metadata, timestamp, blob.image, blob.headers,
+                             limits.notAfter ? std::to_string(limits.notAfter) : "",
+                             limits.notBefore ? std::to_string(limits.notBefore) : "");
+}
+
+//______________________________________________________________________
+CCDBAsyncCache::CCDBAsyncCache(std::shared_ptr<const CCDBBlobSource> source, std::string const& cacheDir, int nThreads)
+  : mSource(std::move(source)), mCacheDir(cacheDir)
+{
+  if (!mSource) {
+    throw std::runtime_error("CCDBAsyncCache needs a valid blob source");
+  }
+  if (!mCacheDir.empty()) {
+    std::filesystem::create_directories(mCacheDir);
+  }
+  for (int i = 0; i < std::max(1, nThreads); i++) {
+    mWorkers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+CCDBAsyncCache::~CCDBAsyncCache()
+{
+  std::deque<Task> notStarted;
+  {
+    std::lock_guard<std::mutex> guard(mQueueMutex);
+    mStop = true;
+    notStarted.swap(mQueue);
+  }
+  mQueueCV.notify_all();
+  for (auto& w : mWorkers) {
+    w.join();
+  }
+  for (auto& task : notStarted) {
+    if (task.reject) {
+      task.reject();
+    }
+  }
+}
+
+//______________________________________________________________________
+std::string CCDBAsyncCache::getKey(std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  std::string key = path;
+  for (const auto& [k, v] : metadata) {
+    key += "/" + k + "=" + v;
+  }
+  if (limits.isSet()) { // the same path and timestamp may correspond to different objects for different TimeMachine limits
+    key += "/If-Not-After=" + std::to_string(limits.notAfter) + "/If-Not-Before=" + std::to_string(limits.notBefore);
+  }
+  return key;
+}
+
+std::string CCDBAsyncCache::getCacheDirName(std::string const& cacheDir, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  std::string dir = cacheDir + "/" + path;
+  if (!metadata.empty() || limits.isSet()) {
+    std::stringstream hash;
+    hash << std::hex << std::hash<std::string>{}(getKey("", metadata, limits));
+    dir += "/md_" + hash.str();
+  }
+  return dir;
+}
+
+std::string CCDBAsyncCache::getCacheFileName(std::string const& cacheDir, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits,
+                                             long startValidity, long endValidity, std::string const& etag)
+{
+  return getCacheDirName(cacheDir, path, metadata, limits) + "/" + std::to_string(startValidity) + "_" + std::to_string(endValidity) + "_" + sanitizeETag(etag) + ".root";
+}
+
+//______________________________________________________________________
+CCDBAsyncCache::BlobPtr CCDBAsyncCache::get(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  auto blob = serve(path, timestamp, metadata, limits, false);
+  if (blob && mPrefetchNext) {
+    schedulePrefetch(path, blob->endValidity, metadata, limits);
+  }
+  return blob;
+}
+
+std::shared_future<CCDBAsyncCache::BlobPtr> CCDBAsyncCache::request(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  auto promise = std::make_shared<std::promise<BlobPtr>>();
+  std::shared_future<BlobPtr> res = promise->get_future();
+  submit({[this, promise, path, timestamp, metadata, limits]() {
+            try {
+              promise->set_value(get(path, timestamp, metadata, limits));
+            } catch (...) {
+              promise->set_exception(std::current_exception());
+            }
+          },
+          [promise, path]() {
+            promise->set_exception(std::make_exception_ptr(std::runtime_error("CCDBAsyncCache was destroyed before the request for " + path + " was served")));
+          }});
+  return res;
+}
+
+void CCDBAsyncCache::prefetch(std::vector<std::string> const& paths, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  for (const auto& path : paths) {
+    request(path, timestamp, metadata, limits);
+  }
+}
+
+void CCDBAsyncCache::waitPending()
+{
+  std::unique_lock<std::mutex> lock(mQueueMutex);
+  mIdleCV.wait(lock, [this]() { return mQueue.empty() && mNRunning == 0; });
+}
+
+void CCDBAsyncCache::clearMemory()
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  for (auto& [key, pc] : mCache) {
+    pc.blobs.clear();
+  }
+}
+
+//______________________________________________________________________
+CCDBAsyncCache::BlobPtr CCDBAsyncCache::serve(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits, bool isPrefetch)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  auto& pc = mCache[getKey(path, metadata, limits)]; // references to unordered_map elements are stable
+  while (true) {
+    if (auto blob = findInMemory(pc, timestamp)) {
+      if (!isPrefetch) {
+        mNMemoryHits++;
+      }
+      return blob;
+    }
+    if (auto blob = loadFromDisk(pc, path, timestamp, metadata, limits, lock)) {
+      if (!isPrefetch) {
+        mNDiskHits++;
+      }
+      return blob;
+    }
+    if (!pc.nPending) {
+      break;
+    }
+    // another request for this path may be bringing the object we need, wait for it rather than querying in parallel
+    mPendingCV.wait(lock);
+  }
+  pc.nPending++;
+  lock.unlock();
+
+  auto blob = std::make_shared<CCDBBlob>();
+  bool ok = false;
+  try {
+    ok = mSource->fetch(path, metadata, timestamp, limits, *blob) && blob->setFromHeaders();
+  } catch (std::exception const& e) {
+    LOG(ERROR) << "Failed to fetch " << path << " for timestamp " << timestamp << ": " << e.what();
+  }
+  (isPrefetch ? mNPrefetches : mNFetches)++;
+  DiskItem item;
+  if (ok && !mCacheDir.empty()) { // write outside of the lock
+    item = DiskItem{blob->startValidity, blob->endValidity, blob->etag, getCacheFileName(mCacheDir, path, metadata, limits, blob->startValidity, blob->endValidity, blob->etag)};
+    try {
+      std::filesystem::create_directories(std::filesystem::path(item.fileName).parent_path());
+      auto tmpName = item.fileName + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+      {
+        std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+        out.write(blob->image.data(), blob->image.size());
+        if (!out.good()) {
+          throw std::runtime_error("write failed");
+        }
+      }
+      std::filesystem::rename(tmpName, item.fileName); // atomic, concurrent processes see either nothing or the full file
+    } catch (std::exception const& e) {
+      LOG(WARNING) << "Failed to store " << path << " in the cache file " << item.fileName << ": " << e.what();
+      item.fileName.clear();
+    }
+  }
+
+  lock.lock();
+  BlobPtr res;
+  if (ok) {
+    if (!item.fileName.empty() && findValid(pc.disk.begin(), pc.disk.end(), timestamp, [](const DiskItem& d) -> const DiskItem& { return d; }) == pc.disk.end()) {
+      pc.disk.push_back(item);
+    }
+    addToMemory(pc, blob);
+    res = blob;
+  } else if (isPrefetch) {
+    pc.failedPrefetch = timestamp;
+  } else {
+    LOG(ERROR) << "No valid object found for " << path << " and timestamp " << timestamp;
+  }
+  pc.nPending--;
+  lock.unlock();
+  mPendingCV.notify_all();
+  return res;
+}
+
+CCDBAsyncCache::BlobPtr CCDBAsyncCache::findInMemory(PathCache& pc, long timestamp)
+{
+  auto it = findValid(pc.blobs.begin(), pc.blobs.end(), timestamp, [](const BlobPtr& b) -> const CCDBBlob& { return *b; });
+  if (it == pc.blobs.end()) {
+    return nullptr;
+  }
+  auto blob = *it;
+  pc.blobs.erase(it); // move to most recently used position
+  pc.blobs.push_back(blob);
+  return blob;
+}
+
+CCDBAsyncCache::BlobPtr CCDBAsyncCache::loadFromDisk(PathCache& pc, std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits, std::unique_lock<std::mutex>& lock)
+{
+  if (mCacheDir.empty()) {
+    return nullptr;
+  }
+  if (!pc.diskScanned) {
+    scanDisk(pc, path, metadata, limits);
+  }
+  auto it = findValid(pc.disk.begin(), pc.disk.end(), timestamp, [](const DiskItem& d) -> const DiskItem& { return d; });
+  if (it == pc.disk.end()) {
+    return nullptr;
+  }
+  const auto item = *it;
+  lock.unlock(); // read outside of the lock
+  auto blob = std::make_shared<CCDBBlob>();
+  std::ifstream inp(item.fileName, std::ios::binary);
+  blob->image.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+  blob->startValidity = item.startValidity;
+  blob->endValidity = item.endValidity;
+  blob->etag = item.etag;
+  blob->headers = {{"Valid-From", std::to_string(item.startValidity)}, {"Valid-Until", std::to_string(item.endValidity)}, {"ETag", item.etag}};
+  const bool ok = inp.good() || inp.eof();
+  lock.lock();
+  if (!ok || blob->image.empty()) {
+    LOG(WARNING) << "Failed to read cache file " << item.fileName << ", dropping it";
+    pc.disk.erase(std::remove_if(pc.disk.begin(), pc.disk.end(), [&item](const DiskItem& d) { return d.fileName == item.fileName; }), pc.disk.end());
+    return nullptr;
+  }
+  if (auto existing = findInMemory(pc, timestamp)) { // loaded concurrently by another thread
+    return existing;
+  }
+  addToMemory(pc, blob);
+  return blob;
+}
+
+void CCDBAsyncCache::scanDisk(PathCache& pc, std::string const& path, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  pc.diskScanned = true;
+  const auto dir = getCacheDirName(mCacheDir, path, metadata, limits);
+  std::error_code ec;
+  if (!std::filesystem::is_directory(dir, ec)) {
+    return;
+  }
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    if (!entry.is_regular_file() || entry.path().extension() != ".root") {
+      continue;
+    }
+    // file name is <startValidity>_<endValidity>_<etag>.root
+    const auto stem = entry.path().stem().string();
+    auto sep1 = stem.find('_'), sep2 = stem.find('_', sep1 + 1);
+    if (sep1 == std::string::npos || sep2 == std::string::npos) {
+      continue;
+    }
+    try {
+      pc.disk.push_back(DiskItem{std::stol(stem.substr(0, sep1)), std::stol(stem.substr(sep1 + 1, sep2 - sep1 - 1)), stem.substr(sep2 + 1), entry.path().string()});
+    } catch (std::exception const&) {
+      continue;
+    }
+  }
+}
+
+void CCDBAsyncCache::addToMemory(PathCache& pc, BlobPtr blob)
+{
+  pc.blobs.push_back(std::move(blob));
+  while (pc.blobs.size() > MaxBlobsInMemory) {
+    pc.blobs.pop_front(); // least recently used
+  }
+}
+
+void CCDBAsyncCache::schedulePrefetch(std::string const& path, long timestamp, Metadata const& metadata, CCDBCreationLimits const& limits)
+{
+  {
+    std::lock_guard<std::mutex> guard(mMutex);
+    auto& pc = mCache[getKey(path, metadata, limits)];
+    auto inMemory = findValid(pc.blobs.begin(), pc.blobs.end(), timestamp, [](const BlobPtr& b) -> const CCDBBlob& { return *b; }) != pc.blobs.end();
+    if (inMemory || pc.nPending || pc.failedPrefetch == timestamp) {
+      return;
+    }
+  }
+  submit({[this, path, timestamp, metadata, limits]() { serve(path, timestamp, metadata, limits, true); }, {}});
+}
+
+//______________________________________________________________________
+void CCDBAsyncCache::submit(Task&& task)
+{
+  {
+    std::lock_guard<std::mutex> guard(mQueueMutex);
+    mQueue.push_back(std::move(task));
+  }
+  mQueueCV.notify_one();
+}
+
+void CCDBAsyncCache::workerLoop()
+{
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      mQueueCV.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+      if (mStop) {
+        return;
+      }
+      task = std::move(mQueue.front());
+      mQueue.pop_front();
+      mNRunning++;
+    }
+    try {
+      task.run();
+    } catch (std::exception const& e) {
+      LOG(ERROR) << "CCDB request failed: " << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> guard(mQueueMutex);
+      mNRunning--;
+    }
+    mIdleCV.notify_all();
+  }
+}
+
+} // namespace o2::ccdb
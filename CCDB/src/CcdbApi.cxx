@@ -477,7 +477,11 @@ void* CcdbApi::extractFromLocalFile(std::string const& filename, std::type_info
       delete storedmeta;
     }
   }
-  return extractFromTFile(f, tcl);
+  auto content = extractFromTFile(f, tcl);
+  if (content && headers) { // used as the estimate of the object size by the caching layers
+    (*headers)["Object-Size"] = std::to_string(f.GetSize());
+  }
+  return content;
 }
 
 bool CcdbApi::checkAlienToken() const
@@ -513,7 +517,7 @@ bool CcdbApi::initTGrid() const
   return mAlienInstance != nullptr;
 }
 
-void* CcdbApi::downloadAlienContent(std::string const& url, std::type_info const& tinfo) const
+void* CcdbApi::downloadAlienContent(std::string const& url, std::type_info const& tinfo, size_t* contentSize) const
 {
   if (!initTGrid()) {
     return nullptr;
@@ -523,18 +527,39 @@ void* CcdbApi::downloadAlienContent(std::string const& url, std::type_info const
   if (memfile) {
     auto cl = tinfo2TClass(tinfo);
     auto content = extractFromTFile(*memfile, cl);
+    if (content && contentSize) {
+      *contentSize = memfile->GetSize();
+    }
     delete memfile;
     return content;
   }
   return nullptr;
 }
 
+void* CcdbApi::extractFromImage(std::vector<char> const& image, std::type_info const& tinfo)
+{
+  if (image.empty()) {
+    return nullptr;
+  }
+  void* result = nullptr;
+  std::lock_guard<std::mutex> guard(gIOMutex); // also protects the global ROOT error level
+  Int_t previousErrorLevel = gErrorIgnoreLevel;
+  gErrorIgnoreLevel = kFatal;
+  TMemFile memFile("name", const_cast<char*>(image.data()), image.size(), "READ");
+  gErrorIgnoreLevel = previousErrorLevel;
+  if (!memFile.IsZombie()) {
+    result = extractFromTFile(memFile, tinfo2TClass(tinfo));
+    memFile.Close();
+  }
+  return result;
+}
+
 void* CcdbApi::interpretAsTMemFileAndExtract(char* contentptr, size_t contentsize, std::type_info const& tinfo) const
 {
   void* result = nullptr;
+  std::lock_guard<std::mutex> guard(gIOMutex); // also protects the global ROOT error level
   Int_t previousErrorLevel = gErrorIgnoreLevel;
   gErrorIgnoreLevel = kFatal;
-  std::lock_guard<std::mutex> guard(gIOMutex);
   TMemFile memFile("name", contentptr, contentsize, "READ");
   gErrorIgnoreLevel = previousErrorLevel;
   if (!memFile.IsZombie()) {
@@ -549,7 +574,7 @@ void* CcdbApi::interpretAsTMemFileAndExtract(char* contentptr, size_t contentsiz
 }
 
 // navigate sequence of URLs until TFile content is found; object is extracted and returned
-void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers) const
+void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers, size_t* contentSize) const
 {
   // a global internal data structure that can be filled with HTTP header information
   // static --> to avoid frequent alloc/dealloc as optimization
@@ -558,7 +583,7 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
 
   // let's see first of all if the url is something specific that curl cannot handle
   if (url.find("alien:/", 0) != std::string::npos) {
-    return downloadAlienContent(url, tinfo);
+    return downloadAlienContent(url, tinfo, contentSize);
   }
   // add other final cases here
   // example root://
@@ -595,6 +620,9 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
     if (200 <= response_code && response_code < 300) {
       // good response and the content is directly provided and should have been dumped into "chunk"
       content = interpretAsTMemFileAndExtract(chunk.memory, chunk.size, tinfo);
+      if (content && contentSize) {
+        *contentSize = chunk.size;
+      }
     } else if (response_code == 304) {
       // this means the object exist but I am not serving
       // it since it's already in your possession
@@ -635,7 +663,7 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
       for (auto& l : locs) {
         if (l.size() > 0) {
           LOG(DEBUG) << "Trying content location " << l;
-          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr);
+          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr, contentSize);
           if (content /* or other success marker in future */) {
             break;
           }
@@ -745,11 +773,83 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
   }
   curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, list);
 
-  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers);
+  size_t contentSize = 0;
+  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers, &contentSize);
   curl_easy_cleanup(curl_handle);
+  if (content && headers) { // used as the estimate of the object size by the caching layers
+    (*headers)["Object-Size"] = std::to_string(contentSize);
+  }
   return content;
 }
 
+bool CcdbApi::retrieveImage(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp,
+                            std::vector<char>& image, std::map<std::string, std::string>& headers,
+                            const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  image.clear();
+  headers.clear();
+  if (mInSnapshotMode) {
+    auto snapshotfile = getFullUrlForRetrieval(nullptr, path, metadata, timestamp);
+    if (!std::filesystem::exists(snapshotfile)) {
+      LOG(ERROR) << "Local snapshot " << snapshotfile << " not found";
+      return false;
+    }
+    std::ifstream inp(snapshotfile, std::ios::binary);
+    image.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+    std::lock_guard<std::mutex> guard(gIOMutex);
+    TFile f(snapshotfile.c_str(), "READ");
+    auto storedmeta = retrieveMetaInfo(f);
+    if (storedmeta) {
+      headers = *storedmeta;
+      delete storedmeta;
+    }
+    return !image.empty();
+  }
+
+  CURL* curl_handle = curl_easy_init();
+  if (!curl_handle) {
+    return false;
+  }
+  string fullUrl = getFullUrlForRetrieval(curl_handle, path, metadata, timestamp);
+  struct curl_slist* list = nullptr;
+  if (!createdNotAfter.empty()) {
+    list = curl_slist_append(list, ("If-Not-After: " + createdNotAfter).c_str());
+  }
+  if (!createdNotBefore.empty()) {
+    list = curl_slist_append(list, ("If-Not-Before: " + createdNotBefore).c_str());
+  }
+  MemoryStruct chunk{(char*)malloc(1), 0};
+  curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, list);
+  curl_easy_setopt(curl_handle, CURLOPT_URL, fullUrl.c_str());
+  curl_easy_setopt(curl_handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  // follow the redirections to the content, the headers of the 1st reply (with validity) are kept since the map is not overwritten
+  curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl_handle, CURLOPT_HEADERFUNCTION, header_map_callback<>);
+  curl_easy_setopt(curl_handle, CURLOPT_HEADERDATA, (void*)&headers);
+  curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+  curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, (void*)&chunk);
+
+  bool ok = false;
+  long response_code = -1;
+  auto res = curl_easy_perform(curl_handle);
+  if (res == CURLE_OK && curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &response_code) == CURLE_OK) {
+    if (200 <= response_code && response_code < 300 && chunk.memory) {
+      image.assign(chunk.memory, chunk.memory + chunk.size);
+      ok = true;
+    } else if (response_code == 404) {
+      LOG(ERROR) << "Requested resource does not exist: " << fullUrl;
+    } else {
+      LOG(ERROR) << "Retrieval of " << fullUrl << " failed with code " << response_code;
+    }
+  } else {
+    LOG(ERROR) << "Curl request to " << fullUrl << " failed";
+  }
+  free(chunk.memory);
+  curl_slist_free_all(list);
+  curl_easy_cleanup(curl_handle);
+  return ok;
+}
+
 size_t CurlWrite_CallbackFunc_StdString2(void* contents, size_t size, size_t nmemb, std::string* s)
 {
   size_t newLength = size * nmemb;
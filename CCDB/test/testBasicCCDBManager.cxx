@@ -80,6 +80,23 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   LOG(INFO) << "Reading of A for different time slost, expect non-cached object: " << *objA;
   BOOST_CHECK(objA && (*objA) == ccdbObjN); // make sure correct object is loaded
 
+  // the object of the 1st time slot is still cached
+  objA = cdb.get<std::string>(pathA); // should get already cached and hacked object
+  LOG(INFO) << "Reading A from the 1st time slot, expect cached and modified value: " << *objA;
+  BOOST_CHECK(objA && (*objA) == hack); // make sure correct object is loaded
+  BOOST_CHECK(cdb.getCacheStat().nObjects == 3);
+  cdb.printCacheStat();
+
+  // with the minimal memory limit only the last served object of every path is kept
+  cdb.setCacheMemoryLimit(1);
+  BOOST_CHECK(cdb.getCacheStat().nObjects == 2 && cdb.getCacheStat().nEvictions == 1);
+  objA = cdb.getForTimeStamp<std::string>(pathA, stop + (stop - start) / 2); // will be loaded from scratch
+  BOOST_CHECK(objA && (*objA) == ccdbObjN);
+  objA = cdb.get<std::string>(pathA); // evicted, will be loaded from scratch
+  LOG(INFO) << "Reading A from the 1st time slot after eviction, expect non-cached object: " << *objA;
+  BOOST_CHECK(objA && (*objA) == ccdbObjO);
+  cdb.setCacheMemoryLimit(CCDBManagerInstance::DefaultCacheMemoryLimit);
+
   // clear specific object cache
   cdb.clearCache(pathA);
   objA = cdb.get<std::string>(pathA); // will be loaded from scratch and fill the cache
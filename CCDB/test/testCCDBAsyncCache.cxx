@@ -0,0 +1,194 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCCDBAsyncCache.cxx
+/// \brief  Test of the asynchronous prefetching disk cache using a file-backed CCDB stand-in
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CcdbApi.h"
+#include "CCDB/CCDBAsyncCache.h"
+#include <boost/test/unit_test.hpp>
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+/// stand-in for the CCDB server: objects are stored as <dir>/<path>/<start>_<end>.root, each fetch takes some time
+class FileBackedSource : public CCDBBlobSource
+{
+ public:
+  FileBackedSource(std::string const& dir, int latencyMS) : mDir(dir), mLatencyMS(latencyMS) {}
+
+  void store(std::string const& path, std::string const& obj, long start, long end)
+  {
+    auto image = CcdbApi::createObjectImage(&obj);
+    std::filesystem::create_directories(mDir + "/" + path);
+    std::ofstream out(mDir + "/" + path + "/" + std::to_string(start) + "_" + std::to_string(end) + ".root", std::ios::binary);
+    out.write(image->data(), image->size());
+  }
+
+  bool fetch(std::string const& path, std::map<std::string, std::string> const&, long timestamp, CCDBCreationLimits const& limits, CCDBBlob& blob) const final
+  {
+    mNFetches++;
+    mLastNotAfter = limits.notAfter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(mLatencyMS));
+    if (!std::filesystem::is_directory(mDir + "/" + path)) {
+      return false;
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(mDir + "/" + path)) {
+      const auto stem = entry.path().stem().string();
+      long start = std::stol(stem.substr(0, stem.find('_'))), end = std::stol(stem.substr(stem.find('_') + 1));
+      if (timestamp >= start && timestamp < end) {
+        std::ifstream inp(entry.path(), std::ios::binary);
+        blob.image.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+        blob.headers = {{"Valid-From", std::to_string(start)}, {"Valid-Until", std::to_string(end)}, {"ETag", "\"" + path + stem + "\""}};
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t getNFetches() const { return mNFetches; }
+  long getLastNotAfter() const { return mLastNotAfter; }
+
+ private:
+  std::string mDir;
+  int mLatencyMS = 0;
+  mutable std::atomic<size_t> mNFetches{0};
+  mutable std::atomic<long> mLastNotAfter{0};
+};
+
+std::string getObject(CCDBAsyncCache::BlobPtr blob)
+{
+  std::unique_ptr<std::string> obj(blob ? CcdbApi::extractFromImage<std::string>(blob->image) : nullptr);
+  return obj ? *obj : "";
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestCCDBAsyncCache)
+{
+  const std::string topDir = std::filesystem::temp_directory_path().string() + "/testCCDBAsyncCache_" + std::to_string(getpid());
+  const std::string cacheDir = topDir + "/cache";
+  auto source = std::make_shared<FileBackedSource>(topDir + "/ccdb", 50);
+  const std::vector<std::string> paths{"Test/A", "Test/B", "Test/C", "Test/D"};
+  for (const auto& p : paths) {
+    source->store(p, p + "_0", 0, 1000);
+    source->store(p, p + "_1", 1000, 2000);
+  }
+
+  {
+    CCDBAsyncCache cache(source, cacheDir, 4);
+    // blocking query, the next validity interval is prefetched in background
+    BOOST_CHECK(getObject(cache.get("Test/A", 500)) == "Test/A_0");
+    cache.waitPending();
+    BOOST_CHECK(source->getNFetches() == 2 && cache.getNFetches() == 1 && cache.getNPrefetches() == 1);
+    BOOST_CHECK(getObject(cache.get("Test/A", 1500)) == "Test/A_1"); // served from memory
+    BOOST_CHECK(cache.getNMemoryHits() == 1);
+    cache.waitPending(); // unsuccessful prefetch for 2000 is not repeated
+    BOOST_CHECK(getObject(cache.get("Test/A", 1600)) == "Test/A_1");
+    cache.waitPending();
+    BOOST_CHECK(source->getNFetches() == 3 && cache.getNMemoryHits() == 2);
+
+    // concurrent fetching of several paths
+    auto t0 = std::chrono::steady_clock::now();
+    cache.prefetch({"Test/B", "Test/C", "Test/D"}, 500);
+    cache.waitPending();
+    auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    BOOST_CHECK(dt < 3 * 2 * 50); // sequential would be 3 fetches + 3 prefetches
+    const auto nFetches = source->getNFetches();
+    cache.setPrefetchNext(false);
+    for (const auto& p : {"Test/B", "Test/C", "Test/D"}) {
+      BOOST_CHECK(getObject(cache.get(p, 700)) == std::string(p) + "_0");
+      BOOST_CHECK(getObject(cache.get(p, 1700)) == std::string(p) + "_1");
+    }
+    BOOST_CHECK(source->getNFetches() == nFetches);
+
+    // non-existing object
+    BOOST_CHECK(cache.get("Test/A", 5000) == nullptr);
+    BOOST_CHECK(cache.get("Test/None", 500) == nullptr);
+  }
+
+  {
+    // new instance serves from the disk cache, without querying the source
+    const auto nFetches = source->getNFetches();
+    CCDBAsyncCache cache(source, cacheDir, 2);
+    cache.setPrefetchNext(false);
+    for (const auto& p : paths) {
+      BOOST_CHECK(getObject(cache.get(p, 100)) == p + "_0");
+      BOOST_CHECK(getObject(cache.get(p, 1100)) == p + "_1");
+    }
+    cache.waitPending();
+    BOOST_CHECK(source->getNFetches() == nFetches);
+    BOOST_CHECK(cache.getNDiskHits() == 2 * paths.size());
+    BOOST_CHECK(std::filesystem::exists(CCDBAsyncCache::getCacheFileName(cacheDir, "Test/A", {}, {}, 0, 1000, "\"Test/A0_1000\"")));
+  }
+
+  {
+    // the prefetch of the next validity interval found on disk is not counted as a disk hit
+    const auto nFetches = source->getNFetches();
+    CCDBAsyncCache cache(source, cacheDir, 2);
+    BOOST_CHECK(getObject(cache.get("Test/A", 100)) == "Test/A_0");
+    cache.waitPending();
+    BOOST_CHECK(cache.getNDiskHits() == 1);
+    cache.setPrefetchNext(false);
+    BOOST_CHECK(getObject(cache.get("Test/A", 1100)) == "Test/A_1"); // served from memory
+    BOOST_CHECK(cache.getNDiskHits() == 1 && cache.getNMemoryHits() == 1);
+    BOOST_CHECK(source->getNFetches() == nFetches);
+  }
+
+  {
+    // TimeMachine limits are part of the key: the object cached without limits is not served for the query with limits
+    const auto nFetches = source->getNFetches();
+    CCDBAsyncCache cache(source, cacheDir, 2);
+    cache.setPrefetchNext(false);
+    const CCDBCreationLimits limits{12345, 0};
+    BOOST_CHECK(getObject(cache.get("Test/A", 100, {}, limits)) == "Test/A_0");
+    BOOST_CHECK(source->getNFetches() == nFetches + 1 && source->getLastNotAfter() == limits.notAfter);
+    BOOST_CHECK(getObject(cache.get("Test/A", 200, {}, limits)) == "Test/A_0");
+    BOOST_CHECK(getObject(cache.get("Test/A", 200)) == "Test/A_0");
+    BOOST_CHECK(source->getNFetches() == nFetches + 1);
+    BOOST_CHECK(std::filesystem::exists(CCDBAsyncCache::getCacheFileName(cacheDir, "Test/A", {}, limits, 0, 1000, "\"Test/A0_1000\"")));
+  }
+
+  {
+    // requests not yet started when the cache is destroyed are rejected explicitly rather than with a broken promise
+    std::vector<std::shared_future<CCDBAsyncCache::BlobPtr>> requests;
+    {
+      CCDBAsyncCache cache(source, "", 1);
+      for (long ts = 0; ts < 5; ts++) {
+        requests.push_back(cache.request("Test/None", ts));
+      }
+    }
+    int nRejected = 0;
+    for (auto& r : requests) {
+      try {
+        r.get();
+      } catch (std::future_error const& e) {
+        BOOST_ERROR("broken promise: " << e.what());
+      } catch (std::runtime_error const& e) {
+        nRejected++;
+      }
+    }
+    BOOST_CHECK(nRejected > 0);
+  }
+  std::filesystem::remove_all(topDir);
+}
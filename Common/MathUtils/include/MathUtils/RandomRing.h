@@ -110,6 +110,13 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// advance the position in the ring buffer
+  /// @param [in] n number of values to skip
+  void skip(size_t n) { mRingPosition = (mRingPosition + n) % mRandomNumbers.size(); }
+
+  /// number of random values in the ring buffer
+  static constexpr size_t size() { return N; }
+
  private:
   // =========================================================================
   // ===| members |===========================================================
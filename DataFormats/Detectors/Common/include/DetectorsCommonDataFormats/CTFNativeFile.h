@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFNativeFile.h
+/// \brief Native (ROOT-free) CTF file: raw EncodedBlocks images + index, to be memory-mapped by the reader
+
+///  File layout:
+///  [CTFNativeFileHeader][image]...[image][CTFNativeIndexEntry x nEntries]
+///  Every image is the flat EncodedBlocks buffer of one detector for one TF, starting at the offset aligned to
+///  NativeAlignment bytes, so that the mapped image can be passed directly to the EncodedBlocks::getImage
+///  (no deserialization, the image is used in place or copied as is).
+///  The index is written at the end of the file, its offset is stored in the header when the file is closed.
+
+#ifndef ALICEO2_CTF_NATIVE_FILE_H
+#define ALICEO2_CTF_NATIVE_FILE_H
+
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+struct CTFNativeFileHeader {
+  static constexpr std::array<char, 8> Magic{'O', '2', 'C', 'T', 'F', 'N', 'A', 'T'};
+  static constexpr uint32_t Version = 1;
+  static constexpr size_t NativeAlignment = 64; // alignment of images in the file, multiple of o2::ctf::Alignment
+
+  std::array<char, 8> magic = Magic;
+  uint32_t version = Version;
+  uint32_t nDetectors = o2::detectors::DetID::nDetectors; // number of detectors at the moment of writing
+  uint64_t nEntries = 0;                                  // number of stored TFs
+  uint64_t indexOffset = 0;                               // offset of the index in bytes, 0 if the file was not closed
+
+  bool isValid() const { return magic == Magic && version == Version && nDetectors == o2::detectors::DetID::nDetectors; }
+};
+
+/// index of a single TF: CTFHeader data and location of every stored detector image
+struct CTFNativeIndexEntry {
+  uint64_t run = 0;
+  uint32_t firstTForbit = 0;
+  uint32_t detectors = 0; // mask of stored detectors
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offset{};
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> size{};
+
+  CTFHeader getCTFHeader() const { return CTFHeader{run, firstTForbit, o2::detectors::DetID::mask_t(detectors)}; }
+};
+
+class CTFNativeFileWriter
+{
+ public:
+  CTFNativeFileWriter() = default;
+  CTFNativeFileWriter(const std::string& fname) { open(fname); }
+  ~CTFNativeFileWriter();
+
+  void open(const std::string& fname);
+  void close();
+  bool isOpen() const { return mFile.is_open(); }
+
+  /// start new TF entry
+  void beginTF(const CTFHeader& h);
+  /// add image of the detector to current TF, return number of bytes written
+  size_t addDetector(o2::detectors::DetID det, const void* image, size_t size);
+  /// finalize current TF entry
+  void endTF();
+
+  size_t getNEntries() const { return mIndex.size(); }
+  size_t getSize() const { return mOffset; }
+  const std::string& getFileName() const { return mFileName; }
+
+ private:
+  std::string mFileName;
+  std::ofstream mFile;
+  std::vector<CTFNativeIndexEntry> mIndex;
+  CTFNativeIndexEntry mCurrent;
+  bool mInTF = false;
+  size_t mOffset = 0; // current write position
+};
+
+class CTFNativeFileReader
+{
+ public:
+  CTFNativeFileReader() = default;
+  CTFNativeFileReader(const std::string& fname) { open(fname); }
+  CTFNativeFileReader(const CTFNativeFileReader&) = delete;
+  CTFNativeFileReader& operator=(const CTFNativeFileReader&) = delete;
+  ~CTFNativeFileReader() { close(); }
+
+  /// check if the file starts with the native CTF magic
+  static bool isNativeFile(const std::string& fname);
+
+  void open(const std::string& fname);
+  void close();
+  bool isOpen() const { return mBase != nullptr; }
+
+  size_t getNEntries() const { return mIndex.size(); }
+  const CTFNativeIndexEntry& getIndexEntry(size_t entry) const { return mIndex[entry]; }
+  CTFHeader getCTFHeader(size_t entry) const { return mIndex[entry].getCTFHeader(); }
+  bool hasDetector(size_t entry, o2::detectors::DetID det) const { return mIndex[entry].detectors & (0x1u << det); }
+  const std::string& getFileName() const { return mFileName; }
+
+  /// mapped flat image of the detector for given entry (TF), empty if the detector is absent
+  gsl::span<const BufferType> getImageBuffer(size_t entry, o2::detectors::DetID det) const;
+
+  /// EncodedBlocks wrapper of the mapped detector image, no copy is done: valid only while the file is open.
+  /// Data which must outlive the reader (e.g. DPL output messages) has to be copied from getImageBuffer
+  template <typename C>
+  const auto getImage(size_t entry, o2::detectors::DetID det) const
+  {
+    auto buff = getImageBuffer(entry, det);
+    if (buff.empty()) {
+      throw std::runtime_error(fmt::format("No {} data in entry {} of {}", det.getName(), entry, mFileName));
+    }
+    return C::getImage(buff.data());
+  }
+
+ private:
+  std::string mFileName;
+  std::vector<CTFNativeIndexEntry> mIndex;
+  const char* mBase = nullptr; // start of the mapped file
+  size_t mSize = 0;            // mapped size
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -18,6 +18,10 @@
 #define ALICEO2_ENCODED_BLOCKS_H
 
 #include <type_traits>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <Rtypes.h>
 #include "rANS/rans.h"
 #include "rANS/utils.h"
@@ -47,6 +51,25 @@ struct is_iterator<T, std::enable_if_t<
 
 template <class T>
 inline constexpr bool is_iterator_v = is_iterator<T>::value;
+
+/// invoke f with the number of interleaved rANS streams as compile time constant
+template <typename F>
+inline decltype(auto) withNStreams(int nStreams, F&& f)
+{
+  switch (nStreams) {
+    case 0: // data written before the number of streams was stored in the Metadata
+    case 2:
+      return f(std::integral_constant<size_t, 2>{});
+    case 4:
+      return f(std::integral_constant<size_t, 4>{});
+    case 8:
+      return f(std::integral_constant<size_t, 8>{});
+    case 16:
+      return f(std::integral_constant<size_t, 16>{});
+    default:
+      throw std::runtime_error(fmt::format("unsupported number of interleaved rANS streams: {}", nStreams));
+  }
+}
 } // namespace detail
 
 using namespace o2::rans;
@@ -117,6 +140,7 @@ struct Metadata {
   int nDictWords = 0;
   int nDataWords = 0;
   int nLiteralWords = 0;
+  uint8_t nStreams = 0; // number of interleaved rANS states, 0 for data encoded before it was stored (== 2 states)
 
   void clear()
   {
@@ -129,8 +153,9 @@ struct Metadata {
     nDictWords = 0;
     nDataWords = 0;
     nLiteralWords = 0;
+    nStreams = 0;
   }
-  ClassDefNV(Metadata, 1);
+  ClassDefNV(Metadata, 2);
 };
 
 /// registry struct for the buffer start and offsets of writable space
@@ -411,16 +436,16 @@ class EncodedBlocks
   template <typename VD>
   static void readFromTree(VD& vec, TTree& tree, const std::string& name, int ev = 0);
 
-  /// encode vector src to bloc at provided slot
+  /// encode vector src to bloc at provided slot, using nStreams (2, 4, 8 or 16) interleaved rANS states
   template <typename VE, typename buffer_T>
-  inline void encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr)
+  inline void encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, uint8_t nStreams = o2::rans::internal::DefaultNStreams)
   {
-    encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt);
+    encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt, nStreams);
   }
 
-  /// encode vector src to bloc at provided slot
+  /// encode vector src to bloc at provided slot, using nStreams (2, 4, 8 or 16) interleaved rANS states
   template <typename input_IT, typename buffer_T>
-  void encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr);
+  void encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, uint8_t nStreams = o2::rans::internal::DefaultNStreams);
 
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
@@ -430,6 +455,14 @@ class EncodedBlocks
   template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
   void decode(D_IT dest, int slot, const void* decoderExt = nullptr) const;
 
+  /// encode source to the slot of a new container created in the (standalone) buffer, different buffers can be filled concurrently
+  template <typename input_IT, typename buffer_T>
+  static void encodeStandalone(buffer_T& buffer, const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, const void* encoderExt = nullptr, uint8_t nStreams = o2::rans::internal::DefaultNStreams);
+
+  /// copy the block at provided slot of the standalone container src to the same slot of the container in the buffer
+  template <typename buffer_T>
+  static void storeStandalone(buffer_T& buffer, const EncodedBlocks& src, int slot);
+
   /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
   static std::vector<char> createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& prbits);
 
@@ -761,11 +794,13 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         // to D-word array
         literals = std::vector<dest_t>{reinterpret_cast<const dest_t*>(block.getLiterals()), reinterpret_cast<const dest_t*>(block.getLiterals()) + md.nLiterals};
       }
-      decoder->process(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      detail::withNStreams(md.nStreams, [&](auto nStreams) {
+        decoder->template process<decltype(nStreams)::value>(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      });
     } else { // data was stored as is
       using destPtr_t = typename std::iterator_traits<D_IT>::pointer;
       destPtr_t srcBegin = reinterpret_cast<destPtr_t>(block.payload);
-      destPtr_t srcEnd = srcBegin + md.messageLength * sizeof(dest_t);
+      destPtr_t srcEnd = srcBegin + md.messageLength;
       std::copy(srcBegin, srcEnd, dest);
       //std::memcpy(dest, block.payload, md.messageLength * sizeof(dest_t));
     }
@@ -781,7 +816,8 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
                                     uint8_t symbolTablePrecision, // encoding into
                                     Metadata::OptStore opt,       // option for data compression
                                     buffer_T* buffer,             // optional buffer (vector) providing memory for encoded blocks
-                                    const void* encoderExt)       // optional external encoder
+                                    const void* encoderExt,       // optional external encoder
+                                    uint8_t nStreams)             // number of interleaved rANS states
 {
 
   using storageBuffer_t = W;
@@ -860,7 +896,9 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
     // directly encode source message into block buffer.
     storageBuffer_t* const blockBufferBegin = thisBlock->getCreateData();
     const size_t maxBufferSize = thisBlock->registry->getFreeSize(); // note: "this" might be not valid after expandStorage call!!!
-    const auto encodedMessageEnd = encoder->process(srcBegin, srcEnd, blockBufferBegin, literals);
+    const auto encodedMessageEnd = detail::withNStreams(nStreams, [&](auto nStreamsV) {
+      return encoder->template process<decltype(nStreamsV)::value>(srcBegin, srcEnd, blockBufferBegin, literals);
+    });
     rans::utils::checkBounds(encodedMessageEnd, blockBufferBegin + maxBufferSize);
     dataSize = encodedMessageEnd - thisBlock->getData();
     thisBlock->setNData(dataSize);
@@ -892,7 +930,8 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
                              encoder->getMaxSymbol(),
                              static_cast<int32_t>(frequencyTable.size()),
                              dataSize,
-                             static_cast<int32_t>(literals.size())};
+                             static_cast<int32_t>(literals.size()),
+                             nStreams};
   } else { // store original data w/o EEncoding
     //FIXME(milettri): we should be able to do without an intermediate vector;
     // provided iterator is not necessarily pointer, need to use intermediate vector!!!
@@ -904,12 +943,48 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
 
     const size_t nBufferElems = calculateNDestTElements<input_t, storageBuffer_t>(messageLength);
     expandStorage(nBufferElems);
-    thisBlock->storeData(thisMetadata->nDataWords, reinterpret_cast<const storageBuffer_t*>(tmp.data()));
+    thisBlock->storeData(nBufferElems, reinterpret_cast<const storageBuffer_t*>(tmp.data()));
 
     *thisMetadata = Metadata{messageLength, 0, sizeof(ransState_t), sizeof(storageBuffer_t), symbolTablePrecision, opt, 0, 0, 0, static_cast<int>(nBufferElems), 0};
   }
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT, typename buffer_T>
+void EncodedBlocks<H, N, W>::encodeStandalone(buffer_T& buffer,               // buffer to create the standalone container in
+                                              const input_IT srcBegin,         // iterator begin of source message
+                                              const input_IT srcEnd,           // iterator end of source message
+                                              int slot,                        // slot in encoded data to fill
+                                              uint8_t symbolTablePrecision,    // encoding into
+                                              Metadata::OptStore opt,          // option for data compression
+                                              const void* encoderExt,          // optional external encoder
+                                              uint8_t nStreams)                // number of interleaved rANS states
+{
+  auto* eb = create(buffer);
+  eb->mRegistry.nFilledBlocks = slot; // only this slot will be filled
+  eb->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &buffer, encoderExt, nStreams);
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::storeStandalone(buffer_T& buffer, const EncodedBlocks& src, int slot)
+{
+  auto* dest = get(buffer.data());
+  assert(slot == dest->mRegistry.nFilledBlocks);
+  const auto& block = src.mBlocks[slot];
+  if (block.getNStored()) {
+    const size_t additionalSize = estimateBlockSize(block.getNStored()); // size in bytes!!!
+    if (additionalSize > dest->getFreeSize()) {
+      dest = expand(buffer, dest->size() + (additionalSize - dest->getFreeSize()));
+    }
+    dest->mBlocks[slot].store(block.getNDict(), block.getNData(), block.getNLiterals(), block.getDict(), block.getData(), block.getLiterals());
+  }
+  dest->mMetadata[slot] = src.mMetadata[slot];
+  dest->mRegistry.nFilledBlocks++;
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
@@ -939,6 +1014,244 @@ std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vect
   return std::move(vdict);
 }
 
+///>>======================== Automatic encoding choice =======================>>
+
+/// storage option, rANS precision and dictionary chosen for the block
+struct EncodingChoice {
+  Metadata::OptStore opt = Metadata::OptStore::EENCODE;
+  bool useExtDictionary = false; // use external dictionary rather than TF-local one
+  uint8_t precision = 0;         // rANS symbol table precision
+  size_t estimatedSize = 0;      // estimated size in bytes of the stored block
+};
+
+/// per-slot record of the automatic encoding: last choice and accumulated statistics
+struct BlockEncodingStat {
+  EncodingChoice choice;     // last choice
+  size_t nRaw = 0;           // number of blocks stored w/o entropy encoding
+  size_t nLocal = 0;         // number of blocks encoded with TF-local dictionary
+  size_t nExternal = 0;      // number of blocks encoded with external dictionary
+  size_t sourceBytes = 0;    // accumulated size of the source data
+  size_t encodedBytes = 0;   // accumulated size of the stored blocks
+  size_t lastSourceBytes = 0;
+  size_t lastEncodedBytes = 0;
+
+  void add(const EncodingChoice& ch, size_t src, size_t enc)
+  {
+    choice = ch;
+    if (ch.opt != Metadata::OptStore::EENCODE) {
+      nRaw++;
+    } else if (ch.useExtDictionary) {
+      nExternal++;
+    } else {
+      nLocal++;
+    }
+    sourceBytes += src;
+    encodedBytes += enc;
+    lastSourceBytes = src;
+    lastEncodedBytes = enc;
+  }
+};
+
+/// settings and per-slot results of the automatic encoding choice
+struct AutoEncoding {
+  float precisionTolerance = 0.005;                 // use the lowest precision with estimated size exceeding the minimal one by less than this fraction
+  std::vector<rans::FrequencyTable> extFrequencies; // per slot frequencies of the external dictionary (empty if absent)
+  std::vector<uint8_t> extPrecision;                // per slot precision of the external dictionary
+  std::vector<BlockEncodingStat> stat;              // per slot statistics, each slot is modified only by the task encoding it
+};
+
+/// Choose for the source the cheapest of: encoding with external dictionary (if extFrequencies is provided), encoding with
+/// TF-local dictionary at the lowest precision compatible with precisionTolerance, or storing as is.
+/// The entropy-encoded size is estimated as sum over symbols of -log2 of their probability in the rescaled symbol table,
+/// the symbols absent in the external dictionary are accounted as literals.
+template <typename input_IT>
+EncodingChoice selectEncoding(const input_IT srcBegin, const input_IT srcEnd, const rans::FrequencyTable* extFrequencies, uint8_t extPrecision, float precisionTolerance)
+{
+  using input_t = typename std::iterator_traits<input_IT>::value_type;
+  using count_t = rans::FrequencyTable::count_t;
+  constexpr size_t StatesSize = 64; // flushed rANS states and padding
+  const size_t messageLength = std::distance(srcBegin, srcEnd);
+
+  EncodingChoice best{Metadata::OptStore::NONE, false, 0, alignSize(messageLength * sizeof(input_t))}; // storing as is
+  if (!messageLength) {
+    return best;
+  }
+  rans::FrequencyTable frequencies;
+  frequencies.addSamples(srcBegin, srcEnd);
+  const double nSamples = messageLength + 1; // + escape symbol
+
+  // bits needed to encode the message with frequencies rescaled to given precision
+  auto estimateBits = [&frequencies, nSamples](size_t precision) {
+    const double scale = double(1ull << precision) / nSamples;
+    double bits = precision; // escape symbol
+    for (auto f : frequencies) {
+      if (f) {
+        bits += f * (precision - std::log2(std::max(1., std::floor(f * scale))));
+      }
+    }
+    return bits;
+  };
+
+  // TF-local dictionary
+  const size_t dictSize = alignSize(frequencies.size() * sizeof(count_t));
+  const size_t nUsed = frequencies.getNUsedAlphabetSymbols() + 1;
+  std::vector<std::pair<size_t, double>> localEstimates;
+  double minLocalBits = std::numeric_limits<double>::max();
+  for (size_t prec = rans::internal::MIN_SCALE; prec <= rans::internal::MAX_SCALE; prec++) {
+    if ((1ull << prec) < nUsed) {
+      continue;
+    }
+    localEstimates.emplace_back(prec, estimateBits(prec));
+    minLocalBits = std::min(minLocalBits, localEstimates.back().second);
+  }
+  for (const auto& [prec, bits] : localEstimates) { // lowest precision within the tolerance
+    if (bits <= minLocalBits * (1. + precisionTolerance)) {
+      size_t sz = dictSize + alignSize(size_t(bits / 8) + StatesSize);
+      if (sz < best.estimatedSize) {
+        best = EncodingChoice{Metadata::OptStore::EENCODE, false, uint8_t(prec), sz};
+      }
+      break;
+    }
+  }
+
+  // external dictionary
+  if (extFrequencies && extFrequencies->size()) {
+    const double extTotal = double(std::accumulate(extFrequencies->begin(), extFrequencies->end(), size_t(0))) + 1;
+    const double scale = double(1ull << extPrecision) / extTotal;
+    const auto extMin = extFrequencies->getMinSymbol(), extMax = extFrequencies->getMaxSymbol();
+    double bits = extPrecision;
+    size_t nLiterals = 0;
+    const auto srcMin = frequencies.getMinSymbol();
+    for (size_t i = 0; i < frequencies.size(); i++) {
+      auto f = frequencies.at(i);
+      if (!f) {
+        continue;
+      }
+      auto symbol = srcMin + int(i);
+      count_t fext = (symbol >= extMin && symbol <= extMax) ? (*extFrequencies)[symbol] : 0;
+      if (fext) {
+        bits += f * (extPrecision - std::log2(std::max(1., std::floor(fext * scale))));
+      } else {
+        bits += f * extPrecision; // escape symbol
+        nLiterals += f;
+      }
+    }
+    size_t sz = alignSize(size_t(bits / 8) + StatesSize) + alignSize(nLiterals * sizeof(input_t));
+    if (sz < best.estimatedSize) {
+      best = EncodingChoice{Metadata::OptStore::EENCODE, true, extPrecision, sz};
+    }
+  }
+  return best;
+}
+
+///>>======================== Concurrent encoding =======================>>
+
+/// execute the tasks on up to nThreads threads, the 1st exception thrown by any task is rethrown in the calling thread
+void runConcurrently(const std::vector<std::function<void()>>& tasks, int nThreads);
+
+/// Entropy-encodes blocks of the EncodedBlocks container EB held in the buffer concurrently on up to nThreads threads.
+/// Every block is encoded to its own standalone container, then the blocks are copied to the destination container
+/// in the order they were added, so that its layout is the same as with the sequential EB::encode calls.
+/// With nThreads < 2 the blocks are encoded sequentially directly to the destination container.
+/// If autoEnc is provided, the blocks requested to be entropy-encoded are stored in the way chosen by selectEncoding.
+/// The sources passed to add must stay valid until encode is called.
+template <typename EB, typename buffer_T>
+class ConcurrentBlocksEncoder
+{
+ public:
+  ConcurrentBlocksEncoder(buffer_T& buffer, int nThreads, AutoEncoding* autoEnc = nullptr) : mBuffer(buffer), mNThreads(nThreads), mAutoEncoding(autoEnc) {}
+
+  /// add vector src to be encoded to provided slot
+  template <typename VE>
+  void add(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, const void* encoderExt = nullptr, uint8_t nStreams = o2::rans::internal::DefaultNStreams)
+  {
+    add(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, encoderExt, nStreams);
+  }
+
+  /// add source range to be encoded to provided slot
+  template <typename input_IT>
+  void add(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, const void* encoderExt = nullptr, uint8_t nStreams = o2::rans::internal::DefaultNStreams)
+  {
+    mSlots.push_back(slot);
+    auto autoEnc = mAutoEncoding;
+    mDirect.emplace_back([=](buffer_T& buffer) {
+      encodeBlock(buffer, false, srcBegin, srcEnd, slot, symbolTablePrecision, opt, encoderExt, nStreams, autoEnc);
+    });
+    mStandalone.emplace_back([=](std::vector<BufferType>& buffer) {
+      encodeBlock(buffer, true, srcBegin, srcEnd, slot, symbolTablePrecision, opt, encoderExt, nStreams, autoEnc);
+    });
+  }
+
+  /// encode all added blocks
+  void encode();
+
+  int getNThreads() const { return mNThreads; }
+
+ private:
+  template <typename input_IT, typename B>
+  static void encodeBlock(B& buffer, bool standalone, const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision,
+                          Metadata::OptStore opt, const void* encoderExt, uint8_t nStreams, AutoEncoding* autoEnc);
+
+  buffer_T& mBuffer;
+  int mNThreads = 1;
+  AutoEncoding* mAutoEncoding = nullptr;
+  std::vector<int> mSlots;
+  std::vector<std::function<void(buffer_T&)>> mDirect;
+  std::vector<std::function<void(std::vector<BufferType>&)>> mStandalone;
+};
+
+///_____________________________________________________________________________
+template <typename EB, typename buffer_T>
+template <typename input_IT, typename B>
+void ConcurrentBlocksEncoder<EB, buffer_T>::encodeBlock(B& buffer, bool standalone, const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision,
+                                                        Metadata::OptStore opt, const void* encoderExt, uint8_t nStreams, AutoEncoding* autoEnc)
+{
+  const bool doAuto = autoEnc && opt == Metadata::OptStore::EENCODE;
+  EncodingChoice choice;
+  if (doAuto) {
+    const rans::FrequencyTable* extFreq = (encoderExt && slot < int(autoEnc->extFrequencies.size())) ? &autoEnc->extFrequencies[slot] : nullptr;
+    choice = selectEncoding(srcBegin, srcEnd, extFreq, extFreq ? autoEnc->extPrecision[slot] : 0, autoEnc->precisionTolerance);
+    opt = choice.opt;
+    symbolTablePrecision = choice.precision;
+    encoderExt = choice.useExtDictionary ? encoderExt : nullptr;
+  }
+  if (standalone) {
+    EB::encodeStandalone(buffer, srcBegin, srcEnd, slot, symbolTablePrecision, opt, encoderExt, nStreams);
+  } else {
+    EB::get(buffer.data())->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &buffer, encoderExt, nStreams);
+  }
+  if (doAuto && slot < int(autoEnc->stat.size())) {
+    const auto& block = EB::get(buffer.data())->getBlock(slot);
+    autoEnc->stat[slot].add(choice, std::distance(srcBegin, srcEnd) * sizeof(typename std::iterator_traits<input_IT>::value_type), block.getNStored() * sizeof(*block.getData()));
+  }
+}
+
+///_____________________________________________________________________________
+template <typename EB, typename buffer_T>
+void ConcurrentBlocksEncoder<EB, buffer_T>::encode()
+{
+  const int nBlocks = mSlots.size();
+  if (mNThreads < 2 || nBlocks < 2) {
+    for (auto& task : mDirect) {
+      task(mBuffer);
+    }
+  } else {
+    std::vector<std::vector<BufferType>> buffers(nBlocks);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(nBlocks);
+    for (int i = 0; i < nBlocks; i++) {
+      tasks.emplace_back([this, &buffers, i]() { mStandalone[i](buffers[i]); });
+    }
+    runConcurrently(tasks, mNThreads);
+    for (int i = 0; i < nBlocks; i++) { // store in the order of adding, independent of the execution order
+      EB::storeStandalone(mBuffer, *EB::get(buffers[i].data()), mSlots[i]);
+    }
+  }
+  mSlots.clear();
+  mDirect.clear();
+  mStandalone.clear();
+}
+
 } // namespace ctf
 } // namespace o2
 
@@ -0,0 +1,194 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFNativeFile.cxx
+/// \brief Native (ROOT-free) CTF file writer and memory-mapping reader
+
+#include "DetectorsCommonDataFormats/CTFNativeFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+size_t alignNative(size_t sz)
+{
+  auto res = sz % CTFNativeFileHeader::NativeAlignment;
+  return res ? sz + (CTFNativeFileHeader::NativeAlignment - res) : sz;
+}
+} // namespace
+
+static_assert(CTFNativeFileHeader::NativeAlignment % o2::ctf::Alignment == 0, "native alignment must be compatible with EncodedBlocks alignment");
+
+///___________________________________________________________________
+void CTFNativeFileWriter::open(const std::string& fname)
+{
+  close();
+  mFile.open(fname, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!mFile.good()) {
+    throw std::runtime_error(fmt::format("Failed to open native CTF file {} for writing", fname));
+  }
+  mFileName = fname;
+  mIndex.clear();
+  mInTF = false;
+  CTFNativeFileHeader header; // placeholder, will be rewritten at closing
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mOffset = sizeof(header);
+}
+
+///___________________________________________________________________
+CTFNativeFileWriter::~CTFNativeFileWriter()
+{
+  try {
+    close();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to close native CTF file " << mFileName << ": " << e.what();
+  }
+}
+
+///___________________________________________________________________
+void CTFNativeFileWriter::beginTF(const CTFHeader& h)
+{
+  if (mInTF) {
+    throw std::runtime_error("previous TF was not finalized");
+  }
+  mCurrent = CTFNativeIndexEntry{};
+  mCurrent.run = h.run;
+  mCurrent.firstTForbit = h.firstTForbit;
+  mInTF = true;
+}
+
+///___________________________________________________________________
+size_t CTFNativeFileWriter::addDetector(DetID det, const void* image, size_t size)
+{
+  if (!mInTF) {
+    throw std::runtime_error("beginTF must be called before adding detector data");
+  }
+  static const std::array<char, CTFNativeFileHeader::NativeAlignment> padding{};
+  auto start = alignNative(mOffset);
+  mFile.write(padding.data(), start - mOffset);
+  mFile.write(reinterpret_cast<const char*>(image), size);
+  if (!mFile.good()) {
+    throw std::runtime_error(fmt::format("Failed to write {} data to native CTF file {}", det.getName(), mFileName));
+  }
+  mOffset = start + size;
+  mCurrent.offset[det] = start;
+  mCurrent.size[det] = size;
+  mCurrent.detectors |= 0x1u << det;
+  return size;
+}
+
+///___________________________________________________________________
+void CTFNativeFileWriter::endTF()
+{
+  if (mInTF) {
+    mIndex.push_back(mCurrent);
+    mInTF = false;
+  }
+}
+
+///___________________________________________________________________
+void CTFNativeFileWriter::close()
+{
+  if (!mFile.is_open()) {
+    return;
+  }
+  endTF();
+  static const std::array<char, CTFNativeFileHeader::NativeAlignment> padding{};
+  CTFNativeFileHeader header;
+  header.nEntries = mIndex.size();
+  header.indexOffset = alignNative(mOffset);
+  mFile.write(padding.data(), header.indexOffset - mOffset);
+  mFile.write(reinterpret_cast<const char*>(mIndex.data()), mIndex.size() * sizeof(CTFNativeIndexEntry));
+  mFile.seekp(0);
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  bool ok = mFile.good();
+  mFile.close();
+  mIndex.clear();
+  mOffset = 0;
+  if (!ok) {
+    throw std::runtime_error(fmt::format("Failed to write the index of native CTF file {}", mFileName));
+  }
+}
+
+///___________________________________________________________________
+bool CTFNativeFileReader::isNativeFile(const std::string& fname)
+{
+  std::ifstream inp(fname, std::ios::binary);
+  std::array<char, 8> magic{};
+  return inp.read(magic.data(), magic.size()) && magic == CTFNativeFileHeader::Magic;
+}
+
+///___________________________________________________________________
+void CTFNativeFileReader::open(const std::string& fname)
+{
+  close();
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("Failed to open native CTF file {}: {}", fname, strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(CTFNativeFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("Native CTF file {} is too short", fname));
+  }
+  mSize = st.st_size;
+  void* ptr = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid after closing the descriptor
+  if (ptr == MAP_FAILED) {
+    mSize = 0;
+    throw std::runtime_error(fmt::format("Failed to map native CTF file {}: {}", fname, strerror(errno)));
+  }
+  mBase = reinterpret_cast<const char*>(ptr);
+  mFileName = fname;
+
+  const auto& header = *reinterpret_cast<const CTFNativeFileHeader*>(mBase);
+  if (!header.isValid() || !header.indexOffset || header.indexOffset + header.nEntries * sizeof(CTFNativeIndexEntry) > mSize) {
+    close();
+    throw std::runtime_error(fmt::format("Invalid or incomplete native CTF file {}", fname));
+  }
+  const auto* entries = reinterpret_cast<const CTFNativeIndexEntry*>(mBase + header.indexOffset);
+  mIndex.assign(entries, entries + header.nEntries);
+  madvise(const_cast<char*>(mBase), mSize, MADV_SEQUENTIAL);
+}
+
+///___________________________________________________________________
+void CTFNativeFileReader::close()
+{
+  if (mBase) {
+    munmap(const_cast<char*>(mBase), mSize);
+  }
+  mBase = nullptr;
+  mSize = 0;
+  mIndex.clear();
+}
+
+///___________________________________________________________________
+gsl::span<const BufferType> CTFNativeFileReader::getImageBuffer(size_t entry, DetID det) const
+{
+  if (entry >= mIndex.size()) {
+    throw std::runtime_error(fmt::format("Entry {} exceeds the number of entries {} in {}", entry, mIndex.size(), mFileName));
+  }
+  if (!hasDetector(entry, det)) {
+    return {};
+  }
+  const auto& ie = mIndex[entry];
+  if (ie.offset[det] + ie.size[det] > mSize) {
+    throw std::runtime_error(fmt::format("Corrupted index for {} in entry {} of {}", det.getName(), entry, mFileName));
+  }
+  return gsl::span<const BufferType>(reinterpret_cast<const BufferType*>(mBase + ie.offset[det]), ie.size[det]);
+}
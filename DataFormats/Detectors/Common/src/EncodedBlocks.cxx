@@ -10,5 +10,33 @@
 // or submit itself to any jurisdiction.
 
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include <exception>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::ctf;
+
+///_____________________________________________________________________________
+void o2::ctf::runConcurrently(const std::vector<std::function<void()>>& tasks, int nThreads)
+{
+  const int nTasks = tasks.size();
+  std::vector<std::exception_ptr> errors(nTasks);
+#ifdef WITH_OPENMP
+  nThreads = std::max(1, std::min(nThreads, nTasks));
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int i = 0; i < nTasks; i++) {
+    try {
+      tasks[i]();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CTFNativeFile
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DetectorsCommonDataFormats/CTFNativeFile.h"
+#include <random>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+struct TestHeader : public CTFDictHeader {
+  uint32_t nEntries = 0;
+};
+using TestCTF = EncodedBlocks<TestHeader, 2, uint32_t>;
+
+BOOST_AUTO_TEST_CASE(CTFNativeFile_test)
+{
+  const std::string fname = "test_ctf_native.ctf";
+  const std::vector<DetID> dets{DetID::ITS, DetID::TOF, DetID::ZDC};
+  std::mt19937 mt(42);
+  std::geometric_distribution<int> dist(0.05);
+  using SlotsData = std::vector<std::vector<int16_t>>;
+  std::vector<std::vector<SlotsData>> sources; // [TF][detector][slot]
+  const int nTF = 5;
+  {
+    CTFNativeFileWriter writer(fname);
+    for (int itf = 0; itf < nTF; itf++) {
+      writer.beginTF(CTFHeader{1234, uint32_t(itf * 256)});
+      auto& srcTF = sources.emplace_back();
+      for (int id = 0; id < dets.size(); id++) {
+        if (itf % 2 && dets[id] == DetID::TOF) { // skip TOF in odd TFs
+          srcTF.emplace_back();
+          continue;
+        }
+        auto& src = srcTF.emplace_back(TestCTF::getNBlocks());
+        std::vector<BufferType> buff;
+        TestCTF::create(buff);
+        for (int slot = 0; slot < TestCTF::getNBlocks(); slot++) {
+          src[slot].resize(100 + 1000 * itf + slot);
+          std::generate(src[slot].begin(), src[slot].end(), [&]() { return dist(mt); });
+          TestCTF::get(buff.data())->encode(src[slot], slot, 0, Metadata::OptStore::EENCODE, &buff);
+        }
+        TestCTF::get(buff.data())->getHeader().nEntries = itf;
+        writer.addDetector(dets[id], buff.data(), buff.size());
+      }
+      writer.endTF();
+    }
+  }
+
+  BOOST_CHECK(CTFNativeFileReader::isNativeFile(fname));
+  CTFNativeFileReader reader(fname);
+  BOOST_CHECK(reader.getNEntries() == nTF);
+  for (int itf = nTF; itf--;) { // random access
+    auto h = reader.getCTFHeader(itf);
+    BOOST_CHECK(h.run == 1234 && h.firstTForbit == itf * 256);
+    for (int id = 0; id < dets.size(); id++) {
+      if (sources[itf][id].empty()) {
+        BOOST_CHECK(!reader.hasDetector(itf, dets[id]) && reader.getImageBuffer(itf, dets[id]).empty());
+        continue;
+      }
+      BOOST_CHECK(reinterpret_cast<uintptr_t>(reader.getImageBuffer(itf, dets[id]).data()) % Alignment == 0);
+      const auto image = reader.getImage<TestCTF>(itf, dets[id]);
+      BOOST_CHECK(image.getHeader().nEntries == itf);
+      for (int slot = 0; slot < TestCTF::getNBlocks(); slot++) {
+        std::vector<int16_t> decoded;
+        image.decode(decoded, slot);
+        BOOST_CHECK(decoded == sources[itf][id][slot]);
+      }
+    }
+  }
+}
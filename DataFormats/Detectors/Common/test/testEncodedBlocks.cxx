@@ -0,0 +1,48 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EncodedBlocks
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include <random>
+
+using namespace o2::ctf;
+
+struct TestHeader {
+  uint32_t nEntries = 0;
+};
+using TestCTF = EncodedBlocks<TestHeader, 3, uint32_t>;
+
+// encode/decode round trip with different numbers of interleaved rANS streams per block
+BOOST_DATA_TEST_CASE(EncodedBlocksNStreams_test, boost::unit_test::data::make({2, 4, 8, 16}), nStreams)
+{
+  std::mt19937 mt(nStreams);
+  std::geometric_distribution<int> dist(0.05);
+  std::vector<std::vector<int16_t>> src(TestCTF::getNBlocks());
+  std::vector<o2::ctf::BufferType> buff;
+  TestCTF::create(buff);
+  for (int slot = 0; slot < TestCTF::getNBlocks(); slot++) {
+    src[slot].resize(1 + 5000 * slot + nStreams); // include a size which is not a multiple of the number of streams
+    std::generate(src[slot].begin(), src[slot].end(), [&]() { return dist(mt) - 10; });
+    TestCTF::get(buff.data())->encode(src[slot], slot, 0, Metadata::OptStore::EENCODE, &buff, nullptr, nStreams);
+  }
+
+  const auto& ctf = *TestCTF::get(buff.data());
+  for (int slot = 0; slot < TestCTF::getNBlocks(); slot++) {
+    BOOST_CHECK_EQUAL(int(ctf.getMetadata(slot).nStreams), nStreams);
+    std::vector<int16_t> decoded;
+    ctf.decode(decoded, slot);
+    BOOST_CHECK(decoded == src[slot]);
+  }
+}
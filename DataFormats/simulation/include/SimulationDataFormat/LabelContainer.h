@@ -202,6 +202,12 @@ class LabelContainer
     mLabelArray.clear();
   }
 
+  /// memory allocated by the container in bytes
+  size_t getAllocatedMemory() const
+  {
+    return mHeaderArray.capacity() * sizeof(HeaderElement) + mLabelArray.capacity() * sizeof(StoredLabelType);
+  }
+
   /// add a label for a dataindex
   void addLabel(unsigned int dataindex, LabelType const& label)
   {
@@ -22,8 +22,14 @@
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "rANS/rans.h"
 
+namespace o2::framework
+{
+class ProcessingContext;
+}
+
 namespace o2
 {
 namespace ctf
@@ -42,7 +48,12 @@ class CTFCoderBase
                             Decoder };
 
   CTFCoderBase() = delete;
-  CTFCoderBase(int n, DetID det) : mCoders(n), mDet(det) {}
+  CTFCoderBase(int n, DetID det) : mCoders(n), mDet(det)
+  {
+    mAutoEncoding.extFrequencies.resize(n);
+    mAutoEncoding.extPrecision.resize(n);
+    mAutoEncoding.stat.resize(n);
+  }
 
   std::unique_ptr<TFile> loadDictionaryTreeFile(const std::string& dictPath, bool mayFail = false);
 
@@ -72,6 +83,8 @@ class CTFCoderBase
     switch (op) {
       case OpType::Encoder:
         mCoders[slot].reset(new o2::rans::LiteralEncoder64<S>(freq, probabilityBits));
+        mAutoEncoding.extFrequencies[slot] = freq; // needed for the estimate of the encoding with external dictionary
+        mAutoEncoding.extPrecision[slot] = static_cast<const o2::rans::LiteralEncoder64<S>*>(mCoders[slot].get())->getSymbolTablePrecision();
         break;
       case OpType::Decoder:
         mCoders[slot].reset(new o2::rans::LiteralDecoder64<S>(freq, probabilityBits));
@@ -79,6 +92,21 @@ class CTFCoderBase
     }
   }
 
+  /// number of threads used to entropy-encode the CTF blocks concurrently
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// automatic per block choice between the external dictionary, TF-local dictionary with optimal precision or raw storage
+  void setAutoEncoding(bool v) { mAutoEncodingOn = v; }
+  bool isAutoEncoding() const { return mAutoEncodingOn; }
+  void setAutoEncodingPrecisionTolerance(float t) { mAutoEncoding.precisionTolerance = t; }
+  const std::vector<BlockEncodingStat>& getEncodingStat() const { return mAutoEncoding.stat; }
+
+  /// send to the DPL monitoring the choice and compression of every block in the last encoded TF (for automatic encoding)
+  void sendEncodingMetrics(o2::framework::ProcessingContext& pc) const;
+  /// print accumulated statistics of automatic encoding
+  void printEncodingStat() const;
+
   void clear()
   {
     for (auto c : mCoders) {
@@ -88,6 +116,7 @@ class CTFCoderBase
 
  protected:
   std::string getPrefix() const { return o2::utils::Str::concat_string(mDet.getName(), "_CTF: "); }
+  AutoEncoding* getAutoEncoding() { return mAutoEncodingOn ? &mAutoEncoding : nullptr; }
   void assignDictVersion(CTFDictHeader& h) const
   {
     if (mExtHeader.isValidDictTimeStamp()) {
@@ -99,8 +128,11 @@ class CTFCoderBase
   std::vector<std::shared_ptr<void>> mCoders; // encoders/decoders
   DetID mDet;
   CTFDictHeader mExtHeader; // external dictionary header
+  int mNThreads = 1;        // number of threads for the blocks encoding
+  bool mAutoEncodingOn = false;
+  AutoEncoding mAutoEncoding; //! settings and statistics of automatic encoding
 
-  ClassDefNV(CTFCoderBase, 1);
+  ClassDefNV(CTFCoderBase, 3);
 };
 
 } // namespace ctf
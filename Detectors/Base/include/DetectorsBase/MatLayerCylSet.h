@@ -51,6 +51,8 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 {
 
  public:
+  static constexpr int BATCH_SIZE = 64; ///< number of segments processed together by the batched material budget query
+
   MatLayerCylSet() CON_DEFAULT;
   ~MatLayerCylSet() CON_DEFAULT;
   MatLayerCylSet(const MatLayerCylSet& src) CON_DELETE;
@@ -91,6 +93,15 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
 
+#ifndef GPUCA_GPUCODE
+  // batched query of the material budget for n segments with start and end points given in SoA form.
+  // The segments are processed in chunks of BATCH_SIZE: their length and radial range are evaluated in vectorized loops
+  // and only the segments reaching the radial span of the LUT are traversed layer by layer. The results are the same as
+  // of the single segment getMatBudget
+  void getMatBudget(const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1,
+                    MatBudget* budgets, int n) const;
+#endif // !GPUCA_GPUCODE
+
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
 #ifndef GPUCA_GPUCODE
@@ -26,6 +26,7 @@
 
 #ifndef GPUCA_GPUCODE
 #include <string>
+#include <gsl/span>
 #endif
 
 namespace o2
@@ -69,6 +70,7 @@ class PropagatorImpl
 
   static constexpr float MAX_SIN_PHI = 0.85f;
   static constexpr float MAX_STEP = 2.0f;
+  static constexpr int BATCH_SIZE = 32; // number of tracks processed together by the batch propagation
 
   GPUd() bool PropagateToXBxByBz(TrackParCov_t& track, value_type x,
                                  value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
@@ -86,6 +88,17 @@ class PropagatorImpl
                            value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                            track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
 
+#ifndef GPUCA_GPUCODE
+  // Propagate a batch of tracks to the common X in the constant field bZ. The tracks are processed in chunks of BATCH_SIZE
+  // copied to the SoA layout, so that the helix step and covariance update are vectorized. The results are the same as of the
+  // single track propagateToX (w/o TOF integral). With the material LUT the material budget of the steps of the chunk is
+  // queried in a single batched call. If provided, the status span is filled by 1 for successfully propagated tracks
+  // and 0 otherwise. Returns number of successfully propagated tracks
+  int propagateToX(gsl::span<TrackParCov_t> tracks, value_type x, value_type bZ, gsl::span<uint8_t> status = {},
+                   value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                   int signCorr = 0) const;
+#endif
+
   template <typename track_T>
   GPUd() bool propagateTo(track_T& track, value_type x, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP,
                           MatCorrType matCorr = MatCorrType::USEMatCorrLUT, track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const
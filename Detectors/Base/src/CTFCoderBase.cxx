@@ -15,6 +15,8 @@
 
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsBase/CTFCoderBase.h"
+#include "Framework/ProcessingContext.h"
+#include "Framework/Monitoring.h"
 #include <filesystem>
 
 using namespace o2::ctf;
@@ -73,3 +75,41 @@ void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
     }
   }
 }
+
+void CTFCoderBase::sendEncodingMetrics(o2::framework::ProcessingContext& pc) const
+{
+  if (!mAutoEncodingOn) {
+    return;
+  }
+  using o2::monitoring::Metric;
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  for (size_t slot = 0; slot < mAutoEncoding.stat.size(); slot++) {
+    const auto& st = mAutoEncoding.stat[slot];
+    if (!st.lastSourceBytes) {
+      continue;
+    }
+    const auto& ch = st.choice;
+    int choice = ch.opt != Metadata::OptStore::EENCODE ? 0 : (ch.useExtDictionary ? 2 : 1); // 0: raw, 1: local dictionary, 2: external dictionary
+    auto prefix = fmt::format("ctf-{}-slot{}", mDet.getName(), slot);
+    monitoring.send(Metric{choice, prefix + "-choice"});
+    monitoring.send(Metric{int(ch.precision), prefix + "-precision"});
+    monitoring.send(Metric{uint64_t(st.lastEncodedBytes), prefix + "-encoded-bytes"});
+    monitoring.send(Metric{double(st.lastSourceBytes) / std::max(size_t(1), st.lastEncodedBytes), prefix + "-compression"});
+  }
+}
+
+void CTFCoderBase::printEncodingStat() const
+{
+  if (!mAutoEncodingOn) {
+    return;
+  }
+  size_t src = 0, enc = 0;
+  for (size_t slot = 0; slot < mAutoEncoding.stat.size(); slot++) {
+    const auto& st = mAutoEncoding.stat[slot];
+    LOGP(INFO, "{}slot {}: raw/local/external dictionary blocks: {}/{}/{}, compression {:.3f} ({} -> {} bytes)", getPrefix(), slot,
+         st.nRaw, st.nLocal, st.nExternal, double(st.sourceBytes) / std::max(size_t(1), st.encodedBytes), st.sourceBytes, st.encodedBytes);
+    src += st.sourceBytes;
+    enc += st.encodedBytes;
+  }
+  LOGP(INFO, "{}total compression {:.3f} ({} -> {} bytes)", getPrefix(), double(src) / std::max(size_t(1), enc), src, enc);
+}
@@ -364,6 +364,41 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
   return rval;
 }
 
+#ifndef GPUCA_GPUCODE
+//_________________________________________________________________________________________________
+void MatLayerCylSet::getMatBudget(const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1,
+                                  MatBudget* budgets, int n) const
+{
+  // batched version of the getMatBudget: segments which are too short or do not reach the LUT radial span
+  // are identified for the whole chunk before traversing the layers
+  alignas(64) float dist[BATCH_SIZE], rmin2[BATCH_SIZE], rmax2[BATCH_SIZE];
+  const float lutRMin2 = getRMin2(), lutRMax2 = getRMax2();
+  for (int i0 = 0; i0 < n; i0 += BATCH_SIZE) {
+    int nb = n - i0 < BATCH_SIZE ? n - i0 : BATCH_SIZE;
+    const float *bx0 = x0 + i0, *by0 = y0 + i0, *bz0 = z0 + i0, *bx1 = x1 + i0, *by1 = y1 + i0, *bz1 = z1 + i0;
+    for (int i = 0; i < nb; i++) { // same arithmetics as in the Ray constructor and Ray::getMinMaxR2
+      float dx = bx1[i] - bx0[i], dy = by1[i] - by0[i], dz = bz1[i] - bz0[i];
+      float distXY2 = dx * dx + dy * dy, distXY2i = distXY2 > Ray::Tiny ? 1.f / distXY2 : 0.f;
+      float xDxPlusYDyRed = -(bx0[i] * dx + by0[i] * dy) * distXY2i;
+      float r02 = bx0[i] * bx0[i] + by0[i] * by0[i], r12 = bx1[i] * bx1[i] + by1[i] * by1[i];
+      float xMin = bx0[i] + xDxPlusYDyRed * dx, yMin = by0[i] + xDxPlusYDyRed * dy;
+      dist[i] = o2::gpu::CAMath::Sqrt(distXY2 + dz * dz);
+      rmin2[i] = (xDxPlusYDyRed > 0.f && xDxPlusYDyRed < 1.f) ? xMin * xMin + yMin * yMin : (r02 > r12 ? r12 : r02);
+      rmax2[i] = r02 > r12 ? r02 : r12;
+    }
+    for (int i = 0; i < nb; i++) {
+      auto& rval = budgets[i0 + i];
+      if (dist[i] < Ray::MinDistToConsider || rmin2[i] >= lutRMax2 || rmax2[i] <= lutRMin2) {
+        rval = MatBudget();
+        rval.length = dist[i];
+      } else {
+        rval = getMatBudget(bx0[i], by0[i], bz0[i], bx1[i], by1[i], bz1[i]);
+      }
+    }
+  }
+}
+#endif // !GPUCA_GPUCODE
+
 //_________________________________________________________________________________________________
 GPUd() bool MatLayerCylSet::getLayersRange(const Ray& ray, short& lmin, short& lmax) const
 {
@@ -15,6 +15,11 @@
 #include "GPUTPCGMPolynomialField.h"
 #include "MathUtils/Utils.h"
 #include "ReconstructionDataFormats/Vertex.h"
+#ifndef GPUCA_GPUCODE
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#endif
 
 using namespace o2::base;
 using namespace o2::gpu;
@@ -572,6 +577,278 @@ GPUd() void PropagatorImpl<value_T>::estimateLTFast(o2::track::TrackLTIntegral&
   lt.addStep(length, trc.getP2Inv());
 }
 
+#ifndef GPUCA_GPUCODE
+namespace
+{
+// SoA representation of a chunk of tracks for the batch propagation
+template <typename value_T, int N>
+struct TrackBatchSoA {
+  alignas(64) value_T x[N];
+  alignas(64) value_T par[o2::track::kNParams][N];
+  alignas(64) value_T cov[o2::track::kCovMatSize][N];
+  alignas(64) value_T bq[N];    // field for charged tracks, 0 for neutrals
+  alignas(64) value_T dx[N];    // step to perform, 0 for inactive lanes
+  alignas(64) value_T snp0[N];  // sin(phi) before the step
+  alignas(64) int ok[N];        // track is still alive
+  alignas(64) int upd[N];       // track was updated in the last step
+  alignas(64) int largeRot[N];  // step needs exact Z evaluation for the large rotation angle
+  alignas(64) value_T xyz0[3][N]; // global position before the step (for the material query only)
+  alignas(64) float seg[6][N];     // start and end points of the step for the batched material LUT query
+  MatBudget mb[N];                 // material budget of the step
+
+  template <typename T>
+  void load(int i, const T& trc, value_T bZ)
+  {
+    x[i] = trc.getX();
+    for (int k = 0; k < o2::track::kNParams; k++) {
+      par[k][i] = trc.getParam(k);
+    }
+    const auto& c = trc.getCov();
+    for (int k = 0; k < o2::track::kCovMatSize; k++) {
+      cov[k][i] = c[k];
+    }
+    bq[i] = trc.getAbsCharge() ? bZ : 0.f;
+  }
+
+  template <typename T>
+  void store(int i, T& trc) const
+  {
+    trc.setX(x[i]);
+    for (int k = 0; k < o2::track::kNParams; k++) {
+      trc.setParam(par[k][i], k);
+    }
+    for (int k = 0; k < o2::track::kCovMatSize; k++) {
+      trc.setCov(cov[k][i], k);
+    }
+  }
+
+  // equivalent of TrackParametrizationWithError::propagateTo(x + dx, b) for all lanes with dx != 0
+  void propagate(value_T b)
+  {
+    using namespace o2::track;
+    constexpr value_T Almost0 = o2::constants::math::Almost0, Almost1 = o2::constants::math::Almost1;
+    for (int i = 0; i < N; i++) {
+      value_T dxi = dx[i];
+      value_T crv = par[kQ2Pt][i] * bq[i] * o2::constants::math::B2C; // as TrackParametrization::getCurvature
+      value_T x2r = crv * dxi;
+      value_T f1 = par[kSnp][i], f2 = f1 + x2r;
+      value_T r1 = std::sqrt(std::abs((1.f - f1) * (1.f + f1))); // abs: the |f|>1 lanes are rejected anyway
+      value_T r2 = std::sqrt(std::abs((1.f - f2) * (1.f + f2)));
+      // no short-circuit logic and branches to keep the loop vectorizable
+      int good = (std::abs(f1) <= Almost1) & (std::abs(f2) <= Almost1) & (r1 >= Almost0) & (r2 >= Almost0);
+      int act = (dxi != 0.f) & ok[i];
+      ok[i] = ok[i] & (good | (1 - act));
+      int u = upd[i] = act & good;
+      snp0[i] = f1;
+      // make the arithmetics below harmless for the lanes which are not updated (masking by multiplication is
+      // used since the compiler turns a chain of selects into a branch)
+      value_T um = u, un = 1 - u;
+      dxi *= um;
+      f1 *= um;
+      f2 *= um;
+      x2r *= um;
+      r1 = r1 * um + un;
+      r2 = r2 * um + un;
+      double dy2dx = (f1 + f2) / (r1 + r2);
+      int lrot = largeRot[i] = std::abs(x2r) >= 0.05f;
+      x[i] += dxi;
+      par[kY][i] += value_T(dxi * dy2dx);
+      par[kZ][i] += value_T(dxi * (r2 + f2 * dy2dx) * par[kTgl][i]) * (1 - lrot);
+      par[kSnp][i] += x2r;
+
+      // evaluate matrix in double prec.
+      double rinv = 1. / r1;
+      double r3inv = rinv * rinv * rinv;
+      double f24 = dxi * b * o2::constants::math::B2C;
+      double f02 = dxi * r3inv;
+      double f04 = 0.5 * f24 * f02;
+      double f12 = f02 * par[kTgl][i] * f1;
+      double f14 = 0.5 * f24 * f12;
+      double f13 = dxi * rinv;
+      value_T c20 = cov[kSigSnpY][i], c21 = cov[kSigSnpZ][i], c22 = cov[kSigSnp2][i], c30 = cov[kSigTglY][i], c31 = cov[kSigTglZ][i];
+      value_T c32 = cov[kSigTglSnp][i], c33 = cov[kSigTgl2][i], c40 = cov[kSigQ2PtY][i], c41 = cov[kSigQ2PtZ][i], c42 = cov[kSigQ2PtSnp][i];
+      value_T c43 = cov[kSigQ2PtTgl][i], c44 = cov[kSigQ2Pt2][i];
+
+      // b = C*ft
+      double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+      double b02 = f24 * c40;
+      double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+      double b12 = f24 * c41;
+      double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+      double b22 = f24 * c42;
+      double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+      double b42 = f24 * c44;
+      double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+      double b32 = f24 * c43;
+
+      // a = f*b = f*C*ft
+      double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+      double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+      double a22 = f24 * b42;
+
+      // F*C*Ft = C + (b + bt + a)
+      cov[kSigY2][i] += b00 + b00 + a00;
+      cov[kSigZY][i] += b10 + b01 + a01;
+      cov[kSigSnpY][i] += b20 + b02 + a02;
+      cov[kSigTglY][i] += b30;
+      cov[kSigQ2PtY][i] += b40;
+      cov[kSigZ2][i] += b11 + b11 + a11;
+      cov[kSigSnpZ][i] += b21 + b12 + a12;
+      cov[kSigTglZ][i] += b31;
+      cov[kSigQ2PtZ][i] += b41;
+      cov[kSigSnp2][i] += b22 + b22 + a22;
+      cov[kSigTglSnp][i] += b32;
+      cov[kSigQ2PtSnp][i] += b42;
+    }
+    for (int i = 0; i < N; i++) { // rare steps with large rotation angle need asin, processed separately not to prevent vectorization
+      if (largeRot[i]) {
+        value_T crv = par[kQ2Pt][i] * bq[i] * o2::constants::math::B2C;
+        value_T f1 = snp0[i], f2 = par[kSnp][i];
+        value_T r1 = std::sqrt((1.f - f1) * (1.f + f1)), r2 = std::sqrt((1.f - f2) * (1.f + f2));
+        value_T rot = std::asin(r1 * f2 - r2 * f1);
+        if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) { // special cases of large rotations or large abs angles
+          rot = f2 > 0.f ? o2::constants::math::PI - rot : -o2::constants::math::PI - rot;
+        }
+        par[kZ][i] += par[kTgl][i] / crv * rot;
+      }
+    }
+    checkCovariance();
+  }
+
+  // equivalent of TrackParametrizationWithError::checkCovariance for the updated lanes
+  void checkCovariance()
+  {
+    using namespace o2::track;
+    limitCovariance(kSigY2, kCY2max, kSigZY, kSigSnpY, kSigTglY, kSigQ2PtY);
+    limitCovariance(kSigZ2, kCZ2max, kSigZY, kSigSnpZ, kSigTglZ, kSigQ2PtZ);
+    limitCovariance(kSigSnp2, kCSnp2max, kSigSnpY, kSigSnpZ, kSigTglSnp, kSigQ2PtSnp);
+    limitCovariance(kSigTgl2, kCTgl2max, kSigTglY, kSigTglZ, kSigTglSnp, kSigQ2PtTgl);
+    limitCovariance(kSigQ2Pt2, kC1Pt2max, kSigQ2PtY, kSigQ2PtZ, kSigQ2PtSnp, kSigQ2PtTgl);
+  }
+
+  void limitCovariance(int diag, value_T maxV, int o0, int o1, int o2, int o3)
+  {
+    for (int i = 0; i < N; i++) {
+      value_T v0 = cov[diag][i], v = std::abs(v0);
+      value_T scl = upd[i] ? std::sqrt(maxV / std::max(v, maxV)) : 1.f; // 1 unless v > maxV
+      cov[diag][i] = upd[i] ? std::min(v, maxV) : v0;
+      cov[o0][i] *= scl;
+      cov[o1][i] *= scl;
+      cov[o2][i] *= scl;
+      cov[o3][i] *= scl;
+    }
+  }
+};
+} // namespace
+
+//_______________________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::propagateToX(gsl::span<TrackParCov_t> tracks, value_type xToGo, value_type bZ, gsl::span<uint8_t> status,
+                                          value_type maxSnp, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  // batch version of the propagateToX(TrackParCov_t& ...): the steps are done for all tracks of the chunk simultaneously,
+  // the material corrections, if requested, are applied per track
+  const value_type Epsilon = 0.00001;
+  // the chunk is processed until its longest propagation is done, group the tracks with similar number of steps
+  std::vector<int> order(tracks.size()), nSteps(tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    order[i] = i;
+    nSteps[i] = int(std::abs(xToGo - tracks[i].getX()) / maxStep);
+  }
+  std::sort(order.begin(), order.end(), [&nSteps](int a, int b) { return nSteps[a] < nSteps[b]; });
+  TrackBatchSoA<value_type, BATCH_SIZE> soa;
+  int nOK = 0;
+  for (size_t i0 = 0; i0 < tracks.size(); i0 += BATCH_SIZE) {
+    int n = std::min<size_t>(BATCH_SIZE, tracks.size() - i0);
+    const int* ids = &order[i0];
+    for (int i = 0; i < BATCH_SIZE; i++) {
+      soa.load(i, tracks[ids[std::min(i, n - 1)]], bZ); // pad the chunk by the last track, it will not be propagated
+      soa.ok[i] = i < n;
+    }
+    while (true) {
+      int nActive = 0;
+      for (int i = 0; i < BATCH_SIZE; i++) {
+        auto dx = xToGo - soa.x[i];
+        bool act = soa.ok[i] && std::abs(dx) > Epsilon;
+        auto xk = soa.x[i] + std::min(std::max(dx, -maxStep), maxStep);
+        soa.dx[i] = act ? xk - soa.x[i] : 0.f; // as in the single track propagation, which gets xk
+        nActive += act;
+      }
+      if (!nActive) {
+        break;
+      }
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        for (int i = 0; i < n; i++) {
+          if (soa.dx[i] != 0.f) {
+            auto xyz0 = tracks[ids[i]].getXYZGlo(); // the track is in sync with the SoA before the step
+            soa.xyz0[0][i] = xyz0.X();
+            soa.xyz0[1][i] = xyz0.Y();
+            soa.xyz0[2][i] = xyz0.Z();
+          }
+        }
+      }
+      soa.propagate(bZ);
+      for (int i = 0; i < BATCH_SIZE; i++) {
+        if (soa.dx[i] != 0.f && maxSnp > 0 && std::abs(soa.par[o2::track::kSnp][i]) >= maxSnp) {
+          soa.ok[i] = 0;
+        }
+      }
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        const bool useLUT = matCorr == MatCorrType::USEMatCorrLUT && mMatLUT;
+        for (int i = 0; i < n; i++) {
+          if (soa.dx[i] == 0.f || !soa.ok[i]) {
+            for (int k = 0; k < 6; k++) { // null segment, not traversed by the batched LUT query
+              soa.seg[k][i] = 0.f;
+            }
+            continue;
+          }
+          auto& track = tracks[ids[i]];
+          soa.store(i, track);
+          auto xyz1 = track.getXYZGlo();
+          if (useLUT) {
+            for (int k = 0; k < 3; k++) {
+              soa.seg[k][i] = soa.xyz0[k][i];
+            }
+            soa.seg[3][i] = xyz1.X();
+            soa.seg[4][i] = xyz1.Y();
+            soa.seg[5][i] = xyz1.Z();
+          } else {
+            soa.mb[i] = getMatBudget(matCorr, math_utils::Point3D<value_type>(soa.xyz0[0][i], soa.xyz0[1][i], soa.xyz0[2][i]), xyz1);
+          }
+        }
+        if (useLUT) { // the steps outside of the LUT radial span are identified for the whole chunk
+          mMatLUT->getMatBudget(soa.seg[0], soa.seg[1], soa.seg[2], soa.seg[3], soa.seg[4], soa.seg[5], soa.mb, n);
+        }
+        for (int i = 0; i < n; i++) {
+          if (soa.dx[i] == 0.f || !soa.ok[i]) {
+            continue;
+          }
+          auto& track = tracks[ids[i]];
+          const auto& mb = soa.mb[i];
+          int sgn = signCorr ? signCorr : (soa.dx[i] > 0.f ? -1 : 1); // sign of eloss correction is not imposed
+          if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(sgn))) {
+            soa.ok[i] = 0;
+          }
+          soa.load(i, track, bZ);
+        }
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      auto& track = tracks[ids[i]];
+      soa.store(i, track);
+      if (soa.ok[i]) {
+        track.setX(xToGo);
+        nOK++;
+      }
+      if (!status.empty()) {
+        status[ids[i]] = soa.ok[i];
+      }
+    }
+  }
+  return nOK;
+}
+#endif
+
 //____________________________________________________________
 template <typename value_T>
 GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type>::MatCorrType corrType, const math_utils::Point3D<value_type>& p0, const math_utils::Point3D<value_type>& p1) const
@@ -0,0 +1,98 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_MatBudLUT.cxx
+/// \brief  Benchmark of the single segment vs batched material budget query of the LUT
+/// The LUT is read from matbud.root in the current directory or from the file given by the O2_MATBUD_LUT env.variable
+
+#include "benchmark/benchmark.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2::base;
+
+const MatLayerCylSet* getLUT()
+{
+  static std::unique_ptr<MatLayerCylSet> lut;
+  if (!lut) {
+    const char* fname = std::getenv("O2_MATBUD_LUT");
+    lut.reset(MatLayerCylSet::loadFromFile(fname ? fname : "matbud.root"));
+  }
+  return lut.get();
+}
+
+// segments of MAX_STEP-like length along straight tracks from the beam line up to R = 300 cm
+struct Segments {
+  std::vector<float> x0, y0, z0, x1, y1, z1;
+
+  Segments(int n)
+  {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> rnd(0., 1.);
+    const float step = 2.;
+    while (int(x0.size()) < n) {
+      float phi = 2.f * float(M_PI) * rnd(gen), tgl = 2.f * (rnd(gen) - 0.5f), zv = 10.f * (rnd(gen) - 0.5f);
+      float cs = std::cos(phi), sn = std::sin(phi);
+      for (float r = 0.; r < 300. && int(x0.size()) < n; r += step) {
+        x0.push_back(r * cs);
+        y0.push_back(r * sn);
+        z0.push_back(zv + r * tgl);
+        x1.push_back((r + step) * cs);
+        y1.push_back((r + step) * sn);
+        z1.push_back(zv + (r + step) * tgl);
+      }
+    }
+  }
+};
+
+static void BM_MatBudSingle(benchmark::State& state)
+{
+  const auto* lut = getLUT();
+  if (!lut) {
+    state.SkipWithError("material LUT is not available");
+    return;
+  }
+  Segments seg(state.range(0));
+  std::vector<MatBudget> budgets(seg.x0.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < seg.x0.size(); i++) {
+      budgets[i] = lut->getMatBudget(seg.x0[i], seg.y0[i], seg.z0[i], seg.x1[i], seg.y1[i], seg.z1[i]);
+    }
+    benchmark::DoNotOptimize(budgets.data());
+  }
+  state.counters["time/query"] = benchmark::Counter(double(seg.x0.size()) * state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_MatBudBatch(benchmark::State& state)
+{
+  const auto* lut = getLUT();
+  if (!lut) {
+    state.SkipWithError("material LUT is not available");
+    return;
+  }
+  Segments seg(state.range(0));
+  std::vector<MatBudget> budgets(seg.x0.size());
+  for (auto _ : state) {
+    lut->getMatBudget(seg.x0.data(), seg.y0.data(), seg.z0.data(), seg.x1.data(), seg.y1.data(), seg.z1.data(), budgets.data(), budgets.size());
+    benchmark::DoNotOptimize(budgets.data());
+  }
+  state.counters["time/query"] = benchmark::Counter(double(seg.x0.size()) * state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// arg: number of segments
+BENCHMARK(BM_MatBudSingle)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MatBudBatch)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
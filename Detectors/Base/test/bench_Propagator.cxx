@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_Propagator.cxx
+/// \brief  Benchmark of the single track vs batched propagation in the constant field
+
+#include "benchmark/benchmark.h"
+#include "DetectorsBase/Propagator.h"
+#include "ReconstructionDataFormats/Track.h"
+#include <random>
+#include <vector>
+
+using namespace o2::base;
+
+// ITS-like sample (tracks from the outer layers propagated to the beam line) or TPC-like (TPC tracks to the inner TPC radius)
+std::vector<o2::track::TrackParCov> generateTracks(int n, bool tpc)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::vector<o2::track::TrackParCov> tracks;
+  std::array<float, o2::track::kCovMatSize> cov = {1e-4, 0., 1e-4, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  for (int i = 0; i < n; i++) {
+    float x = tpc ? 85. + 165. * rnd(gen) : 2. + 38. * rnd(gen), q2pt = (rnd(gen) - 0.5) * (tpc ? 4. : 10.);
+    std::array<float, o2::track::kNParams> par = {(rnd(gen) - 0.5f) * x * 0.1f, (rnd(gen) - 0.5f) * 100.f, (rnd(gen) - 0.5f) * 0.5f, (rnd(gen) - 0.5f) * 2.f, q2pt};
+    tracks.emplace_back(x, (rnd(gen) - 0.5f) * 6.28f, par, cov);
+  }
+  return tracks;
+}
+
+static void BM_PropagateSingle(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = generateTracks(state.range(0), state.range(1));
+  const float xTarget = state.range(1) ? 83. : 0.;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto tracks = tracks0;
+    state.ResumeTiming();
+    for (auto& trc : tracks) {
+      prop->propagateToX(trc, xTarget, -5.006, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, Propagator::MatCorrType::USEMatCorrNONE);
+    }
+    benchmark::DoNotOptimize(tracks.data());
+  }
+  state.SetItemsProcessed(state.iterations() * tracks0.size());
+}
+
+static void BM_PropagateBatch(benchmark::State& state)
+{
+  auto prop = Propagator::Instance(true);
+  const auto tracks0 = generateTracks(state.range(0), state.range(1));
+  const float xTarget = state.range(1) ? 83. : 0.;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto tracks = tracks0;
+    state.ResumeTiming();
+    prop->propagateToX(tracks, xTarget, -5.006, {}, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, Propagator::MatCorrType::USEMatCorrNONE);
+    benchmark::DoNotOptimize(tracks.data());
+  }
+  state.SetItemsProcessed(state.iterations() * tracks0.size());
+}
+
+// args: number of tracks, 0 for ITS-like or 1 for TPC-like sample
+BENCHMARK(BM_PropagateSingle)->Args({10000, 0})->Args({10000, 1})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PropagateBatch)->Args({10000, 0})->Args({10000, 1})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
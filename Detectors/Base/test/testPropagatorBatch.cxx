@@ -0,0 +1,161 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test batched track propagation
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "ReconstructionDataFormats/Track.h"
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TRandom.h>
+#include <TString.h>
+#include <cmath>
+#include <vector>
+
+namespace o2
+{
+namespace base
+{
+
+std::vector<o2::track::TrackParCov> generateTracks(int n, float xMin, float xMax)
+{
+  std::vector<o2::track::TrackParCov> tracks;
+  std::array<float, o2::track::kCovMatSize> cov = {1e-4, 0., 1e-4, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  for (int i = 0; i < n; i++) {
+    float x = gRandom->Uniform(xMin, xMax);
+    std::array<float, o2::track::kNParams> par = {gRandom->Uniform(-5., 5.), gRandom->Uniform(-50., 50.), gRandom->Uniform(-0.7, 0.7),
+                                                  gRandom->Uniform(-1., 1.), gRandom->Uniform(-10., 10.)};
+    // some neutrals and some tracks which cannot reach the target X
+    tracks.emplace_back(x, gRandom->Uniform(-3.14, 3.14), par, cov, i % 17 ? (i % 2 ? 1 : -1) : 0);
+  }
+  return tracks;
+}
+
+// the batch uses the same arithmetics as the single track propagation, allow only for FMA contraction differences
+bool isClose(float a, float b)
+{
+  return std::abs(a - b) <= 1e-5 * (std::abs(a) + std::abs(b)) + 1e-9;
+}
+
+// propagate the tracks one by one and in the batch and compare the results
+void compareBatchToScalar(Propagator::MatCorrType matCorr)
+{
+  auto prop = Propagator::Instance(true);
+  const float bz = -5.006, xTarget = 83.;
+  gRandom->SetSeed(1);
+  for (int nTr : {1, 31, 32, 1000}) {
+    auto tracks = generateTracks(nTr, 0., 250.);
+    auto tracksRef = tracks;
+    int nOKRef = 0;
+    std::vector<uint8_t> statusRef;
+    for (auto& trc : tracksRef) {
+      statusRef.push_back(prop->propagateToX(trc, xTarget, bz, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr));
+      nOKRef += statusRef.back();
+    }
+    std::vector<uint8_t> status(nTr);
+    int nOK = prop->propagateToX(tracks, xTarget, bz, status, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr);
+    BOOST_CHECK(nOK == nOKRef);
+    BOOST_CHECK((nOK > 0 && nOK < nTr) || nTr == 1);
+    for (int i = 0; i < nTr; i++) {
+      BOOST_CHECK(status[i] == statusRef[i]);
+      BOOST_CHECK(tracks[i].getX() == tracksRef[i].getX());
+      for (int ip = 0; ip < o2::track::kNParams; ip++) {
+        BOOST_CHECK(isClose(tracks[i].getParam(ip), tracksRef[i].getParam(ip)));
+      }
+      for (int ic = 0; ic < o2::track::kCovMatSize; ic++) {
+        BOOST_CHECK(isClose(tracks[i].getCov()[ic], tracksRef[i].getCov()[ic]));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatch)
+{
+  compareBatchToScalar(Propagator::MatCorrType::USEMatCorrNONE);
+}
+
+// material LUT populated from a toy geometry of silicon shells in vacuum, built once for all tests
+const MatLayerCylSet& getToyMatLUT()
+{
+  static MatLayerCylSet lut;
+  static bool built = false;
+  if (built) {
+    return lut;
+  }
+  const float rShell[] = {20., 40., 70., 110., 160., 220.}, shellThickness = 0.5, zHalf = 300.;
+  auto geom = new TGeoManager("PropagatorBatchTest", "toy geometry");
+  auto medVac = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0., 0., 0.));
+  auto medSi = new TGeoMedium("Si", 2, new TGeoMaterial("Si", 28.09, 14., 2.33));
+  auto top = geom->MakeBox("TOP", medVac, 300., 300., zHalf);
+  geom->SetTopVolume(top);
+  int copy = 0;
+  for (auto r : rShell) {
+    top->AddNode(geom->MakeTube(Form("Shell%d", copy), medSi, r, r + shellThickness, zHalf), ++copy);
+  }
+  geom->CloseGeometry();
+
+  for (auto r : rShell) {
+    lut.addLayer(r - 1., r + shellThickness + 1., zHalf, 10., 10.);
+  }
+  lut.populateFromTGeo(2);
+  lut.optimizePhiSlices();
+  lut.flatten();
+  built = true;
+  return lut;
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchMatLUT)
+{
+  auto& lut = getToyMatLUT();
+  BOOST_CHECK(lut.getMatBudget(0., 0., 0., 250., 0., 1.).meanX2X0 > 0.);
+
+  auto prop = Propagator::Instance(true);
+  prop->setMatLUT(&lut);
+  compareBatchToScalar(Propagator::MatCorrType::USEMatCorrLUT);
+  prop->setMatLUT(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MatBudgetBatch)
+{
+  // segments inside, outside and crossing the LUT radial span, including null ones, in a number not multiple of the chunk size
+  auto& lut = getToyMatLUT();
+  const int n = 10 * MatLayerCylSet::BATCH_SIZE + 7;
+  std::vector<float> x0(n), y0(n), z0(n), x1(n), y1(n), z1(n);
+  for (int i = 0; i < n; i++) {
+    float r0 = 250. * gRandom->Rndm(), phi0 = 2.f * float(M_PI) * gRandom->Rndm(), z = 400. * (gRandom->Rndm() - 0.5);
+    x0[i] = r0 * std::cos(phi0);
+    y0[i] = r0 * std::sin(phi0);
+    z0[i] = z;
+    float len = i % 11 == 0 ? 0. : (i % 3 ? 5. : 100.) * gRandom->Rndm(), phi = 2.f * float(M_PI) * gRandom->Rndm(), tgl = gRandom->Rndm() - 0.5;
+    x1[i] = x0[i] + len * std::cos(phi);
+    y1[i] = y0[i] + len * std::sin(phi);
+    z1[i] = z0[i] + len * tgl;
+  }
+  std::vector<o2::base::MatBudget> budgets(n);
+  lut.getMatBudget(x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), budgets.data(), n);
+  int nMat = 0;
+  for (int i = 0; i < n; i++) {
+    auto mb = lut.getMatBudget(x0[i], y0[i], z0[i], x1[i], y1[i], z1[i]);
+    BOOST_CHECK_EQUAL(mb.meanRho, budgets[i].meanRho);
+    BOOST_CHECK_EQUAL(mb.meanX2X0, budgets[i].meanX2X0);
+    BOOST_CHECK_EQUAL(mb.length, budgets[i].length);
+    nMat += mb.meanX2X0 > 0.;
+  }
+  BOOST_CHECK(nMat > 0 && nMat < n);
+}
+
+} // namespace base
+} // namespace o2
@@ -23,6 +23,7 @@
 #include <TRandom.h>
 #include <TStopwatch.h>
 #include <TSystem.h>
+#include <algorithm>
 #include <cstring>
 
 using namespace o2::mch;
@@ -64,6 +65,23 @@ BOOST_AUTO_TEST_CASE(CTFTest, *boost::unit_test::enabled())
   sw.Stop();
   LOG(INFO) << "Compressed in " << sw.CpuTime() << " s";
 
+  // concurrent encoding of the blocks must produce the same blocks as the sequential one
+  {
+    std::vector<o2::ctf::BufferType> vecMT;
+    CTFCoder coder;
+    coder.setNThreads(4);
+    coder.encode(vecMT, rofs, digs);
+    const auto *ctf = CTF::get(vec.data()), *ctfMT = CTF::get(vecMT.data());
+    for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+      const auto &bl = ctf->getBlock(ib), &blMT = ctfMT->getBlock(ib);
+      BOOST_CHECK(bl.getNData() > 0);
+      BOOST_CHECK(bl.getNDict() == blMT.getNDict() && bl.getNData() == blMT.getNData() && bl.getNLiterals() == blMT.getNLiterals());
+      BOOST_CHECK(std::equal(bl.getData(), bl.getData() + bl.getNData(), blMT.getData()));
+      const auto &md = ctf->getMetadata(ib), &mdMT = ctfMT->getMetadata(ib);
+      BOOST_CHECK(md.messageLength == mdMT.messageLength && md.nLiterals == mdMT.nLiterals && md.min == mdMT.min && md.max == mdMT.max);
+    }
+  }
+
   // writing
   {
     sw.Start();
@@ -91,6 +91,42 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
   sw.Stop();
   LOG(INFO) << "Compressed in " << sw.CpuTime() << " s";
 
+  // concurrent encoding of the blocks must produce the same blocks as the sequential one
+  {
+    std::vector<o2::ctf::BufferType> vecMT;
+    CTFCoder coder;
+    coder.setNThreads(4);
+    coder.encode(vecMT, rows, digits, pattVec);
+    const auto *ctf = CTF::get(vec.data()), *ctfMT = CTF::get(vecMT.data());
+    for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+      const auto &bl = ctf->getBlock(ib), &blMT = ctfMT->getBlock(ib);
+      BOOST_CHECK(bl.getNDict() == blMT.getNDict() && bl.getNData() == blMT.getNData() && bl.getNLiterals() == blMT.getNLiterals());
+      BOOST_CHECK(std::equal(bl.getData(), bl.getData() + bl.getNData(), blMT.getData()));
+      const auto &md = ctf->getMetadata(ib), &mdMT = ctfMT->getMetadata(ib);
+      BOOST_CHECK(md.messageLength == mdMT.messageLength && md.nLiterals == mdMT.nLiterals && md.min == mdMT.min && md.max == mdMT.max);
+    }
+  }
+
+  // automatic choice of the blocks encoding must be lossless
+  {
+    std::vector<o2::ctf::BufferType> vecAuto;
+    CTFCoder coder;
+    coder.setAutoEncoding(true);
+    coder.encode(vecAuto, rows, digits, pattVec);
+    std::vector<Digit> digitsA, digitsS;
+    std::vector<ReadoutWindowData> rowsA, rowsS;
+    std::vector<uint8_t> pattVecA, pattVecS;
+    coder.decode(CTF::getImage(vecAuto.data()), rowsA, digitsA, pattVecA);
+    coder.decode(CTF::getImage(vec.data()), rowsS, digitsS, pattVecS);
+    BOOST_CHECK(rowsA.size() == rowsS.size() && digitsA.size() == digitsS.size() && pattVecA == pattVecS);
+    for (size_t i = 0; i < std::min(digitsA.size(), digitsS.size()); i++) {
+      BOOST_CHECK(digitsA[i].getChannel() == digitsS[i].getChannel() && digitsA[i].getTDC() == digitsS[i].getTDC() && digitsA[i].getTOT() == digitsS[i].getTOT());
+    }
+    for (const auto& st : coder.getEncodingStat()) {
+      BOOST_CHECK(st.encodedBytes <= st.sourceBytes + o2::ctf::Alignment);
+    }
+  }
+
   // writing
   {
     sw.Start();
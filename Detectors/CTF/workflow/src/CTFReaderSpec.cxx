@@ -12,6 +12,7 @@
 /// @file   CTFReaderSpec.cxx
 
 #include <vector>
+#include <cstring>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -24,6 +25,7 @@
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFNativeFile.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
 #include "DataFormatsTRD/CTF.h"
@@ -74,11 +76,17 @@ class CTFReaderSpec : public o2::framework::Task
 
  private:
   void openCTFFile(const std::string& flname);
+  void closeCTFFile();
+  size_t getNEntries() const { return mCTFNative ? mCTFNative->getNEntries() : mCTFTree->GetEntries(); }
+  void setFirstTFOrbit(ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader);
+  template <typename C>
+  void processDetector(ProcessingContext& pc, DetID det, const CTFHeader& ctfHeader);
 
   DetID::mask_t mDets;             // detectors
   std::vector<std::string> mInput; // input files
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  std::unique_ptr<CTFNativeFileReader> mCTFNative; // set if the input is in the native (memory-mapped) format
   uint32_t mCTFCounter = 0;
   size_t mNextToProcess = 0;
   int mCurrEntry = 0;
@@ -106,6 +114,11 @@ void CTFReaderSpec::init(InitContext& ic)
 ///_______________________________________
 void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
+  mCurrEntry = 0;
+  if (CTFNativeFileReader::isNativeFile(flname)) {
+    mCTFNative = std::make_unique<CTFNativeFileReader>(flname);
+    return;
+  }
   mCTFFile.reset(TFile::Open(flname.c_str()));
   if (!mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
     LOG(ERROR) << "Failed to open file " << flname;
@@ -115,7 +128,47 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
   if (!mCTFTree) {
     throw std::runtime_error("failed to load CTF tree");
   }
-  mCurrEntry = 0;
+}
+
+///_______________________________________
+void CTFReaderSpec::closeCTFFile()
+{
+  if (mCTFNative) {
+    mCTFNative.reset();
+    return;
+  }
+  mCTFTree.reset();
+  mCTFFile->Close();
+  mCTFFile.reset();
+}
+
+///_______________________________________
+void CTFReaderSpec::setFirstTFOrbit(ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader)
+{
+  auto* hd = pc.outputs().findMessageHeader({label});
+  if (!hd) {
+    throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
+  }
+  hd->firstTForbit = ctfHeader.firstTForbit;
+  hd->tfCounter = mCTFCounter;
+}
+
+///_______________________________________
+template <typename C>
+void CTFReaderSpec::processDetector(ProcessingContext& pc, DetID det, const CTFHeader& ctfHeader)
+{
+  if (!(mDets & ctfHeader.detectors)[det]) {
+    return;
+  }
+  if (mCTFNative) { // the mapped image is already the flat EncodedBlocks buffer: no deserialization, just a single copy to the message
+    auto image = mCTFNative->getImageBuffer(mCurrEntry, det);
+    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, image.size());
+    std::memcpy(bufVec.data(), image.data(), image.size());
+  } else {
+    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(C));
+    C::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
+  }
+  setFirstTFOrbit(pc, det.getName(), ctfHeader);
 }
 
 ///_______________________________________
@@ -131,146 +184,45 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   auto cput = mTimer.CpuTime();
   mTimer.Start(false);
 
-  if (!mCTFTree) { // there is still a tree open with multiple entries
+  if (!mCTFTree && !mCTFNative) { // there is still a file open with multiple entries
     std::string inputFile = o2::utils::Str::concat_string(mCTFDir, mInput[mNextToProcess]);
     LOG(INFO) << "Reading CTF input " << mNextToProcess << ' ' << inputFile;
     openCTFFile(inputFile);
   }
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
+  if (mCTFNative) {
+    ctfHeader = mCTFNative->getCTFHeader(mCurrEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   LOG(INFO) << ctfHeader;
 
-  auto setFirstTFOrbit = [&pc, &ctfHeader, this](const std::string& label) {
-    auto* hd = pc.outputs().findMessageHeader({label});
-    if (!hd) {
-      throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
-    }
-    hd->firstTForbit = ctfHeader.firstTForbit;
-    hd->tfCounter = this->mCTFCounter;
-  };
-
   // send CTF Header
   pc.outputs().snapshot({"header"}, ctfHeader);
-  setFirstTFOrbit("header");
-
-  DetID::mask_t detsTF = mDets & ctfHeader.detectors;
-  DetID det;
-
-  det = DetID::ITS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MFT;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TPC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tpc::CTF));
-    o2::tpc::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TRD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::trd::CTF));
-    o2::trd::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FT0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::ft0::CTF));
-    o2::ft0::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FV0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fv0::CTF));
-    o2::fv0::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FDD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fdd::CTF));
-    o2::fdd::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TOF;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tof::CTF));
-    o2::tof::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MID;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mid::CTF));
-    o2::mid::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MCH;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mch::CTF));
-    o2::mch::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::EMC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::emcal::CTF));
-    o2::emcal::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::PHS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::phos::CTF));
-    o2::phos::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::CPV;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::cpv::CTF));
-    o2::cpv::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::ZDC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::zdc::CTF));
-    o2::zdc::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::HMP;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::hmpid::CTF));
-    o2::hmpid::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
+  setFirstTFOrbit(pc, "header", ctfHeader);
+
+  processDetector<o2::itsmft::CTF>(pc, DetID::ITS, ctfHeader);
+  processDetector<o2::itsmft::CTF>(pc, DetID::MFT, ctfHeader);
+  processDetector<o2::tpc::CTF>(pc, DetID::TPC, ctfHeader);
+  processDetector<o2::trd::CTF>(pc, DetID::TRD, ctfHeader);
+  processDetector<o2::ft0::CTF>(pc, DetID::FT0, ctfHeader);
+  processDetector<o2::fv0::CTF>(pc, DetID::FV0, ctfHeader);
+  processDetector<o2::fdd::CTF>(pc, DetID::FDD, ctfHeader);
+  processDetector<o2::tof::CTF>(pc, DetID::TOF, ctfHeader);
+  processDetector<o2::mid::CTF>(pc, DetID::MID, ctfHeader);
+  processDetector<o2::mch::CTF>(pc, DetID::MCH, ctfHeader);
+  processDetector<o2::emcal::CTF>(pc, DetID::EMC, ctfHeader);
+  processDetector<o2::phos::CTF>(pc, DetID::PHS, ctfHeader);
+  processDetector<o2::cpv::CTF>(pc, DetID::CPV, ctfHeader);
+  processDetector<o2::zdc::CTF>(pc, DetID::ZDC, ctfHeader);
+  processDetector<o2::hmpid::CTF>(pc, DetID::HMP, ctfHeader);
 
   mTimer.Stop();
-  LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, mCTFTree->GetEntries(), mCTFFile->GetName(), mTimer.CpuTime() - cput);
+  LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, getNEntries(), mCTFNative ? mCTFNative->getFileName() : mCTFFile->GetName(), mTimer.CpuTime() - cput);
 
-  bool moreToProcess = (++mCurrEntry < mCTFTree->GetEntries());
+  bool moreToProcess = (++mCurrEntry < getNEntries());
   if (!moreToProcess) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+    closeCTFFile();
     moreToProcess = true;
     if (++mNextToProcess >= mInput.size()) {
       if (++mLoopsCounter >= mLoops) {
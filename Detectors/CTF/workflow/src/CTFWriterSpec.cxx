@@ -20,6 +20,7 @@
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CTFNativeFile.h"
 #include "CommonUtils/StringUtils.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
@@ -103,6 +104,7 @@ class CTFWriterSpec : public o2::framework::Task
   bool mWriteCTF = false;
   bool mCreateDict = false;
   bool mDictPerDetector = false;
+  bool mNativeFormat = false; // write raw EncodedBlocks images + index instead of the TTree
   int mSaveDictAfter = -1; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
   uint64_t mRun = 0;
   size_t mMinSize = 0;     // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
@@ -118,6 +120,7 @@ class CTFWriterSpec : public o2::framework::Task
 
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<CTFNativeFileWriter> mCTFNativeOut;
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -146,7 +149,11 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
   const auto ctfImage = C::getImage(ctfBuffer.data());
   ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "));
   if (mWriteCTF) {
-    sz += ctfImage.appendToTree(*tree, det.getName());
+    if (mNativeFormat) {
+      sz += mCTFNativeOut->addDetector(det, ctfBuffer.data(), ctfBuffer.size());
+    } else {
+      sz += ctfImage.appendToTree(*tree, det.getName());
+    }
     header.detectors.set(det);
   }
   if (mCreateDict) {
@@ -231,6 +238,11 @@ void CTFWriterSpec::init(InitContext& ic)
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
   mDictDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("ctf-dict-dir"));
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("output-dir"));
+  auto format = ic.options().get<std::string>("ctf-format");
+  if (format != "root" && format != "native") {
+    throw std::invalid_argument(o2::utils::Str::concat_string("Invalid ctf-format ", format, ", must be root or native"));
+  }
+  mNativeFormat = format == "native";
   if (mWriteCTF) {
     if (mMinSize > 0) {
       LOG(INFO) << "Multiple CTFs will be accumulated in the tree/file until its size exceeds " << mMinSize << " bytes";
@@ -270,6 +282,9 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   // create header
   CTFHeader header{mRun, dh->firstTForbit};
   size_t szCTF = 0;
+  if (mWriteCTF && mNativeFormat) {
+    mCTFNativeOut->beginTF(header);
+  }
   szCTF += processDet<o2::itsmft::CTF>(pc, DetID::ITS, header, mCTFTreeOut.get());
   szCTF += processDet<o2::itsmft::CTF>(pc, DetID::MFT, header, mCTFTreeOut.get());
   szCTF += processDet<o2::tpc::CTF>(pc, DetID::TPC, header, mCTFTreeOut.get());
@@ -289,10 +304,18 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    std::string outName;
+    if (mNativeFormat) {
+      mCTFNativeOut->endTF();
+      ++mNAccCTF;
+      outName = mCTFNativeOut->getFileName();
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+      mCTFTreeOut->SetEntries(++mNAccCTF);
+      outName = mCTFFileOut->GetName();
+    }
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
-    LOG(INFO) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCTFFileOut->GetName() << " in " << mTimer.CpuTime() - cput << " s";
+    LOG(INFO) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << outName << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
       LOG(INFO) << "Current CTF tree has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
     }
@@ -331,7 +354,7 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!mCTFTreeOut && !mCTFNativeOut) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file
@@ -343,8 +366,12 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
   }
   if (needToOpen) {
     closeTFTreeAndFile();
-    mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    if (mNativeFormat) {
+      mCTFNativeOut = std::make_unique<CTFNativeFileWriter>(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter, "o2_ctf", "ctf")));
+    } else {
+      mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    }
     mNCTFFiles++;
   }
 }
@@ -359,6 +386,11 @@ void CTFWriterSpec::closeTFTreeAndFile()
     mCTFFileOut.reset();
     mNAccCTF = 0;
   }
+  if (mCTFNativeOut) {
+    mCTFNativeOut->close();
+    mCTFNativeOut.reset();
+    mNAccCTF = 0;
+  }
   mAccCTFSize = 0;
 }
 
@@ -449,7 +481,8 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, bool doCTF,
     AlgorithmSpec{adaptFromTask<CTFWriterSpec>(dets, run, doCTF, doDict, dictPerDet, szmn, szmx)},
     Options{{"save-dict-after", VariantType::Int, -1, {"In dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory"}},
-            {"output-dir", VariantType::String, "none", {"CTF output directory"}}}};
+            {"output-dir", VariantType::String, "none", {"CTF output directory"}},
+            {"ctf-format", VariantType::String, "root", {"CTF output format: root (TTree) or native (memory-mappable raw images with index)"}}}};
 }
 
 } // namespace ctf
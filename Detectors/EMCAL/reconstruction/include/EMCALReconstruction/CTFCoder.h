@@ -84,7 +84,8 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const TriggerRecord>& trigData,
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-#define ENCODEEMC(beg, end, slot, bits) CTF::get(buff.data())->encode(beg, end, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
+  o2::ctf::ConcurrentBlocksEncoder<CTF, VEC> blocksEncoder(buff, mNThreads, getAutoEncoding());
+#define ENCODEEMC(beg, end, slot, bits) blocksEncoder.add(beg, end, int(slot), bits, optField[int(slot)], mCoders[int(slot)].get());
   // clang-format off
   ENCODEEMC(helper.begin_bcIncTrig(),    helper.end_bcIncTrig(),     CTF::BLC_bcIncTrig,    0);
   ENCODEEMC(helper.begin_orbitIncTrig(), helper.end_orbitIncTrig(),  CTF::BLC_orbitIncTrig, 0);
@@ -95,6 +96,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const TriggerRecord>& trigData,
   ENCODEEMC(helper.begin_energy(),      helper.end_energy(),       CTF::BLC_energy,      0);
   ENCODEEMC(helper.begin_status(),      helper.end_status(),       CTF::BLC_status,      0);
   // clang-format on
+  blocksEncoder.encode();
   CTF::get(buff.data())->print(getPrefix());
 }
 
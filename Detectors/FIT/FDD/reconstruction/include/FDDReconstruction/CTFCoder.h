@@ -97,7 +97,8 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& digitVec, const g
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-#define ENCODEFDD(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
+  o2::ctf::ConcurrentBlocksEncoder<CTF, VEC> blocksEncoder(buff, mNThreads, getAutoEncoding());
+#define ENCODEFDD(part, slot, bits) blocksEncoder.add(part, int(slot), bits, optField[int(slot)], mCoders[int(slot)].get());
   // clang-format off
   ENCODEFDD(cd.trigger,   CTF::BLC_trigger,  0);
   ENCODEFDD(cd.bcInc,     CTF::BLC_bcInc,    0);
@@ -109,6 +110,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& digitVec, const g
   ENCODEFDD(cd.charge,    CTF::BLC_charge,   0);
   ENCODEFDD(cd.feeBits,   CTF::BLC_feeBits,  0);
   // clang-format on
+  blocksEncoder.encode();
   CTF::get(buff.data())->print(getPrefix());
 }
 
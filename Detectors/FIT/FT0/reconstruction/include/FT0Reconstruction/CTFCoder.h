@@ -100,7 +100,8 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& digitVec, const g
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-#define ENCODEFT0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
+  o2::ctf::ConcurrentBlocksEncoder<CTF, VEC> blocksEncoder(buff, mNThreads, getAutoEncoding());
+#define ENCODEFT0(part, slot, bits) blocksEncoder.add(part, int(slot), bits, optField[int(slot)], mCoders[int(slot)].get());
   // clang-format off
   ENCODEFT0(cd.trigger,   CTF::BLC_trigger,  0);
   ENCODEFT0(cd.bcInc,     CTF::BLC_bcInc,    0);
@@ -112,6 +113,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const Digit>& digitVec, const g
   ENCODEFT0(cd.cfdTime,   CTF::BLC_cfdTime,  0);
   ENCODEFT0(cd.qtcAmpl,   CTF::BLC_qtcAmpl,  0);
   // clang-format on
+  blocksEncoder.encode();
   CTF::get(buff.data())->print(getPrefix());
 }
 
@@ -33,6 +33,8 @@ EntropyEncoderSpec::EntropyEncoderSpec()
 
 void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
 {
+  mCTFCoder.setNThreads(ic.options().get<int>("ctf-encoder-threads"));
+  mCTFCoder.setAutoEncoding(ic.options().get<bool>("ctf-auto-encoding"));
   std::string dictPath = ic.options().get<std::string>("ctf-dict");
   if (!dictPath.empty() && dictPath != "none") {
     mCTFCoder.createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Encoder);
@@ -48,6 +50,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"FT0", "CTFDATA", 0, Lifetime::Timeframe});
   mCTFCoder.encode(buffer, digits, channels);
+  mCTFCoder.sendEncodingMetrics(pc);
   auto eeb = CTF::get(buffer.data()); // cast to container pointer
   eeb->compactify();                  // eliminate unnecessary padding
   buffer.resize(eeb->size());         // shrink buffer to strictly necessary size
@@ -58,6 +61,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
 
 void EntropyEncoderSpec::endOfStream(EndOfStreamContext& ec)
 {
+  mCTFCoder.printEncodingStat();
   LOGF(INFO, "FT0 Entropy Encoding total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
 }
@@ -73,7 +77,9 @@ DataProcessorSpec getEntropyEncoderSpec()
     inputs,
     Outputs{{"FT0", "CTFDATA", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyEncoderSpec>()},
-    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}}}};
+    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}},
+            {"ctf-encoder-threads", VariantType::Int, 1, {"Number of threads for the concurrent entropy encoding of CTF blocks"}},
+            {"ctf-auto-encoding", VariantType::Bool, false, {"Choose per block between external dictionary, TF-local dictionary with optimal precision and raw storage"}}}};
 }
 
 } // namespace ft0
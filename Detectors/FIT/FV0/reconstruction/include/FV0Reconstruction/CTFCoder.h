@@ -95,7 +95,8 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const BCData>& digitVec, const
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-#define ENCODEFV0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
+  o2::ctf::ConcurrentBlocksEncoder<CTF, VEC> blocksEncoder(buff, mNThreads, getAutoEncoding());
+#define ENCODEFV0(part, slot, bits) blocksEncoder.add(part, int(slot), bits, optField[int(slot)], mCoders[int(slot)].get());
   // clang-format off
   ENCODEFV0(cd.bcInc,     CTF::BLC_bcInc,    0);
   ENCODEFV0(cd.orbitInc,  CTF::BLC_orbitInc, 0);
@@ -105,6 +106,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const BCData>& digitVec, const
   ENCODEFV0(cd.time,      CTF::BLC_time,     0);
   ENCODEFV0(cd.charge,    CTF::BLC_charge,   0);
   // clang-format on
+  blocksEncoder.encode();
   CTF::get(buff.data())->print(getPrefix());
 }
 
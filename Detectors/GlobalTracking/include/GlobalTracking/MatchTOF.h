@@ -20,6 +20,7 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <gsl/span>
 #include <TStopwatch.h>
 #include "ReconstructionDataFormats/Track.h"
@@ -94,6 +95,10 @@ class MatchTOF
 
   void setHighPurity(bool value = true) { mSetHighPurity = value; }
 
+  ///< set number of threads used for the per-sector matching
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   ///< print settings
   void print() const;
   void printCandidatesTOF() const;
@@ -189,8 +194,9 @@ class MatchTOF
 
   void doMatching(int sec);
   void doMatchingForTPC(int sec);
-  void selectBestMatches();
-  void selectBestMatchesHP();
+  void selectBestMatches(int sec);
+  void selectBestMatchesHP(int sec);
+  int findFirstTOFCluster(int sec, double tmin) const;
   bool propagateToRefX(o2::track::TrackParCov& trc, float xRef /*in cm*/, float stepInCm /*in cm*/, o2::track::TrackLTIntegral& intLT);
   bool propagateToRefXWithoutCov(o2::track::TrackParCov& trc, float xRef /*in cm*/, float stepInCm /*in cm*/, float bz);
 
@@ -269,9 +275,11 @@ class MatchTOF
   std::array<std::vector<int>, o2::constants::math::NSectors> mTracksSectIndexCache[trkType::SIZE];
   ///< per sector indices of TOF cluster entry in mTOFClusWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusSectIndexCache;
+  ///< per sector times (in ps, at full precision) of TOF clusters in mTOFClusSectIndexCache, for the binary search of the 1st candidate
+  std::array<std::vector<double>, o2::constants::math::NSectors> mTOFClusSectTimeCache;
 
-  ///<array of track-TOFCluster pairs from the matching
-  std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairs;
+  ///< per sector arrays of track-TOFCluster pairs from the matching
+  std::array<std::vector<o2::dataformats::MatchInfoTOFReco>, o2::constants::math::NSectors> mMatchedTracksPairsSec;
 
   ///<array of TOFChannel calibration info
   std::vector<o2::dataformats::CalibInfoTOF> mCalibInfoTOF;
@@ -295,8 +303,16 @@ class MatchTOF
   ///----------- aux stuff --------------///
   static constexpr float MAXSNP = 0.85; // max snp of ITS or TPC track at xRef to be matched
 
-  TStopwatch mTimerTot;
-  TStopwatch mTimerDBG;
+  int mNThreads = 1; ///< number of OMP threads for the per-sector matching
+
+  enum TimerIDs { SWTot,
+                  SWPrepTOF,
+                  SWPrepTracks,
+                  SWDoMatching,
+                  SWSelectBest,
+                  NStopWatches };
+  static constexpr std::string_view TimerName[] = {"Total", "PrepareTOF", "PrepareTracks", "DoMatching", "SelectBest"};
+  TStopwatch mTimer[NStopWatches];
   ClassDefNV(MatchTOF, 1);
 };
 } // namespace globaltracking
@@ -166,6 +166,26 @@ struct MatchRecord {
   }
 };
 
+///< ITS-TPC pair accepted by the matching of single partition, to be registered in the MatchRecords
+struct MatchCandidate {
+  int itsID = MinusOne;     ///< entry in mITSWork
+  int tpcID = MinusOne;     ///< entry in mTPCWork
+  float chi2 = -1.f;        ///< matching chi2
+  int matchedIC = MinusOne; ///< index of eventually matched InteractionCandidate
+  MatchCandidate(int its, int tpc, float chi2match, int candIC) : itsID(its), tpcID(tpc), chi2(chi2match), matchedIC(candIC) {}
+};
+
+///< range of cached TPC tracks of the sector, matched independently from other partitions
+struct MatchingPartition {
+  int sector = 0;
+  int firstTPC = 0; ///< 1st entry in the sector TPC tracks cache
+  int lastTPC = 0;  ///< last entry (excluded) in the sector TPC tracks cache
+  int nCheckTPC = 0;
+  int nCheckITS = 0;
+  std::vector<MatchCandidate> candidates; ///< accepted pairs in the order they were found
+  MatchingPartition(int sec, int first, int last) : sector(sec), firstTPC(first), lastTPC(last) {}
+};
+
 ///< Link of the AfterBurner track: update at sertain cluster
 ///< original track in the currently loaded TPC reco output
 struct ABTrackLink : public o2::track::TrackParCov {
@@ -309,9 +329,16 @@ class MatchTPCITS
   static constexpr int MaxLadderCand = 2 * MaxUpDnLadders + 1; // max ladders to check for matching clusters
   static constexpr int MaxSeedsPerLayer = 50;                  // TODO
   static constexpr int NITSLayers = o2::its::RecoGeomHelper::getNLayers();
+  static constexpr int MinTPCTracksPerPartition = 50; // min number of TPC tracks of the sector to match in single thread
   ///< perform matching for provided input
   void run(const o2::globaltracking::RecoContainer& inp);
 
+  ///< for tests only: match ITS tracks, grouped in ROFs, and constrained TPC tracks with time brackets in \mus, w/o
+  ///< clusters input, i.e. w/o refit of the winners and afterburner. The init() is not needed, but the propagator must
+  ///< be initialized, the ITS ROFrame length and bunch filling must be set
+  void runMatchingOnly(gsl::span<const o2::track::TrackParCov> itsTracks, gsl::span<const o2::itsmft::ROFRecord> itsROFs,
+                       gsl::span<const o2::track::TrackParCov> tpcTracks, gsl::span<const BracketF> tpcTimes);
+
   // RSTODO
   void runAfterBurner();
   bool runAfterBurner(int tpcWID, int iCStart, int iCEnd);
@@ -334,6 +361,8 @@ class MatchTPCITS
   void destroyLastABTrackLinksList();
   void refitABTrack(int ibest) const;
   void setSkipTPCOnly(bool v) { mSkipTPCOnly = v; }
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   void setCosmics(bool v) { mCosmics = v; }
   bool isCosmics() const { return mCosmics; }
 
@@ -384,6 +413,10 @@ class MatchTPCITS
 
   std::vector<o2::dataformats::TrackTPCITS>& getMatchedTracks() { return mMatchedTracks; }
   MCLabContTr& getMatchLabels() { return mOutLabels; }
+  const std::vector<TrackLocTPC>& getTPCWork() const { return mTPCWork; }
+  const std::vector<TrackLocITS>& getITSWork() const { return mITSWork; }
+  const std::vector<MatchRecord>& getMatchRecordsTPC() const { return mMatchRecordsTPC; }
+  const std::vector<MatchRecord>& getMatchRecordsITS() const { return mMatchRecordsITS; }
 
   //>>> ====================== options =============================>>>
   void setUseMatCorrFlag(MatCorrType f) { mUseMatCorrFlag = f; }
@@ -435,6 +468,11 @@ class MatchTPCITS
   int prepareInteractionTimes();
   int prepareTPCTracksAfterBurner();
   void addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float terr, o2::dataformats::GlobalTrackID srcGID, int tpcID);
+  void addTPCWorkTrack(const TrackLocTPC& src);
+  void sortTPCWorkTracks();
+  BracketF registerITSROF(int irof, const o2::InteractionRecord& ir);
+  void addITSWorkTrack(const o2::track::TrackParCov& trcOut, int itsID, int irof, const BracketF& tBracket);
+  void finalizeITSWorkTracks();
 
   int preselectChipClusters(std::vector<int>& clVecOut, const ClusRange& clRange, const ITSChipClustersRefs& clRefs,
                             float trackY, float trackZ, float tolerY, float tolerZ, const o2::MCCompLabel& lblTrc) const;
@@ -442,7 +480,10 @@ class MatchTPCITS
   void cleanAfterBurnerClusRefCache(int currentIC, int& startIC);
   void flagUsedITSClusters(const o2::its::TrackITS& track, int rofOffset);
 
-  void doMatching(int sec);
+  void doMatching();
+  void defineMatchingPartitions(int sec, std::vector<MatchingPartition>& partitions) const;
+  void doMatching(MatchingPartition& part);
+  void registerMatchCandidates(const std::vector<MatchingPartition>& partitions);
 
   void refitWinners();
   bool refitTrackTPCITS(int iTPC, int& iITS);
@@ -474,7 +515,7 @@ class MatchTPCITS
   int getNMatchRecordsITS(const TrackLocITS& tITS) const;
 
   ///< convert time bracket to IR bracket
-  BracketIR tBracket2IRBracket(const BracketF tbrange);
+  BracketIR tBracket2IRBracket(const BracketF tbrange) const;
 
   ///< convert time to ITS ROFrame units in case of continuous ITS readout
   int time2ITSROFrameCont(float t) const
@@ -525,6 +566,7 @@ class MatchTPCITS
   bool mMCTruthON = false; ///< flag availability of MC truth
   float mBz = 0;           ///< nominal Bz
   int mTFCount = 0;        ///< internal TF counter for debugger
+  int mNThreads = 1;       ///< number of threads used for matching
   o2::InteractionRecord mStartIR{0, 0}; ///< IR corresponding to the start of the TF
 
   ///========== Parameters to be set externally, e.g. from CCDB ====================
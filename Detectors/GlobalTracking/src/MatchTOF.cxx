@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include <TTree.h>
+#include <algorithm>
 #include <cassert>
 
 #include "FairLogger.h"
@@ -61,11 +62,11 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
   mStartIR = inp.startIR;
   updateTimeDependentParams();
 
-  mTimerTot.Start();
-
-  mTimerTot.Stop();
-  LOGF(INFO, "Timing prepareTOFCluster: Cpu: %.3e s Real: %.3e s in %d slots", mTimerTot.CpuTime(), mTimerTot.RealTime(), mTimerTot.Counter() - 1);
-  mTimerTot.Start();
+  for (int i = NStopWatches; i--;) {
+    mTimer[i].Stop();
+    mTimer[i].Reset();
+  }
+  mTimer[SWTot].Start(false);
 
   for (int i = 0; i < trkType::SIZE; i++) {
     mMatchedTracks[i].clear();
@@ -73,30 +74,52 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
     mOutTOFLabels[i].clear();
   }
 
-  if (!prepareTOFClusters()) { // check cluster before of tracks to see also if MC is required
+  mTimer[SWPrepTOF].Start(false);
+  bool clusOK = prepareTOFClusters(); // check cluster before of tracks to see also if MC is required
+  mTimer[SWPrepTOF].Stop();
+  if (!clusOK) {
+    mTimer[SWTot].Stop();
     return;
   }
 
-  if (!prepareTPCData() || !prepareFITData()) {
+  mTimer[SWPrepTracks].Start(false);
+  bool trackOK = prepareTPCData() && prepareFITData();
+  mTimer[SWPrepTracks].Stop();
+  if (!trackOK) {
+    mTimer[SWTot].Stop();
     return;
   }
 
-  mTimerTot.Stop();
-  LOGF(INFO, "Timing prepare tracks: Cpu: %.3e s Real: %.3e s in %d slots", mTimerTot.CpuTime(), mTimerTot.RealTime(), mTimerTot.Counter() - 1);
-  mTimerTot.Start();
-
-  for (int sec = o2::constants::math::NSectors; sec--;) {
-    mMatchedTracksPairs.clear(); // new sector
-    LOG(INFO) << "Doing matching for sector " << sec << "...";
+  // sectors are matched independently: each track and each TOF cluster is cached in a single sector,
+  // the candidate pairs are stored per sector and the best matches are selected sequentially in the original sector order
+  mTimer[SWDoMatching].Start(false);
+  Geo::Init(); // Geo::getPadDxDyDz initializes the geometry lazily, do it before the threads are started
+  int nThreads = mNThreads;
+  if (nThreads > 1 && !o2::base::Propagator::Instance()->getMatLUT()) { // the material would be queried from TGeo, which is not thread-safe
+    LOG(WARNING) << "No material LUT is loaded, matching TOF sectors with 1 thread instead of " << nThreads;
+    nThreads = 1;
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int isec = 0; isec < o2::constants::math::NSectors; isec++) {
+    int sec = o2::constants::math::NSectors - 1 - isec;
+    mMatchedTracksPairsSec[sec].clear(); // new sector
     if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
       doMatching(sec);
     }
     if (mIsTPCused) {
       doMatchingForTPC(sec);
     }
-    LOG(INFO) << "...done. Now check the best matches";
-    selectBestMatches();
   }
+  mTimer[SWDoMatching].Stop();
+
+  mTimer[SWSelectBest].Start(false);
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    LOG(INFO) << "Check the best matches for sector " << sec;
+    selectBestMatches(sec);
+  }
+  mTimer[SWSelectBest].Stop();
 
   // re-arrange outputs from constrained/unconstrained to the 4 cases (TPC, ITS-TPC, TPC-TRD, ITS-TPC-TRD) to be implemented as soon as TPC-TRD and ITS-TPC-TRD tracks available
   //  splitOutputs();
@@ -106,8 +129,19 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
   mIsTPCTRDused = false;
   mIsITSTPCTRDused = false;
 
-  mTimerTot.Stop();
-  LOGF(INFO, "Timing Do Matching: Cpu: %.3e s Real: %.3e s in %d slots", mTimerTot.CpuTime(), mTimerTot.RealTime(), mTimerTot.Counter() - 1);
+  mTimer[SWTot].Stop();
+  for (int i = 0; i < NStopWatches; i++) {
+    LOGF(INFO, "Timing for %15s: Cpu: %.3e Real: %.3e s with %d thread(s)", TimerName[i].data(), mTimer[i].CpuTime(), mTimer[i].RealTime(), nThreads);
+  }
+}
+//______________________________________________
+void MatchTOF::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
 }
 //______________________________________________
 void MatchTOF::print() const
@@ -384,6 +418,16 @@ bool MatchTOF::prepareTOFClusters()
     });
   } // loop over TOF clusters of single sector
 
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    const auto& indexCache = mTOFClusSectIndexCache[sec];
+    auto& timeCache = mTOFClusSectTimeCache[sec];
+    timeCache.clear();
+    timeCache.reserve(indexCache.size());
+    for (auto icl : indexCache) {
+      timeCache.push_back(mTOFClusWork[icl].getTime());
+    }
+  }
+
   if (mMatchedClustersIndex) {
     delete[] mMatchedClustersIndex;
   }
@@ -405,7 +449,6 @@ void MatchTOF::doMatching(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0;                          // starting index in TOF clusters for matching of the track
   int detId[2][5];                        // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
   float deltaPos[2][3];                   // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
   o2::track::TrackLTIntegral trkLTInt[2]; // Here we store the integrated track length and time for the (max 2) matched strips
@@ -542,17 +585,12 @@ void MatchTOF::doMatching(int sec)
       continue; // the track never hit a TOF strip during the propagation
     }
     bool foundCluster = false;
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
+    for (auto itof = findFirstTOFCluster(sec, minTrkTime); itof < nTOFCls; itof++) {
       //      printf("itof = %d\n", itof);
       auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
       // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
       //Printf("trefTOF.getTime() = %f, maxTrkTime = %f, minTrkTime = %f", trefTOF.getTime(), maxTrkTime, minTrkTime);
 
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        //Printf("In trefTOF.getTime() < minTrkTime");
-        itof0 = itof + 1; // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-        continue;
-      }
       if (trefTOF.getTime() > maxTrkTime) { // no more TOF clusters can be matched to this track
         break;
       }
@@ -626,7 +664,7 @@ void MatchTOF::doMatching(int sec)
           // set event indexes (to be checked)
           evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
           evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[type][indices[0]][itrk]), o2::dataformats::GlobalTrackID::ITSTPC});
-          mMatchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], eventIndexTracks, type); // TODO: check if this is correct!
+          mMatchedTracksPairsSec[sec].emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], eventIndexTracks, type); // TODO: check if this is correct!
         }
       }
     }
@@ -653,7 +691,6 @@ void MatchTOF::doMatchingForTPC(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0; // starting index in TOF clusters for matching of the track
   float deltaPosTemp[3];
   std::array<float, 3> pos;
   std::array<float, 3> posBeforeProp;
@@ -681,7 +718,6 @@ void MatchTOF::doMatchingForTPC(int sec)
 
     int side = mSideTPC[cacheTrk[itrk]];
     // look at BC candidates for the track
-    itof0 = 0;
     double minTrkTime = (trackWork.second.getTimeStamp() - trackWork.second.getTimeStampError()) * 1.E6; // minimum time in ps
     minTrkTime = int(minTrkTime / BCgranularity) * BCgranularity;                                        // align min to a BC
     double maxTrkTime = (trackWork.second.getTimeStamp() + mExtraTPCFwdTime[cacheTrk[itrk]]) * 1.E6;     // maximum time in ps
@@ -694,14 +730,9 @@ void MatchTOF::doMatchingForTPC(int sec)
       }
     }
 
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
+    for (auto itof = findFirstTOFCluster(sec, minTrkTime); itof < nTOFCls; itof++) {
       auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
 
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        itof0 = itof + 1;
-        continue;
-      }
-
       if (trefTOF.getTime() > maxTrkTime) { // this cluster has a time that is too large for the current track, close loop
         break;
       }
@@ -849,16 +880,11 @@ void MatchTOF::doMatchingForTPC(int sec)
       }
 
       bool foundCluster = false;
-      itof0 = 0;
-      for (auto itof = itof0; itof < nTOFCls; itof++) {
+      for (auto itof = findFirstTOFCluster(sec, minTime); itof < nTOFCls; itof++) {
         //      printf("itof = %d\n", itof);
         auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
         // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
 
-        if (trefTOF.getTime() < minTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-          itof0 = itof + 1;                // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-          continue;
-        }
         if (trefTOF.getTime() > maxTime) { // no more TOF clusters can be matched to this track
           break;
         }
@@ -939,7 +965,7 @@ void MatchTOF::doMatchingForTPC(int sec)
             // set event indexes (to be checked)
             evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
             evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[trkType::UNCONS][indices[0]][itrk]), o2::dataformats::GlobalTrackID::TPC});
-            mMatchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], eventIndexTracks, trkType::UNCONS, resZ / vdrift * side, trefTOF.getZ()); // TODO: check if this is correct!
+            mMatchedTracksPairsSec[sec].emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], eventIndexTracks, trkType::UNCONS, resZ / vdrift * side, trefTOF.getZ()); // TODO: check if this is correct!
           }
         }
       }
@@ -948,6 +974,13 @@ void MatchTOF::doMatchingForTPC(int sec)
   return;
 }
 //______________________________________________
+int MatchTOF::findFirstTOFCluster(int sec, double tmin) const
+{
+  ///< index in the time-ordered sector cache of the 1st TOF cluster with time >= tmin
+  const auto& timeCache = mTOFClusSectTimeCache[sec];
+  return std::lower_bound(timeCache.begin(), timeCache.end(), tmin) - timeCache.begin();
+}
+//______________________________________________
 int MatchTOF::findFITIndex(int bc)
 {
   if (mFITRecPoints.size() == 0) {
@@ -973,22 +1006,23 @@ int MatchTOF::findFITIndex(int bc)
   return index;
 }
 //______________________________________________
-void MatchTOF::selectBestMatches()
+void MatchTOF::selectBestMatches(int sec)
 {
   if (mSetHighPurity) {
-    selectBestMatchesHP();
+    selectBestMatchesHP(sec);
     return;
   }
   ///< define the track-TOFcluster pair per sector
+  auto& matchedPairs = mMatchedTracksPairsSec[sec];
 
-  LOG(INFO) << "Number of pair matched = " << mMatchedTracksPairs.size();
+  LOG(INFO) << "Number of pair matched = " << matchedPairs.size();
 
   // first, we sort according to the chi2
-  std::sort(mMatchedTracksPairs.begin(), mMatchedTracksPairs.end(), [this](o2::dataformats::MatchInfoTOFReco& a, o2::dataformats::MatchInfoTOFReco& b) { return (a.getChi2() < b.getChi2()); });
+  std::sort(matchedPairs.begin(), matchedPairs.end(), [this](o2::dataformats::MatchInfoTOFReco& a, o2::dataformats::MatchInfoTOFReco& b) { return (a.getChi2() < b.getChi2()); });
   int i = 0;
 
   // then we take discard the pairs if their track or cluster was already matched (since they are ordered in chi2, we will take the best matching)
-  for (const o2::dataformats::MatchInfoTOFReco& matchingPair : mMatchedTracksPairs) {
+  for (const o2::dataformats::MatchInfoTOFReco& matchingPair : matchedPairs) {
     int trkType = (int)matchingPair.getTrackType();
     if (mMatchedTracksIndex[trkType][matchingPair.getTrackIndex()] != -1) { // the track was already filled
       continue;
@@ -1033,21 +1067,22 @@ void MatchTOF::selectBestMatches()
   }
 }
 //______________________________________________
-void MatchTOF::selectBestMatchesHP()
+void MatchTOF::selectBestMatchesHP(int sec)
 {
   ///< define the track-TOFcluster pair per sector
+  auto& matchedPairs = mMatchedTracksPairsSec[sec];
   float chi2SeparationCut = 2;
   float chi2S = 3;
 
-  LOG(INFO) << "Number of pair matched = " << mMatchedTracksPairs.size();
+  LOG(INFO) << "Number of pair matched = " << matchedPairs.size();
 
   std::vector<o2::dataformats::MatchInfoTOFReco> tmpMatch;
 
   // first, we sort according to the chi2
-  std::sort(mMatchedTracksPairs.begin(), mMatchedTracksPairs.end(), [this](o2::dataformats::MatchInfoTOFReco& a, o2::dataformats::MatchInfoTOFReco& b) { return (a.getChi2() < b.getChi2()); });
+  std::sort(matchedPairs.begin(), matchedPairs.end(), [this](o2::dataformats::MatchInfoTOFReco& a, o2::dataformats::MatchInfoTOFReco& b) { return (a.getChi2() < b.getChi2()); });
   int i = 0;
   // then we take discard the pairs if their track or cluster was already matched (since they are ordered in chi2, we will take the best matching)
-  for (const o2::dataformats::MatchInfoTOFReco& matchingPair : mMatchedTracksPairs) {
+  for (const o2::dataformats::MatchInfoTOFReco& matchingPair : matchedPairs) {
     int trkType = (int)matchingPair.getTrackType();
 
     bool discard = matchingPair.getChi2() > chi2S;
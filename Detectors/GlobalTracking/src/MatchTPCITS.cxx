@@ -268,11 +268,7 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp)
     return;
   }
 
-  mTimer[SWDoMatching].Start(false);
-  for (int sec = o2::constants::math::NSectors; sec--;) {
-    doMatching(sec);
-  }
-  mTimer[SWDoMatching].Stop();
+  doMatching();
   if (0) { // enabling this creates very verbose output
     mTimer[SWTot].Stop();
     printCandidatesTPC();
@@ -306,6 +302,39 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp)
   mTFCount++;
 }
 
+//______________________________________________
+void MatchTPCITS::runMatchingOnly(gsl::span<const o2::track::TrackParCov> itsTracks, gsl::span<const o2::itsmft::ROFRecord> itsROFs,
+                                  gsl::span<const o2::track::TrackParCov> tpcTracks, gsl::span<const BracketF> tpcTimes)
+{
+  ///< match ITS and TPC tracks w/o clusters input, i.e. w/o refit of the winners and afterburner (for tests only)
+  mParams = &Params::Instance();
+  mSectEdgeMargin2 = mParams->crudeAbsDiffCut[o2::track::kY] * mParams->crudeAbsDiffCut[o2::track::kY];
+  setUseMatCorrFlag(MatCorrType::USEMatCorrNONE);
+  mStartIR = {0, 0};
+  updateTimeDependentParams();
+
+  clear();
+
+  for (int irof = 0; irof < int(itsROFs.size()); irof++) {
+    const auto& rofRec = itsROFs[irof];
+    auto tBracket = registerITSROF(irof, rofRec.getBCData());
+    int trlim = rofRec.getFirstEntry() + rofRec.getNEntries();
+    for (int it = rofRec.getFirstEntry(); it < trlim; it++) {
+      addITSWorkTrack(itsTracks[it], it, irof, tBracket);
+    }
+  }
+  finalizeITSWorkTracks();
+
+  for (int it = 0; it < int(tpcTracks.size()); it++) {
+    const auto& tBracket = tpcTimes[it];
+    addTPCWorkTrack(TrackLocTPC{tpcTracks[it], tBracket, tBracket.mean(), 0.5f * tBracket.delta(), it, GTrackID(it, GTrackID::TPC), MinusOne, TrackLocTPC::Constrained});
+  }
+  sortTPCWorkTracks();
+
+  doMatching();
+  selectBestMatches();
+}
+
 //______________________________________________
 void MatchTPCITS::end()
 {
@@ -432,10 +461,6 @@ void MatchTPCITS::updateTimeDependentParams()
 
   mMinTPCTrackPtInv = (mFieldON && mParams->minTPCTrackR > 0) ? 1. / std::abs(mParams->minTPCTrackR * mBz * o2::constants::math::B2C) : 999.;
   mMinITSTrackPtInv = (mFieldON && mParams->minITSTrackR > 0) ? 1. / std::abs(mParams->minITSTrackR * mBz * o2::constants::math::B2C) : 999.;
-
-  o2::math_utils::Point3D<float> p0(90., 1., 1), p1(90., 100., 100.);
-  auto matbd = o2::base::Propagator::Instance()->getMatBudget(mParams->matCorr, p0, p1);
-  mTPCmeanX0Inv = matbd.meanX2X0 / matbd.length;
 }
 
 //______________________________________________
@@ -558,7 +583,7 @@ void MatchTPCITS::addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float
   } else {
     terr += tpcTimeBin2MUS(tpcOrig.hasBothSidesClusters() ? mParams->safeMarginTPCITSTimeBin : mTPCTimeEdgeTSafeMargin);
   }
-  auto& trc = mTPCWork.emplace_back(
+  addTPCWorkTrack(
     TrackLocTPC{_tr, {t0 - terr, t0 + terr}, extConstrained ? t0 : tpcTimeBin2MUS(tpcOrig.getTime0()),
                 // for A/C constrained tracks the terr is half-interval, for externally constrained tracks it is sigma*Nsigma
                 terr * (extConstrained ? mTPCExtConstrainedNSigmaInv : SQRT12DInv),
@@ -566,13 +591,20 @@ void MatchTPCITS::addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float
                 srcGID,
                 MinusOne,
                 (extConstrained || tpcOrig.hasBothSidesClusters()) ? TrackLocTPC::Constrained : (tpcOrig.hasASideClustersOnly() ? TrackLocTPC::ASide : TrackLocTPC::CSide)});
+}
+
+//______________________________________________
+void MatchTPCITS::addTPCWorkTrack(const TrackLocTPC& src)
+{
+  ///< create working copy of TPC track at the matching Xref and cache it in its sector
+  auto& trc = mTPCWork.emplace_back(src);
   // propagate to matching Xref
   if (!propagateToRefX(trc)) {
     mTPCWork.pop_back(); // discard track whose propagation to XMatchingRef failed
     return;
   }
   if (mMCTruthON) {
-    mTPCLblWork.emplace_back(mTPCTrkLabels[tpcID]);
+    mTPCLblWork.emplace_back(mTPCTrkLabels[trc.sourceID]);
   }
   // cache work track index
   mTPCSectIndexCache[o2::math_utils::angle2Sector(trc.getAlpha())].push_back(mTPCWork.size() - 1);
@@ -628,6 +660,21 @@ bool MatchTPCITS::prepareTPCData()
     return true;
   };
   mRecoCont->createTracksVariadic(creator);
+  sortTPCWorkTracks();
+
+  o2::math_utils::Point3D<float> p0(90., 1., 1), p1(90., 100., 100.);
+  auto matbd = o2::base::Propagator::Instance()->getMatBudget(mParams->matCorr, p0, p1);
+  mTPCmeanX0Inv = matbd.meanX2X0 / matbd.length;
+  mTPCRefitter = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(mTPCClusterIdxStruct, mTPCTransform.get(), mBz, mTPCTrackClusIdx.data(), mTPCRefitterShMap.data(), nullptr, o2::base::Propagator::Instance());
+
+  mTimer[SWPrepTPC].Stop();
+  return mTPCWork.size() > 0;
+}
+
+//_____________________________________________________
+void MatchTPCITS::sortTPCWorkTracks()
+{
+  ///< sort TPC work tracks of every sector in time and find 1st tracks which may match to every ITS ROF
 
   float maxTime = 0;
   int nITSROFs = mITSROFTimes.size();
@@ -690,10 +737,6 @@ bool MatchTPCITS::prepareTPCData()
     mITSROFofTPCBin[ib] = itsROF;
   }
 */
-  mTPCRefitter = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(mTPCClusterIdxStruct, mTPCTransform.get(), mBz, mTPCTrackClusIdx.data(), mTPCRefitterShMap.data(), nullptr, o2::base::Propagator::Instance());
-
-  mTimer[SWPrepTPC].Stop();
-  return mTPCWork.size() > 0;
 }
 
 //_____________________________________________________
@@ -733,28 +776,13 @@ bool MatchTPCITS::prepareITSData()
   int nITSClus = lastClROF.getFirstEntry() + lastClROF.getNEntries();
   mABClusterLinkIndex.resize(nITSClus, MinusOne);
   for (int sec = o2::constants::math::NSectors; sec--;) {
-    mITSTimeStart[sec].resize(nROFs, -1); // start of ITS work tracks in every sector
+    mITSTimeStart[sec].reserve(nROFs); // start of ITS work tracks in every sector
   }
 
   for (int irof = 0; irof < nROFs; irof++) {
     const auto& rofRec = mITSTrackROFRec[irof];
-    int nBC = rofRec.getBCData().differenceInBC(mStartIR);
-    float tMin = nBC * o2::constants::lhc::LHCBunchSpacingMUS;
-    float tMax = (nBC + mITSROFrameLengthInBC) * o2::constants::lhc::LHCBunchSpacingMUS;
-    if (!mITSTriggered) {
-      auto irofCont = nBC / mITSROFrameLengthInBC;
-      if (mITSTrackROFContMapping.size() <= irofCont) { // there might be gaps in the non-empty rofs, this will map continuous ROFs index to non empty ones
-        mITSTrackROFContMapping.resize((1 + irofCont / 128) * 128, 0);
-      }
-      mITSTrackROFContMapping[irofCont] = irof;
-    }
-
+    auto tBracket = registerITSROF(irof, rofRec.getBCData());
     int cluROFOffset = mITSClusterROFRec[irof].getFirstEntry(); // clusters of this ROF start at this offset
-    mITSROFTimes.emplace_back(tMin, tMax);                      // ITS ROF min/max time
-
-    for (int sec = o2::constants::math::NSectors; sec--;) {         // start of sector's tracks for this ROF
-      mITSTimeStart[sec][irof] = mITSSectIndexCache[sec].size();    // The sorting does not affect this
-    }
 
     int trlim = rofRec.getFirstEntry() + rofRec.getNEntries();
     for (int it = rofRec.getFirstEntry(); it < trlim; it++) {
@@ -768,47 +796,85 @@ bool MatchTPCITS::prepareITSData()
       if (std::abs(trcOrig.getQ2Pt()) > mMinITSTrackPtInv) {
         continue;
       }
-      int nWorkTracks = mITSWork.size();
-      // working copy of outer track param
-      auto& trc = mITSWork.emplace_back(TrackLocITS{trcOrig.getParamOut(), {tMin, tMax}, it, irof, MinusOne});
-      if (!trc.rotate(o2::math_utils::angle2Alpha(trc.getPhiPos()))) {
-        mITSWork.pop_back(); // discard failed track
-        continue;
-      }
-      // make sure the track is at the ref. radius
-      if (!propagateToRefX(trc)) {
-        mITSWork.pop_back(); // discard failed track
-        continue;            // add to cache only those ITS tracks which reached ref.X and have reasonable snp
-      }
-      if (mMCTruthON) {
-        mITSLblWork.emplace_back(mITSTrkLabels[it]);
-      }
-      // cache work track index
-      int sector = o2::math_utils::angle2Sector(trc.getAlpha());
-      mITSSectIndexCache[sector].push_back(nWorkTracks);
+      addITSWorkTrack(trcOrig.getParamOut(), it, irof, tBracket);
+    }
+  }
+  finalizeITSWorkTracks();
+  mMatchRecordsITS.reserve(mITSWork.size() * mParams->maxMatchCandidates);
+  mTimer[SWPrepITS].Stop();
 
-      // If the ITS track is very close to the sector edge, it may match also to a TPC track in the neighb. sector.
-      // For a track with Yr and Phir at Xr the distance^2 between the poisition of this track in the neighb. sector
-      // when propagated to Xr (in this neighbouring sector) and the edge will be (neglecting the curvature)
-      // [(Xr*tg(10)-Yr)/(tgPhir+tg70)]^2  / cos(70)^2  // for the next sector
-      // [(Xr*tg(10)+Yr)/(tgPhir-tg70)]^2  / cos(70)^2  // for the prev sector
-      // Distances to the sector edges in neighbourings sectors (at Xref in theit proper frames)
-      float tgp = trc.getSnp();
-      tgp /= std::sqrt((1.f - tgp) * (1.f + tgp)); // tan of track direction XY
+  return nITSClus > 0;
+}
 
-      // sector up
-      float dy2Up = (YMaxAtXMatchingRef - trc.getY()) / (tgp + Tan70);
-      if ((dy2Up * dy2Up * Cos70I2) < mSectEdgeMargin2) { // need to check this track for matching in sector up
-        addLastTrackCloneForNeighbourSector(sector < (o2::constants::math::NSectors - 1) ? sector + 1 : 0);
-      }
-      // sector down
-      float dy2Dn = (YMaxAtXMatchingRef + trc.getY()) / (tgp - Tan70);
-      if ((dy2Dn * dy2Dn * Cos70I2) < mSectEdgeMargin2) { // need to check this track for matching in sector down
-        addLastTrackCloneForNeighbourSector(sector > 1 ? sector - 1 : o2::constants::math::NSectors - 1);
-      }
+//_____________________________________________________
+MatchTPCITS::BracketF MatchTPCITS::registerITSROF(int irof, const o2::InteractionRecord& ir)
+{
+  ///< register min/max time of the ITS ROF and the start of its tracks in the sectors caches
+  int nBC = ir.differenceInBC(mStartIR);
+  float tMin = nBC * o2::constants::lhc::LHCBunchSpacingMUS;
+  float tMax = (nBC + mITSROFrameLengthInBC) * o2::constants::lhc::LHCBunchSpacingMUS;
+  if (!mITSTriggered) {
+    auto irofCont = nBC / mITSROFrameLengthInBC;
+    if (mITSTrackROFContMapping.size() <= irofCont) { // there might be gaps in the non-empty rofs, this will map continuous ROFs index to non empty ones
+      mITSTrackROFContMapping.resize((1 + irofCont / 128) * 128, 0);
     }
+    mITSTrackROFContMapping[irofCont] = irof;
+  }
+  mITSROFTimes.emplace_back(tMin, tMax); // ITS ROF min/max time
+
+  for (int sec = o2::constants::math::NSectors; sec--;) {         // start of sector's tracks for this ROF
+    mITSTimeStart[sec].push_back(mITSSectIndexCache[sec].size()); // The sorting does not affect this
+  }
+  return mITSROFTimes.back();
+}
+
+//_____________________________________________________
+void MatchTPCITS::addITSWorkTrack(const o2::track::TrackParCov& trcOut, int itsID, int irof, const BracketF& tBracket)
+{
+  ///< create working copy of outer param of ITS track at the matching Xref and cache it in its sector(s)
+  int nWorkTracks = mITSWork.size();
+  auto& trc = mITSWork.emplace_back(TrackLocITS{trcOut, tBracket, itsID, irof, MinusOne});
+  if (!trc.rotate(o2::math_utils::angle2Alpha(trc.getPhiPos()))) {
+    mITSWork.pop_back(); // discard failed track
+    return;
+  }
+  // make sure the track is at the ref. radius
+  if (!propagateToRefX(trc)) {
+    mITSWork.pop_back(); // discard failed track
+    return;              // add to cache only those ITS tracks which reached ref.X and have reasonable snp
+  }
+  if (mMCTruthON) {
+    mITSLblWork.emplace_back(mITSTrkLabels[itsID]);
   }
+  // cache work track index
+  int sector = o2::math_utils::angle2Sector(trc.getAlpha());
+  mITSSectIndexCache[sector].push_back(nWorkTracks);
+
+  // If the ITS track is very close to the sector edge, it may match also to a TPC track in the neighb. sector.
+  // For a track with Yr and Phir at Xr the distance^2 between the poisition of this track in the neighb. sector
+  // when propagated to Xr (in this neighbouring sector) and the edge will be (neglecting the curvature)
+  // [(Xr*tg(10)-Yr)/(tgPhir+tg70)]^2  / cos(70)^2  // for the next sector
+  // [(Xr*tg(10)+Yr)/(tgPhir-tg70)]^2  / cos(70)^2  // for the prev sector
+  // Distances to the sector edges in neighbourings sectors (at Xref in theit proper frames)
+  float tgp = trc.getSnp();
+  tgp /= std::sqrt((1.f - tgp) * (1.f + tgp)); // tan of track direction XY
+
+  // sector up
+  float dy2Up = (YMaxAtXMatchingRef - trc.getY()) / (tgp + Tan70);
+  if ((dy2Up * dy2Up * Cos70I2) < mSectEdgeMargin2) { // need to check this track for matching in sector up
+    addLastTrackCloneForNeighbourSector(sector < (o2::constants::math::NSectors - 1) ? sector + 1 : 0);
+  }
+  // sector down
+  float dy2Dn = (YMaxAtXMatchingRef + trc.getY()) / (tgp - Tan70);
+  if ((dy2Dn * dy2Dn * Cos70I2) < mSectEdgeMargin2) { // need to check this track for matching in sector down
+    addLastTrackCloneForNeighbourSector(sector > 1 ? sector - 1 : o2::constants::math::NSectors - 1);
+  }
+}
 
+//_____________________________________________________
+void MatchTPCITS::finalizeITSWorkTracks()
+{
+  ///< fill the gaps in the continuous ROFs mapping and sort ITS work tracks of every sector
   if (!mITSTriggered) { // fill the gaps;
     int nr = mITSTrackROFContMapping.size();
     for (int i = 1; i < nr; i++) {
@@ -837,10 +903,6 @@ bool MatchTPCITS::prepareITSData()
       return trackA.getTgl() < trackB.getTgl();
     });
   } // loop over tracks of single sector
-  mMatchRecordsITS.reserve(mITSWork.size() * mParams->maxMatchCandidates);
-  mTimer[SWPrepITS].Stop();
-
-  return nITSClus > 0;
 }
 
 //_____________________________________________________
@@ -855,23 +917,39 @@ bool MatchTPCITS::prepareFITData()
 }
 
 //_____________________________________________________
-void MatchTPCITS::doMatching(int sec)
+void MatchTPCITS::doMatching()
+{
+  ///< match TPC and ITS tracks of all sectors.
+  ///< The sectors are split to partitions of TPC tracks which are matched concurrently, collecting the accepted pairs.
+  ///< These are registered in the MatchRecords in the same order as they would be found by the sequential processing
+  mTimer[SWDoMatching].Start(false);
+  std::vector<MatchingPartition> partitions;
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    defineMatchingPartitions(sec, partitions);
+  }
+  int nPartitions = partitions.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ip = 0; ip < nPartitions; ip++) {
+    doMatching(partitions[ip]);
+  }
+  registerMatchCandidates(partitions);
+  mTimer[SWDoMatching].Stop();
+}
+
+//_____________________________________________________
+void MatchTPCITS::defineMatchingPartitions(int sec, std::vector<MatchingPartition>& partitions) const
 {
-  ///< run matching for currently cached ITS data for given TPC sector
-  auto& cacheITS = mITSSectIndexCache[sec];   // array of cached ITS track indices for this sector
-  auto& cacheTPC = mTPCSectIndexCache[sec];   // array of cached ITS track indices for this sector
-  auto& timeStartTPC = mTPCTimeStart[sec];    // array of 1st TPC track with timeMax in ITS ROFrame
-  auto& timeStartITS = mITSTimeStart[sec];
+  ///< split cached TPC tracks of the sector to partitions to be matched independently
+  const auto& cacheITS = mITSSectIndexCache[sec]; // array of cached ITS track indices for this sector
+  const auto& cacheTPC = mTPCSectIndexCache[sec]; // array of cached ITS track indices for this sector
+  const auto& timeStartTPC = mTPCTimeStart[sec];  // array of 1st TPC track with timeMax in ITS ROFrame
   int nTracksTPC = cacheTPC.size(), nTracksITS = cacheITS.size();
   if (!nTracksTPC || !nTracksITS) {
     LOG(INFO) << "Matchng sector " << sec << " : N tracks TPC:" << nTracksTPC << " ITS:" << nTracksITS << " in sector " << sec;
     return;
   }
-
-  /// full drift time + safety margin
-  float maxTDriftSafe = tpcTimeBin2MUS(mNTPCBinsFullDrift + mParams->safeMarginTPCITSTimeBin + mTPCTimeEdgeTSafeMargin);
-  float vdErrT = tpcTimeBin2MUS(mZ2TPCBin * mParams->maxVDriftUncertainty);
-
   // get min ROFrame of ITS tracks currently in cache
   auto minROFITS = mITSWork[cacheITS.front()].roFrame;
 
@@ -879,14 +957,32 @@ void MatchTPCITS::doMatching(int sec)
     LOG(INFO) << "ITS min ROFrame " << minROFITS << " exceeds all cached TPC track ROF eqiuvalent " << cacheTPC.size() - 1;
     return;
   }
+  int idxMinTPC = timeStartTPC[minROFITS]; // index of 1st cached TPC track within cached ITS ROFrames
+  // few partitions per thread for load balancing
+  int nPerPart = std::max(MinTPCTracksPerPartition, (nTracksTPC - idxMinTPC) / (4 * mNThreads) + 1);
+  for (int first = idxMinTPC; first < nTracksTPC; first += nPerPart) {
+    partitions.emplace_back(sec, first, std::min(first + nPerPart, nTracksTPC));
+  }
+}
+
+//_____________________________________________________
+void MatchTPCITS::doMatching(MatchingPartition& part)
+{
+  ///< run matching for the partition of cached TPC tracks of the sector, accepted pairs are stored in the partition
+  const auto& cacheITS = mITSSectIndexCache[part.sector]; // array of cached ITS track indices for this sector
+  const auto& cacheTPC = mTPCSectIndexCache[part.sector]; // array of cached ITS track indices for this sector
+  const auto& timeStartITS = mITSTimeStart[part.sector];
+  int nTracksITS = cacheITS.size();
+
+  /// full drift time + safety margin
+  float maxTDriftSafe = tpcTimeBin2MUS(mNTPCBinsFullDrift + mParams->safeMarginTPCITSTimeBin + mTPCTimeEdgeTSafeMargin);
+  float vdErrT = tpcTimeBin2MUS(mZ2TPCBin * mParams->maxVDriftUncertainty);
 
-  int nCheckTPCControl = 0, nCheckITSControl = 0, nMatchesControl = 0; // temporary
-  int idxMinTPC = timeStartTPC[minROFITS];                             // index of 1st cached TPC track within cached ITS ROFrames
   auto t2nbs = tpcTimeBin2MUS(mZ2TPCBin * mParams->tpcTimeICMatchingNSigma); // FIXME work directly with time in \mus
   bool checkInteractionCandidates = mUseFT0 && mParams->validateMatchByFIT != MatchTPCITSParams::Disable;
 
   int itsROBin = 0;
-  for (int itpc = idxMinTPC; itpc < nTracksTPC; itpc++) {
+  for (int itpc = part.firstTPC; itpc < part.lastTPC; itpc++) {
     auto& trefTPC = mTPCWork[cacheTPC[itpc]];
     // estimate ITS 1st ROframe bin this track may match to: TPC track are sorted according to their
     // timeMax, hence the timeMax - MaxmNTPCBinsFullDrift are non-decreasing
@@ -897,7 +993,7 @@ void MatchTPCITS::doMatching(int sec)
       break;
     }
     int iits0 = timeStartITS[itsROBin];
-    nCheckTPCControl++;
+    part.nCheckTPC++;
     for (auto iits = iits0; iits < nTracksITS; iits++) {
       auto& trefITS = mITSWork[cacheITS[iits]];
       // compare if the ITS and TPC tracks may overlap in time
@@ -920,7 +1016,7 @@ void MatchTPCITS::doMatching(int sec)
         continue;
       }
 
-      nCheckITSControl++;
+      part.nCheckITS++;
       float chi2 = -1;
       int rejFlag = compareTPCITSTracks(trefITS, trefTPC, chi2);
 
@@ -983,14 +1079,31 @@ void MatchTPCITS::doMatching(int sec)
           continue;
         }
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
-      nMatchesControl++;
+      part.candidates.emplace_back(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC);
     }
   }
+}
 
-  LOG(INFO) << "Match sector " << sec << " N tracks TPC:" << nTracksTPC << " ITS:" << nTracksITS
-            << " N TPC tracks checked: " << nCheckTPCControl << " (starting from " << idxMinTPC
-            << "), checks: " << nCheckITSControl << ", matches:" << nMatchesControl;
+//_____________________________________________________
+void MatchTPCITS::registerMatchCandidates(const std::vector<MatchingPartition>& partitions)
+{
+  ///< register matching candidates of all partitions, making sure that number of ITS candidates per TPC track, sorted
+  ///< in matching chi2 does not exceed allowed number
+  int nCheckTPC = 0, nCheckITS = 0, nMatches = 0, nPart = partitions.size();
+  for (int ip = 0; ip < nPart; ip++) {
+    const auto& part = partitions[ip];
+    for (const auto& cand : part.candidates) {
+      registerMatchRecordTPC(cand.itsID, cand.tpcID, cand.chi2, cand.matchedIC);
+    }
+    nCheckTPC += part.nCheckTPC;
+    nCheckITS += part.nCheckITS;
+    nMatches += part.candidates.size();
+    if (ip == nPart - 1 || partitions[ip + 1].sector != part.sector) {
+      LOG(INFO) << "Match sector " << part.sector << " N tracks TPC:" << mTPCSectIndexCache[part.sector].size() << " ITS:" << mITSSectIndexCache[part.sector].size()
+                << " N TPC tracks checked: " << nCheckTPC << ", checks: " << nCheckITS << ", matches:" << nMatches;
+      nCheckTPC = nCheckITS = nMatches = 0;
+    }
+  }
 }
 
 //______________________________________________
@@ -2443,6 +2556,17 @@ void MatchTPCITS::refitABTrack(int ibest) const
   }
 }
 
+//______________________________________________
+void MatchTPCITS::setNThreads(int n)
+{
+  // debug trees are filled from the matching loop, so they need sequential processing
+#if defined(WITH_OPENMP) && !defined(_ALLOW_DEBUG_TREES_)
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
 //______________________________________________
 void MatchTPCITS::setITSROFrameLengthMUS(float fums)
 {
@@ -2485,7 +2609,7 @@ void MatchTPCITS::setBunchFilling(const o2::BunchFilling& bf)
 }
 
 //___________________________________________________________________
-MatchTPCITS::BracketIR MatchTPCITS::tBracket2IRBracket(const BracketF tbrange)
+MatchTPCITS::BracketIR MatchTPCITS::tBracket2IRBracket(const BracketF tbrange) const
 {
   // convert time bracket to IR bracket
   o2::InteractionRecord irMin(mStartIR), irMax(mStartIR);
@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MatchTOF class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "GlobalTracking/MatchTOF.h"
+#include "DataFormatsGlobalTracking/RecoContainer.h"
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "Field/MagneticField.h"
+#include <TGeoGlobalMagField.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace globaltracking
+{
+using trkType = o2::dataformats::MatchInfoTOFReco::TrackType;
+using Geo = o2::tof::Geo;
+using GTrackID = o2::dataformats::GlobalTrackID;
+
+// run the matching of the same input with given number of threads
+std::vector<o2::dataformats::MatchInfoTOF> runMatchTOF(const RecoContainer& recoData, int nThreads)
+{
+  MatchTOF matcher;
+  matcher.setNThreads(nThreads);
+  matcher.run(recoData);
+  return matcher.getMatchedTrackVector(trkType::CONSTR);
+}
+
+BOOST_AUTO_TEST_CASE(MatchTOFThreads)
+{
+  // uniform field and an empty geometry, i.e. no material on the track path. The material is queried from a LUT,
+  // without it the matching falls back to a single thread, since the TGeo navigation is not thread-safe
+  auto fld = o2::field::MagneticField::createFieldMap(-30000., 0., 0, kTRUE);
+  TGeoGlobalMagField::Instance()->SetField(fld);
+  TGeoGlobalMagField::Instance()->Lock();
+  auto geom = new TGeoManager("MatchTOFTest", "empty geometry");
+  auto medVac = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0., 0., 0.));
+  geom->SetTopVolume(geom->MakeBox("TOP", medVac, 500., 500., 500.));
+  geom->CloseGeometry();
+  o2::base::MatLayerCylSet lut;
+  lut.addLayer(40., 450., 450., 50., 50.);
+  lut.populateFromTGeo(2);
+  lut.optimizePhiSlices();
+  lut.flatten();
+  auto prop = o2::base::Propagator::Instance();
+  prop->setMatLUT(&lut);
+
+  // ITS-TPC tracks at the TPC outer reference X, each producing a TOF cluster in the pad it crosses,
+  // and noise clusters in random pads. The tracks and clusters of a few collisions are close in time,
+  // so that the tracks have several candidates
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  std::array<float, o2::track::kCovMatSize> cov = {1e-2, 0., 1e-2, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  std::vector<o2::dataformats::TrackTPCITS> tracks;
+  std::vector<o2::tof::Cluster> clusters;
+  const float trkTimeErr = 0.01; // in \mus
+  for (int icoll = 0; icoll < 50; icoll++) {
+    float tColl = 100. * rnd(gen); // in \mus
+    for (int it = 0; it < 50; it++) {
+      std::array<float, o2::track::kNParams> par = {10.f * (rnd(gen) - 0.5f), 150.f * (rnd(gen) - 0.5f), 0.2f * (rnd(gen) - 0.5f), 0.6f * (rnd(gen) - 0.5f), 2.f * (rnd(gen) - 0.5f)};
+      o2::track::TrackParCov trc(o2::constants::geom::XTPCOuterRef, 2.f * float(M_PI) * (rnd(gen) - 0.5f), par, cov);
+      auto& trcITSTPC = tracks.emplace_back(trc, trc);
+      trcITSTPC.setTimeMUS(tColl, trkTimeErr);
+      trcITSTPC.setRefTPC({unsigned(tracks.size() - 1), GTrackID::TPC});
+      trcITSTPC.setRefITS({unsigned(tracks.size() - 1), GTrackID::ITS});
+      // find the pad crossed by the track
+      int det[5] = {-1, -1, -1, -1, -1};
+      float dpos[3];
+      for (float x = Geo::RMIN; x < Geo::RMAX && prop->propagateToX(trc, x, prop->getNominalBz(), 0.85, 1., o2::base::Propagator::MatCorrType::USEMatCorrNONE); x += 1.) {
+        std::array<float, 3> pos;
+        trc.getXYZGlo(pos);
+        Geo::getPadDxDyDz(pos.data(), det, dpos);
+        if (det[2] != -1) {
+          break;
+        }
+      }
+      if (det[2] == -1) {
+        continue;
+      }
+      int ch = Geo::getIndex(det);
+      auto& cl = clusters.emplace_back(ch % Geo::NPADSXSECTOR, 0., 0., 0., 0., 0., 0., 0., tColl * 1e6 + 50. * gaus(gen), 10., 0, 0);
+      cl.setSector(ch / Geo::NPADSXSECTOR);
+    }
+  }
+  for (int inoise = 0; inoise < 2000; inoise++) {
+    int ch = std::uniform_int_distribution<int>(0, Geo::NPADSXSECTOR * Geo::NSECTORS - 1)(gen);
+    auto& cl = clusters.emplace_back(ch % Geo::NPADSXSECTOR, 0., 0., 0., 0., 0., 0., 0., 1e8 * rnd(gen), 10., 0, 0);
+    cl.setSector(ch / Geo::NPADSXSECTOR);
+  }
+
+  RecoContainer recoData;
+  recoData.commonPool[GTrackID::ITSTPC].registerContainer(tracks, RecoContainer::TRACKS);
+  recoData.commonPool[GTrackID::TOF].registerContainer(clusters, RecoContainer::CLUSTERS);
+
+  // the sectors matched concurrently must give the same matches as the sequential processing
+  auto ref = runMatchTOF(recoData, 1);
+  BOOST_CHECK(ref.size() > 0);
+  for (int nThreads : {2, 4}) {
+    auto out = runMatchTOF(recoData, nThreads);
+    BOOST_REQUIRE(out.size() == ref.size());
+    for (size_t im = 0; im < ref.size(); im++) {
+      BOOST_CHECK(out[im].getTOFClIndex() == ref[im].getTOFClIndex());
+      BOOST_CHECK(out[im].getEvIdxTrack().getIndex() == ref[im].getEvIdxTrack().getIndex());
+      BOOST_CHECK(out[im].getChi2() == ref[im].getChi2());
+      BOOST_CHECK(out[im].getLTIntegralOut().getL() == ref[im].getLTIntegralOut().getL());
+    }
+  }
+  prop->setMatLUT(nullptr);
+}
+
+} // namespace globaltracking
+} // namespace o2
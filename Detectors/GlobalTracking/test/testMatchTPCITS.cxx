@@ -0,0 +1,156 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MatchTPCITS class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "GlobalTracking/MatchTPCITS.h"
+#include "DetectorsBase/Propagator.h"
+#include "Field/MagneticField.h"
+#include "MathUtils/Utils.h"
+#include <TGeoGlobalMagField.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace globaltracking
+{
+constexpr int ITSROFLengthInBC = 198;
+
+struct MatchResult {
+  std::vector<MatchRecord> recordsTPC, recordsITS;
+  std::vector<int> firstRecordTPC, firstRecordITS; // 1st match record of every TPC and ITS work track
+  std::vector<int> winners;                        // ITS work track validated for every TPC work track, -1 if none
+};
+
+// run the matching of the same input with given number of threads
+MatchResult runMatchTPCITS(const std::vector<o2::track::TrackParCov>& itsTracks, const std::vector<o2::itsmft::ROFRecord>& itsROFs,
+                           const std::vector<o2::track::TrackParCov>& tpcTracks, const std::vector<o2::math_utils::Bracketf_t>& tpcTimes,
+                           const o2::BunchFilling& bf, bool triggered, int nThreads)
+{
+  MatchTPCITS matcher;
+  matcher.setNThreads(nThreads);
+  matcher.setITSTriggered(triggered);
+  matcher.setITSROFrameLengthInBC(ITSROFLengthInBC);
+  matcher.setBunchFilling(bf);
+  matcher.runMatchingOnly(itsTracks, itsROFs, tpcTracks, tpcTimes);
+
+  MatchResult res;
+  res.recordsTPC = matcher.getMatchRecordsTPC();
+  res.recordsITS = matcher.getMatchRecordsITS();
+  for (const auto& trc : matcher.getITSWork()) {
+    res.firstRecordITS.push_back(trc.matchID);
+  }
+  for (const auto& trc : matcher.getTPCWork()) {
+    res.firstRecordTPC.push_back(trc.matchID);
+    bool validated = trc.matchID > MinusOne && res.recordsTPC[trc.matchID].nextRecID == Validated;
+    res.winners.push_back(validated ? res.recordsTPC[trc.matchID].partnerID : MinusOne);
+  }
+  return res;
+}
+
+void compareRecords(const std::vector<MatchRecord>& out, const std::vector<MatchRecord>& ref)
+{
+  BOOST_REQUIRE(out.size() == ref.size());
+  for (size_t i = 0; i < ref.size(); i++) {
+    BOOST_CHECK(out[i].partnerID == ref[i].partnerID);
+    BOOST_CHECK(out[i].nextRecID == ref[i].nextRecID);
+    BOOST_CHECK(out[i].matchedIC == ref[i].matchedIC);
+    BOOST_CHECK(out[i].chi2 == ref[i].chi2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MatchTPCITSThreads)
+{
+  // uniform field for the propagation of the ITS tracks close to the sector edge to the neighbouring sector
+  auto fld = o2::field::MagneticField::createFieldMap(-30000., 0., 0, kTRUE);
+  TGeoGlobalMagField::Instance()->SetField(fld);
+  TGeoGlobalMagField::Instance()->Lock();
+  auto geom = new TGeoManager("MatchTPCITSTest", "empty geometry");
+  auto medVac = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0., 0., 0.));
+  geom->SetTopVolume(geom->MakeBox("TOP", medVac, 500., 500., 500.));
+  geom->CloseGeometry();
+  o2::base::Propagator::Instance();
+
+  o2::BunchFilling bf;
+  for (int bc = 0; bc < o2::constants::lhc::LHCMaxBunches; bc++) {
+    bf.setBC(bc);
+  }
+
+  // ITS tracks of few collisions per ROF at the matching reference X and their TPC counterparts with larger errors,
+  // with some ITS tracks left w/o TPC partner. Most of the tracks are in the same sector, so that its TPC tracks
+  // are split to several partitions, the other tracks cover the full azimuth, including the sector edges
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  std::array<float, o2::track::kCovMatSize> covITS = {1e-3, 0., 1e-3, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  std::array<float, o2::track::kCovMatSize> covTPC = {4e-2, 0., 4e-2, 0., 0., 1e-4, 0., 0., 0., 1e-4, 0., 0., 0., 0., 1e-2};
+  const int diagIdx[o2::track::kNParams] = {0, 2, 5, 9, 14};
+  const int crowdedSector = 5;
+  std::vector<o2::track::TrackParCov> itsTracks, tpcTracks;
+  std::vector<o2::itsmft::ROFRecord> itsROFs;
+  std::vector<o2::math_utils::Bracketf_t> tpcTimes;
+  int nTPCCrowded = 0;
+  for (int irof = 0; irof < 20; irof++) {
+    auto& rof = itsROFs.emplace_back(o2::InteractionRecord{0, 0}, irof, itsTracks.size(), 0);
+    rof.getBCData().setFromLong(int64_t(irof) * ITSROFLengthInBC);
+    for (int icoll = 0; icoll < 3; icoll++) {
+      float tColl = (irof * ITSROFLengthInBC + int(ITSROFLengthInBC * rnd(gen))) * o2::constants::lhc::LHCBunchSpacingMUS;
+      float zColl = 5.f * gaus(gen);
+      for (int it = 0; it < 30; it++) {
+        int sec = rnd(gen) < 0.6f ? crowdedSector : int(o2::constants::math::NSectors * rnd(gen)) % o2::constants::math::NSectors;
+        std::array<float, o2::track::kNParams> par = {1.99f * MatchTPCITS::YMaxAtXMatchingRef * (rnd(gen) - 0.5f), zColl + 60.f * (rnd(gen) - 0.5f),
+                                                      0.4f * (rnd(gen) - 0.5f), 1.6f * (rnd(gen) - 0.5f), 4.f * (rnd(gen) - 0.5f)};
+        itsTracks.emplace_back(MatchTPCITS::XMatchingRef, o2::math_utils::sector2Angle(sec), par, covITS);
+        if (rnd(gen) < 0.1f) {
+          continue;
+        }
+        for (int ip = 0; ip < o2::track::kNParams; ip++) {
+          par[ip] += std::sqrt(covTPC[diagIdx[ip]]) * gaus(gen);
+        }
+        tpcTracks.emplace_back(MatchTPCITS::XMatchingRef, o2::math_utils::sector2Angle(sec), par, covTPC);
+        tpcTimes.emplace_back(tColl - 3.f, tColl + 3.f);
+        nTPCCrowded += sec == crowdedSector;
+      }
+    }
+    rof.setNEntries(itsTracks.size() - rof.getFirstEntry());
+  }
+
+  BOOST_CHECK(nTPCCrowded > 2 * MatchTPCITS::MinTPCTracksPerPartition); // split to several partitions even with 1 thread
+
+  // the TPC tracks of the sectors matched concurrently in partitions must give the same match records and
+  // winners as the sequential processing, both for continuous and triggered ITS readout
+  for (bool triggered : {false, true}) {
+    auto ref = runMatchTPCITS(itsTracks, itsROFs, tpcTracks, tpcTimes, bf, triggered, 1);
+    int nWinners = 0;
+    for (auto w : ref.winners) {
+      nWinners += w != MinusOne;
+    }
+    BOOST_CHECK(nWinners > 0);
+    for (int nThreads : {2, 4}) {
+      auto out = runMatchTPCITS(itsTracks, itsROFs, tpcTracks, tpcTimes, bf, triggered, nThreads);
+      compareRecords(out.recordsTPC, ref.recordsTPC);
+      compareRecords(out.recordsITS, ref.recordsITS);
+      BOOST_CHECK(out.firstRecordTPC == ref.firstRecordTPC);
+      BOOST_CHECK(out.firstRecordITS == ref.firstRecordITS);
+      BOOST_CHECK(out.winners == ref.winners);
+    }
+  }
+}
+
+} // namespace globaltracking
+} // namespace o2
@@ -94,6 +94,7 @@ void TOFMatcherSpec::init(InitContext& ic)
   if (mSetHighPurity) {
     mMatcher.setHighPurity();
   }
+  mMatcher.setNThreads(ic.options().get<int>("threads"));
 }
 
 void TOFMatcherSpec::run(ProcessingContext& pc)
@@ -182,7 +183,8 @@ DataProcessorSpec getTOFMatcherSpec(GTrackID::mask_t src, bool useMC, bool useFI
     outputs,
     AlgorithmSpec{adaptFromTask<TOFMatcherSpec>(dataRequest, useMC, useFIT, tpcRefit, highpur)},
     Options{
-      {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}}}};
+      {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}},
+      {"threads", VariantType::Int, 1, {"Number of threads for the per-sector matching"}}}};
 }
 
 } // namespace globaltracking
@@ -34,6 +34,36 @@ namespace o2
 namespace its
 {
 
+/// SoA copy of the clusters of a layer, in the order of the index table, for the vectorized doublet selection
+struct ClustersSoA {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> phi;
+  std::vector<float> r;
+  std::vector<int> clusterId;
+
+  int size() const { return z.size(); }
+  void resize(int n)
+  {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    phi.resize(n);
+    r.resize(n);
+    clusterId.resize(n);
+  }
+  void set(int i, const Cluster& c)
+  {
+    x[i] = c.xCoordinate;
+    y[i] = c.yCoordinate;
+    z[i] = c.zCoordinate;
+    phi[i] = c.phiCoordinate;
+    r[i] = c.rCoordinate;
+    clusterId[i] = c.clusterId;
+  }
+};
+
 class PrimaryVertexContext
 {
  public:
@@ -48,6 +78,7 @@ class PrimaryVertexContext
                           const std::vector<std::vector<Cluster>>& cl, const std::array<float, 3>& pv, const int iteration);
   const float3& getPrimaryVertex() const { return mPrimaryVertex; }
   auto& getClusters() { return mClusters; }
+  const auto& getClustersSoA() const { return mClustersSoA; }
   auto& getCells() { return mCells; }
   auto& getCellsLookupTable() { return mCellsLookupTable; }
   auto& getCellsNeighbours() { return mCellsNeighbours; }
@@ -59,7 +90,8 @@ class PrimaryVertexContext
   bool isClusterUsed(int layer, int clusterId) const { return mUsedClusters[layer][clusterId]; }
   void markUsedCluster(int layer, int clusterId);
 
-  auto& getIndexTables() { return mIndexTables; }
+  /// CSR-like index table of layer+1 clusters: the clusters of bin b are [table[b], table[b+1])
+  const int* getIndexTable(int layer) const { return mIndexTables.data() + layer * mIndexTableStride; }
   auto& getTracklets() { return mTracklets; }
   auto& getTrackletsLookupTable() { return mTrackletsLookupTable; }
 
@@ -75,15 +107,16 @@ class PrimaryVertexContext
   std::vector<float> mMinR;
   std::vector<float> mMaxR;
   std::vector<std::vector<Cluster>> mClusters;
+  std::vector<ClustersSoA> mClustersSoA;
   std::vector<std::vector<bool>> mUsedClusters;
   std::vector<std::vector<Cell>> mCells;
   std::vector<std::vector<int>> mCellsLookupTable;
   std::vector<std::vector<std::vector<int>>> mCellsNeighbours;
   std::vector<Road> mRoads;
 
-  // std::array<std::array<int, constants::index_table::ZBins * constants::index_table::PhiBins + 1>,
-  //            constants::its::TrackletsPerRoad>
-  std::vector<std::vector<int>> mIndexTables;
+  // index tables of all layers, contiguous, mIndexTableStride = ZBins * PhiBins + 1 entries per layer
+  std::vector<int> mIndexTables;
+  int mIndexTableStride = 0;
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<int>> mTrackletsLookupTable;
 
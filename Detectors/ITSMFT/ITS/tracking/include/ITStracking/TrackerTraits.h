@@ -65,9 +65,13 @@ class TrackerTraits
   void UpdateTrackingParameters(const TrackingParameters& trkPar);
   PrimaryVertexContext* getPrimaryVertexContext() { return mPrimaryVertexContext; }
 
+  virtual void setNThreads(int) {}
+  int getNThreads() const { return mNThreads; }
+
  protected:
   PrimaryVertexContext* mPrimaryVertexContext;
   TrackingParameters mTrkParams;
+  int mNThreads = 1;
 
   o2::gpu::GPUChainITS* mChain = nullptr;
   FuncRunITSTrackFit_t mChainRunITSTrackFit;
@@ -47,7 +47,13 @@ class TrackerTraitsCPU : public TrackerTraits
   void computeLayerTracklets() final;
   void refitTracks(const std::vector<std::vector<TrackingFrameInfo>>& tf, std::vector<TrackITSExt>& tracks) final;
 
+  /// layers are processed concurrently, each split in chunks of clusters (tracklets) merged in the original order
+  void setNThreads(int n) final;
+
  protected:
+  void computeTrackletsInRange(int iLayer, int firstCluster, int lastCluster, std::vector<Tracklet>& tracklets);
+  void computeCellsInRange(int iLayer, int firstTracklet, int lastTracklet, std::vector<Cell>& cells);
+
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<Cell>> mCells;
 };
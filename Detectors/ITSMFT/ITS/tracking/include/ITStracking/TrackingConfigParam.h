@@ -40,6 +40,8 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
 
   // Use TGeo for mat. budget
   bool useMatCorrTGeo = false;
+  // Number of threads for the CA tracking on CPU
+  int nThreads = 1;
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
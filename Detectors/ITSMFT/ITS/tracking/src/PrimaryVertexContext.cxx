@@ -42,11 +42,14 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
     mMinR.resize(trkParam.NLayers, 10000.);
     mMaxR.resize(trkParam.NLayers, -1.);
     mClusters.resize(trkParam.NLayers);
+    mClustersSoA.resize(trkParam.NLayers);
     mUsedClusters.resize(trkParam.NLayers);
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
     mCellsNeighbours.resize(trkParam.CellsPerRoad() - 1);
-    mIndexTables.resize(trkParam.TrackletsPerRoad(), std::vector<int>(trkParam.ZBins * trkParam.PhiBins + 1, 0));
+    mIndexTableStride = trkParam.ZBins * trkParam.PhiBins + 1;
+    mIndexTables.clear();
+    mIndexTables.resize(trkParam.TrackletsPerRoad() * mIndexTableStride, 0);
     mTracklets.resize(trkParam.TrackletsPerRoad());
     mTrackletsLookupTable.resize(trkParam.CellsPerRoad());
     mIndexTableUtils.setTrackingParameters(trkParam);
@@ -59,6 +62,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
 
       mClusters[iLayer].clear();
       mClusters[iLayer].resize(clustersNum);
+      mClustersSoA[iLayer].resize(clustersNum);
       mUsedClusters[iLayer].clear();
       mUsedClusters[iLayer].resize(clustersNum, false);
 
@@ -100,14 +104,16 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
         c.phiCoordinate = h.phi;
         c.rCoordinate = h.r;
         c.indexTableBinIndex = h.bin;
+        mClustersSoA[iLayer].set(lutPerBin[h.bin] + h.ind, c);
       }
 
       if (iLayer > 0) {
+        int* indexTable = mIndexTables.data() + (iLayer - 1) * mIndexTableStride;
         for (unsigned int iB{0}; iB < clsPerBin.size(); ++iB) {
-          mIndexTables[iLayer - 1][iB] = lutPerBin[iB];
+          indexTable[iB] = lutPerBin[iB];
         }
-        for (auto iB{clsPerBin.size()}; iB < mIndexTables[iLayer - 1].size(); iB++) {
-          mIndexTables[iLayer - 1][iB] = clustersNum;
+        for (int iB{static_cast<int>(clsPerBin.size())}; iB < mIndexTableStride; iB++) {
+          indexTable[iB] = clustersNum;
         }
       }
     }
@@ -243,7 +243,19 @@ void Tracker::findTracks(const ROframe& event)
   std::vector<int> nonsharingCounters(mTrkParams[0].NLayers - 3, 0);
 #endif
 
-  for (auto& road : mPrimaryVertexContext->getRoads()) {
+  // roads are fitted independently, the fitted candidates are collected in the order of the roads;
+  // the fit is sequential unless the material is ignored or taken from the LUT: the TGeo navigation, also used
+  // as a fallback for the LUT corrections when no LUT is loaded, is not thread safe
+  auto& roads = mPrimaryVertexContext->getRoads();
+  const int nRoads = roads.size();
+  std::vector<TrackITSExt> candidates(nRoads);
+  std::vector<uint8_t> fitted(nRoads, 0); // not vector<bool>, the flags are set concurrently
+  const int nThreads = (mCorrType == o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE || isMatLUT()) ? mTraits->getNThreads() : 1;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int iRoad = 0; iRoad < nRoads; iRoad++) {
+    auto& road = roads[iRoad];
     std::vector<int> clusters(mTrkParams[0].NLayers, constants::its::UnusedIndex);
     int lastCellLevel = constants::its::UnusedIndex;
     CA_DEBUGGER(int nClusters = 2);
@@ -311,9 +323,15 @@ void Tracker::findTracks(const ROframe& event)
       continue;
     }
     CA_DEBUGGER(refitCounters[nClusters - 4]++);
-    tracks.emplace_back(temporaryTrack);
+    candidates[iRoad] = temporaryTrack;
+    fitted[iRoad] = 1;
     CA_DEBUGGER(assert(nClusters == temporaryTrack.getNumberOfClusters()));
   }
+  for (int iRoad = 0; iRoad < nRoads; iRoad++) {
+    if (fitted[iRoad]) {
+      tracks.emplace_back(candidates[iRoad]);
+    }
+  }
   //mTraits->refitTracks(event.getTrackingFrameInfo(), tracks);
 
   std::sort(tracks.begin(), tracks.end(),
@@ -651,6 +669,7 @@ void Tracker::getGlobalConfiguration()
   if (tc.useMatCorrTGeo) {
     setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrTGeo);
   }
+  mTraits->setNThreads(tc.nThreads);
 }
 
 } // namespace its
@@ -22,6 +22,7 @@
 #include "ITStracking/Tracklet.h"
 #include <fmt/format.h>
 #include "ReconstructionDataFormats/Track.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -32,226 +33,332 @@ namespace o2
 namespace its
 {
 
+namespace
+{
+/// range of clusters (tracklets) of a layer processed as a single task; apart from the 1st chunk of the layer,
+/// which is filled directly in the PrimaryVertexContext, the output is buffered and appended in the original order
+template <typename T>
+struct LayerChunk {
+  int layer = 0;
+  int first = 0;
+  int last = 0;
+  std::vector<T> buffer;
+};
+
+constexpr int ChunksPerThread = 4; // split layers in more chunks than threads, for the load balancing
+constexpr int MinChunkSize = 100;  // do not create tasks smaller than this
+
+template <typename T>
+void addLayerChunks(int layer, int nEntries, int nThreads, std::vector<LayerChunk<T>>& chunks)
+{
+  const int nChunks = nThreads > 1 ? nThreads * ChunksPerThread : 1;
+  const int chunkSize = std::max(MinChunkSize, (nEntries + nChunks - 1) / nChunks);
+  for (int first = 0; first < nEntries; first += chunkSize) {
+    chunks.push_back({layer, first, std::min(first + chunkSize, nEntries), {}});
+  }
+}
+
+/// convert the lookup table entries filled by the chunk from the chunk buffer to the merged layer indices
+void shiftLookupTable(std::vector<int>& lut, int first, int last, int offset)
+{
+  for (int i = first; i < last; i++) {
+    if (lut[i] != constants::its::UnusedIndex) {
+      lut[i] += offset;
+    }
+  }
+}
+} // namespace
+
 void TrackerTraitsCPU::computeLayerTracklets()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  std::vector<LayerChunk<Tracklet>> chunks;
   for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
     if (primaryVertexContext->getClusters()[iLayer].empty() || primaryVertexContext->getClusters()[iLayer + 1].empty()) {
       continue;
     }
+    addLayerChunks(iLayer, primaryVertexContext->getClusters()[iLayer].size(), mNThreads, chunks);
+  }
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer].size())};
-
-    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-      const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iChunk = 0; iChunk < (int)chunks.size(); iChunk++) {
+    auto& chunk = chunks[iChunk];
+    auto& tracklets = chunk.first ? chunk.buffer : primaryVertexContext->getTracklets()[chunk.layer];
+    computeTrackletsInRange(chunk.layer, chunk.first, chunk.last, tracklets);
+  }
 
-      if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
-        continue;
+  for (auto& chunk : chunks) {
+    const int iLayer = chunk.layer;
+    if (chunk.first) {
+      auto& tracklets = primaryVertexContext->getTracklets()[iLayer];
+      if (iLayer > 0) {
+        shiftLookupTable(primaryVertexContext->getTrackletsLookupTable()[iLayer - 1], chunk.first, chunk.last, tracklets.size());
       }
+      tracklets.insert(tracklets.end(), chunk.buffer.begin(), chunk.buffer.end());
+    }
+    if (chunk.last < (int)primaryVertexContext->getClusters()[iLayer].size()) {
+      continue; // check the memory once the layer is complete
+    }
+    if (iLayer > 0 && iLayer < mTrkParams.TrackletsPerRoad() - 1 &&
+        primaryVertexContext->getTracklets()[iLayer].size() > primaryVertexContext->getCellsLookupTable()[iLayer - 1].size()) {
+      throw std::runtime_error(fmt::format("not enough memory in the CellsLookupTable, increase the tracklet memory coefficients: {} tracklets on L{}, lookup table size {} on L{}",
+                                           primaryVertexContext->getTracklets()[iLayer].size(), iLayer, primaryVertexContext->getCellsLookupTable()[iLayer - 1].size(), iLayer - 1));
+    }
+  }
+#ifdef CA_DEBUG
+  std::cout << "+++ Number of tracklets per layer: ";
+  for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
+    std::cout << primaryVertexContext->getTracklets()[iLayer].size() << "\t";
+  }
+  std::cout << std::endl;
+#endif
+}
+
+void TrackerTraitsCPU::computeTrackletsInRange(int iLayer, int firstCluster, int lastCluster, std::vector<Tracklet>& tracklets)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const ClustersSoA& nextLayer = primaryVertexContext->getClustersSoA()[iLayer + 1];
+  const int* indexTable = primaryVertexContext->getIndexTable(iLayer);
+  const int nextLayerClustersNum = nextLayer.size();
+  const float maxDeltaZ = mTrkParams.TrackletMaxDeltaZ[iLayer];
+  const float maxDeltaPhi = mTrkParams.TrackletMaxDeltaPhi;
+  std::vector<uint8_t> selected;
+
+  for (int iCluster{firstCluster}; iCluster < lastCluster; ++iCluster) {
+    const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
+
+    if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
+      continue;
+    }
 
-      const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
-      const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
-      const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
+    const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
+    const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
+                                     currentCluster.rCoordinate) +
+                        currentCluster.zCoordinate};
+    const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
+                                     currentCluster.rCoordinate) +
+                        currentCluster.zCoordinate};
 
-      const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                              mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
+    const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax, maxDeltaZ, maxDeltaPhi)};
 
-      if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-        continue;
-      }
+    if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+      continue;
+    }
+
+    int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-      int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+    if (phiBinsNum < 0) {
+      phiBinsNum += mTrkParams.PhiBins;
+    }
 
-      if (phiBinsNum < 0) {
-        phiBinsNum += mTrkParams.PhiBins;
+    const float currentR = currentCluster.rCoordinate;
+    const float currentZ = currentCluster.zCoordinate;
+    const float currentPhi = currentCluster.phiCoordinate;
+
+    for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
+         iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
+      const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+      const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+      const int firstRowClusterIndex = indexTable[firstBinIndex];
+      const int maxRowClusterIndex = std::min(indexTable[maxBinIndex], nextLayerClustersNum);
+      const int nCandidates = maxRowClusterIndex - firstRowClusterIndex;
+      if (nCandidates <= 0) {
+        continue;
       }
 
-      for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
-           iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
-        const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-        const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-        const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
-        const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
+      // branchless geometric selection over the contiguous z-row of the phi bin, vectorizable
+      selected.resize(nCandidates);
+      const float* nextR = nextLayer.r.data() + firstRowClusterIndex;
+      const float* nextZ = nextLayer.z.data() + firstRowClusterIndex;
+      const float* nextPhi = nextLayer.phi.data() + firstRowClusterIndex;
+      for (int iCand = 0; iCand < nCandidates; iCand++) {
+        const float deltaZ{std::abs(tanLambda * (nextR[iCand] - currentR) + currentZ - nextZ[iCand])};
+        const float deltaPhi{std::abs(currentPhi - nextPhi[iCand])};
+        selected[iCand] = (deltaZ < maxDeltaZ) & ((deltaPhi < maxDeltaPhi) | (std::abs(deltaPhi - constants::math::TwoPi) < maxDeltaPhi));
+      }
 
-        for (int iNextLayerCluster{firstRowClusterIndex}; iNextLayerCluster < maxRowClusterIndex;
-             ++iNextLayerCluster) {
+      for (int iCand = 0; iCand < nCandidates; iCand++) {
+        if (!selected[iCand]) {
+          continue;
+        }
+        const int iNextLayerCluster = firstRowClusterIndex + iCand;
+        if (primaryVertexContext->isClusterUsed(iLayer + 1, nextLayer.clusterId[iNextLayerCluster])) {
+          continue;
+        }
 
-          if (iNextLayerCluster >= (int)primaryVertexContext->getClusters()[iLayer + 1].size()) {
-            break;
-          }
+        if (iLayer > 0 &&
+            primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
 
-          const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
+          primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] = tracklets.size();
+        }
 
-          if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-            continue;
-          }
+        tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster, primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]);
+      }
+    }
+  }
+}
 
-          const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) +
-                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
-          const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
+void TrackerTraitsCPU::computeLayerCells()
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  std::vector<LayerChunk<Cell>> chunks;
+  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
 
-          if (deltaZ < mTrkParams.TrackletMaxDeltaZ[iLayer] &&
-              (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
-               o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
+    if (primaryVertexContext->getTracklets()[iLayer + 1].empty() ||
+        primaryVertexContext->getTracklets()[iLayer].empty()) {
 
-            if (iLayer > 0 &&
-                primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
+      break;
+    }
+    addLayerChunks(iLayer, primaryVertexContext->getTracklets()[iLayer].size(), mNThreads, chunks);
+  }
 
-              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                primaryVertexContext->getTracklets()[iLayer].size();
-            }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iChunk = 0; iChunk < (int)chunks.size(); iChunk++) {
+    auto& chunk = chunks[iChunk];
+    auto& cells = chunk.first ? chunk.buffer : primaryVertexContext->getCells()[chunk.layer];
+    computeCellsInRange(chunk.layer, chunk.first, chunk.last, cells);
+  }
 
-            primaryVertexContext->getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                                                                      nextCluster);
-          }
-        }
+  for (auto& chunk : chunks) {
+    if (chunk.first) {
+      auto& cells = primaryVertexContext->getCells()[chunk.layer];
+      if (chunk.layer > 0) {
+        shiftLookupTable(primaryVertexContext->getCellsLookupTable()[chunk.layer - 1], chunk.first, chunk.last, cells.size());
       }
-    }
-    if (iLayer > 0 && iLayer < mTrkParams.TrackletsPerRoad() - 1 &&
-        primaryVertexContext->getTracklets()[iLayer].size() > primaryVertexContext->getCellsLookupTable()[iLayer - 1].size()) {
-      throw std::runtime_error(fmt::format("not enough memory in the CellsLookupTable, increase the tracklet memory coefficients: {} tracklets on L{}, lookup table size {} on L{}",
-                                           primaryVertexContext->getTracklets()[iLayer].size(), iLayer, primaryVertexContext->getCellsLookupTable()[iLayer - 1].size(), iLayer - 1));
+      cells.insert(cells.end(), chunk.buffer.begin(), chunk.buffer.end());
     }
   }
 #ifdef CA_DEBUG
-  std::cout << "+++ Number of tracklets per layer: ";
-  for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
-    std::cout << primaryVertexContext->getTracklets()[iLayer].size() << "\t";
+  std::cout << "+++ Number of cells per layer: ";
+  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
+    std::cout << primaryVertexContext->getCells()[iLayer].size() << "\t";
   }
   std::cout << std::endl;
 #endif
 }
 
-void TrackerTraitsCPU::computeLayerCells()
+void TrackerTraitsCPU::computeCellsInRange(int iLayer, int firstTracklet, int lastTracklet, std::vector<Cell>& cells)
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
-  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
 
-    if (primaryVertexContext->getTracklets()[iLayer + 1].empty() ||
-        primaryVertexContext->getTracklets()[iLayer].empty()) {
+  for (int iTracklet{firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
 
-      return;
+    const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
+    const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+    const int nextLayerFirstTrackletIndex{
+      primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+
+    if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+
+      continue;
     }
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size())};
+    const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
+    const Cluster& secondCellCluster{
+      primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
+    const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
+    const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
+                                                      secondCellCluster.rCoordinate};
+    const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                  secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                  secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
+    const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
 
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
+         iNextLayerTracklet < nextLayerTrackletsNum &&
+         primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
+           nextLayerClusterIndex;
+         ++iNextLayerTracklet) {
 
-      const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+      const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
+      const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+      const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
 
-      if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+      if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
+          (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
+           std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
 
-        continue;
-      }
+        const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
+        const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
+                                           firstCellCluster.zCoordinate};
+        const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
+
+        if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
+
+          const Cluster& thirdCellCluster{
+            primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
+
+          const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
+                                                           thirdCellCluster.rCoordinate};
+
+          const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                         thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                         thirdCellClusterQuadraticRCoordinate -
+                                           firstCellClusterQuadraticRCoordinate};
+
+          float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
 
-      const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
-      const Cluster& secondCellCluster{
-        primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
-      const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
-      const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
-                                                        secondCellCluster.rCoordinate};
-      const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                    secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                    secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
-      const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
-
-      for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
-           iNextLayerTracklet < nextLayerTrackletsNum &&
-           primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
-             nextLayerClusterIndex;
-           ++iNextLayerTracklet) {
-
-        const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
-        const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
-
-        if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
-            (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
-             std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
-
-          const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
-          const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
-                                             firstCellCluster.zCoordinate};
-          const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
-
-          if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
-
-            const Cluster& thirdCellCluster{
-              primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
-
-            const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
-                                                             thirdCellCluster.rCoordinate};
-
-            const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                           thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                           thirdCellClusterQuadraticRCoordinate -
-                                             firstCellClusterQuadraticRCoordinate};
-
-            float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
-
-            const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
-                                             cellPlaneNormalVector.y * cellPlaneNormalVector.y +
-                                             cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
-
-            if (vectorNorm < constants::math::FloatMinThreshold ||
-                std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
-
-              continue;
-            }
-
-            const float inverseVectorNorm{1.0f / vectorNorm};
-            const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
-                                               cellPlaneNormalVector.y * inverseVectorNorm,
-                                               cellPlaneNormalVector.z * inverseVectorNorm};
-            const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
-                                      (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
-                                      normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
-            const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
-            const float cellTrajectoryRadius{std::sqrt(
-              (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
-              (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
-            const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
-                                      -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
-            const float distanceOfClosestApproach{std::abs(
-              cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
-
-            if (distanceOfClosestApproach >
-                mTrkParams.CellMaxDCA[iLayer]) {
-
-              continue;
-            }
-
-            const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
-            if (iLayer > 0 &&
-                primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] =
-                primaryVertexContext->getCells()[iLayer].size();
-            }
-
-            primaryVertexContext->getCells()[iLayer].emplace_back(
-              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-              iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+          const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
+                                           cellPlaneNormalVector.y * cellPlaneNormalVector.y +
+                                           cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
+
+          if (vectorNorm < constants::math::FloatMinThreshold ||
+              std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
+
+            continue;
+          }
+
+          const float inverseVectorNorm{1.0f / vectorNorm};
+          const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
+                                             cellPlaneNormalVector.y * inverseVectorNorm,
+                                             cellPlaneNormalVector.z * inverseVectorNorm};
+          const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
+                                    (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
+                                    normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
+          const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
+          const float cellTrajectoryRadius{std::sqrt(
+            (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
+            (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
+          const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
+                                    -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
+          const float distanceOfClosestApproach{std::abs(
+            cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
+
+          if (distanceOfClosestApproach >
+              mTrkParams.CellMaxDCA[iLayer]) {
+
+            continue;
           }
+
+          const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
+          if (iLayer > 0 &&
+              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
+
+            primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] = cells.size();
+          }
+
+          cells.emplace_back(
+            currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+            iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
         }
       }
     }
   }
-#ifdef CA_DEBUG
-  std::cout << "+++ Number of cells per layer: ";
-  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
-    std::cout << primaryVertexContext->getCells()[iLayer].size() << "\t";
-  }
-  std::cout << std::endl;
+}
+
+void TrackerTraitsCPU::setNThreads(int n)
+{
+  // the CA debug printouts and trees are filled sequentially
+#if defined(WITH_OPENMP) && !defined(CA_DEBUG)
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
 #endif
 }
 
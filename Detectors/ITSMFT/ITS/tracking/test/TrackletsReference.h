@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   TrackletsReference.h
+/// \brief  Tracklet finding on the AoS clusters, as done before the SoA layout, used as reference by the test and the benchmark
+
+#ifndef O2_ITS_TRACKING_TRACKLETSREFERENCE_H_
+#define O2_ITS_TRACKING_TRACKLETSREFERENCE_H_
+
+#include "ITStracking/TrackerTraitsCPU.h"
+#include "ITStracking/PrimaryVertexContext.h"
+#include "ITStracking/Configuration.h"
+#include "ITStracking/Constants.h"
+#include <cmath>
+#include <vector>
+
+namespace o2
+{
+namespace its
+{
+
+/// sequential tracklet finding of the current PrimaryVertexContext of the traits: for each candidate of the index table rows
+/// the AoS cluster is selected, then checked for being used, the tracklet is created and the lookup table filled.
+/// The output goes to the provided tracklets and lookup tables, the latter must be initialised as in the context
+inline void computeTrackletsReference(TrackerTraitsCPU& traits, const TrackingParameters& par,
+                                      std::vector<std::vector<Tracklet>>& tracklets, std::vector<std::vector<int>>& lookupTables)
+{
+  auto* ctx = traits.getPrimaryVertexContext();
+  const float3& primaryVertex = ctx->getPrimaryVertex();
+  tracklets.resize(par.TrackletsPerRoad());
+  for (auto& layerTracklets : tracklets) {
+    layerTracklets.clear(); // keep the capacity for repeated calls
+  }
+  for (int iLayer = 0; iLayer < par.TrackletsPerRoad(); iLayer++) {
+    const int* indexTable = ctx->getIndexTable(iLayer);
+    const auto& currentLayer = ctx->getClusters()[iLayer];
+    const auto& nextLayer = ctx->getClusters()[iLayer + 1];
+    if (currentLayer.empty() || nextLayer.empty()) {
+      continue;
+    }
+    for (int iCluster = 0; iCluster < (int)currentLayer.size(); iCluster++) {
+      const Cluster& currentCluster{currentLayer[iCluster]};
+      if (ctx->isClusterUsed(iLayer, currentCluster.clusterId)) {
+        continue;
+      }
+      const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
+      const float zAtRmin{tanLambda * (ctx->getMinR(iLayer + 1) - currentCluster.rCoordinate) + currentCluster.zCoordinate};
+      const float zAtRmax{tanLambda * (ctx->getMaxR(iLayer + 1) - currentCluster.rCoordinate) + currentCluster.zCoordinate};
+      const int4 rect{traits.getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax, par.TrackletMaxDeltaZ[iLayer], par.TrackletMaxDeltaPhi)};
+      if (rect.x == 0 && rect.y == 0 && rect.z == 0 && rect.w == 0) {
+        continue;
+      }
+      int phiBinsNum{rect.w - rect.y + 1};
+      if (phiBinsNum < 0) {
+        phiBinsNum += par.PhiBins;
+      }
+      for (int iPhiBin{rect.y}, iPhiCount{0}; iPhiCount < phiBinsNum; iPhiBin = ++iPhiBin == par.PhiBins ? 0 : iPhiBin, iPhiCount++) {
+        const int firstBinIndex{ctx->mIndexTableUtils.getBinIndex(rect.x, iPhiBin)};
+        const int maxBinIndex{firstBinIndex + rect.z - rect.x + 1};
+        for (int iNext = indexTable[firstBinIndex]; iNext < indexTable[maxBinIndex]; iNext++) {
+          if (iNext >= (int)nextLayer.size()) {
+            break;
+          }
+          const Cluster& nextCluster{nextLayer[iNext]};
+          if (ctx->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+            continue;
+          }
+          const float deltaZ{std::abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) + currentCluster.zCoordinate - nextCluster.zCoordinate)};
+          const float deltaPhi{std::abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
+          if (deltaZ < par.TrackletMaxDeltaZ[iLayer] && (deltaPhi < par.TrackletMaxDeltaPhi || std::abs(deltaPhi - constants::math::TwoPi) < par.TrackletMaxDeltaPhi)) {
+            if (iLayer > 0 && lookupTables[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
+              lookupTables[iLayer - 1][iCluster] = tracklets[iLayer].size();
+            }
+            tracklets[iLayer].emplace_back(iCluster, iNext, currentCluster, nextCluster);
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace its
+} // namespace o2
+
+#endif
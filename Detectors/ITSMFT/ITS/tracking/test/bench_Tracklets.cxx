@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_Tracklets.cxx
+/// \brief  Benchmark of the ITS tracklet finding: AoS scan of the index table vs SoA vectorized doublet selection
+
+#include "benchmark/benchmark.h"
+#include "TrackletsReference.h"
+#include "ITStracking/TrackerTraitsCPU.h"
+#include "ITStracking/PrimaryVertexContext.h"
+#include "ITStracking/Configuration.h"
+#include "ITStracking/Constants.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace o2::its;
+
+// clusters of straight tracks from the origin, smeared, plus uniformly distributed noise
+std::vector<std::vector<Cluster>> generateClusters(const TrackingParameters& par, int nTracks)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> smear(0., 5.e-4);
+  std::vector<std::vector<Cluster>> clusters(par.NLayers);
+  for (int iTrack = 0; iTrack < nTracks; iTrack++) {
+    float phi = rnd(gen) * constants::math::TwoPi, tgl = (rnd(gen) - 0.5f) * 2.f;
+    for (int iLayer = 0; iLayer < par.NLayers; iLayer++) {
+      float r = par.LayerRadii[iLayer];
+      clusters[iLayer].emplace_back(r * std::cos(phi) + smear(gen), r * std::sin(phi) + smear(gen), r * tgl + smear(gen), clusters[iLayer].size());
+    }
+  }
+  for (int iLayer = 0; iLayer < par.NLayers; iLayer++) {
+    float r = par.LayerRadii[iLayer];
+    for (int iNoise = 0; iNoise < nTracks / 10; iNoise++) {
+      float phi = rnd(gen) * constants::math::TwoPi;
+      clusters[iLayer].emplace_back(r * std::cos(phi), r * std::sin(phi), (rnd(gen) - 0.5f) * 1.8f * (par.LayerZ[iLayer] - 1), clusters[iLayer].size());
+    }
+  }
+  return clusters;
+}
+
+struct TrackletsSetup {
+  TrackingParameters trkPar;
+  MemoryParameters memPar;
+  std::vector<std::vector<Cluster>> clusters;
+  TrackerTraitsCPU traits;
+
+  TrackletsSetup(int nTracks, int nThreads)
+  {
+    trkPar.TrackletMaxDeltaPhi = 0.05f;
+    for (auto& c : memPar.TrackletsMemoryCoefficients) {
+      c = 0.05f;
+    }
+    clusters = generateClusters(trkPar, nTracks);
+    traits.UpdateTrackingParameters(trkPar);
+    traits.setNThreads(nThreads);
+    traits.getPrimaryVertexContext()->initialise(memPar, trkPar, clusters, {0.f, 0.f, 0.f}, 0);
+  }
+  void reset() { traits.getPrimaryVertexContext()->initialise(memPar, trkPar, clusters, {0.f, 0.f, 0.f}, 1); }
+};
+
+static void BM_TrackletsAoS(benchmark::State& state)
+{
+  TrackletsSetup setup(state.range(0), 1);
+  const auto lookupTablesInit = setup.traits.getPrimaryVertexContext()->getTrackletsLookupTable();
+  std::vector<std::vector<Tracklet>> tracklets;
+  std::vector<std::vector<int>> lookupTables;
+  size_t nTracklets = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    lookupTables = lookupTablesInit;
+    state.ResumeTiming();
+    computeTrackletsReference(setup.traits, setup.trkPar, tracklets, lookupTables);
+    nTracklets = 0;
+    for (const auto& layerTracklets : tracklets) {
+      nTracklets += layerTracklets.size();
+    }
+  }
+  state.counters["tracklets/s"] = benchmark::Counter(double(nTracklets) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+static void BM_TrackletsSoA(benchmark::State& state)
+{
+  TrackletsSetup setup(state.range(0), state.range(1));
+  size_t nTracklets = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    setup.reset();
+    state.ResumeTiming();
+    setup.traits.computeLayerTracklets();
+    nTracklets = 0;
+    for (const auto& tracklets : setup.traits.getPrimaryVertexContext()->getTracklets()) {
+      nTracklets += tracklets.size();
+    }
+  }
+  state.counters["tracklets/s"] = benchmark::Counter(double(nTracklets) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// args: number of tracks, number of threads
+BENCHMARK(BM_TrackletsAoS)->Args({2000, 1})->Args({10000, 1})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TrackletsSoA)->Args({2000, 1})->Args({10000, 1})->Args({10000, 4})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,201 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ITS CA tracker on CPU
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ITStracking/Tracker.h"
+#include "ITStracking/TrackerTraitsCPU.h"
+#include "ITStracking/PrimaryVertexContext.h"
+#include "ITStracking/ROframe.h"
+#include "ITStracking/Configuration.h"
+#include "ITStracking/Constants.h"
+#include "DetectorsBase/Propagator.h"
+#include "TrackletsReference.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace its
+{
+
+// ROF with the clusters of straight tracks from the origin, smeared, plus uniformly distributed noise
+ROframe generateROframe(const TrackingParameters& par, int nTracks)
+{
+  const float sigma = 5.e-4;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> smear(0., sigma);
+  ROframe event(0, par.NLayers);
+  event.addPrimaryVertex(0.f, 0.f, 0.f);
+  auto addCluster = [&](int layer, float phi, float z) {
+    const float r = par.LayerRadii[layer], cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+    const float yTF = smear(gen), zTF = z + smear(gen), x = r * cosPhi - yTF * sinPhi, y = r * sinPhi + yTF * cosPhi;
+    int id = event.getClustersOnLayer(layer).size();
+    event.addTrackingFrameInfoToLayer(layer, x, y, zTF, r, phi, std::array<float, 2>{yTF, zTF}, std::array<float, 3>{sigma * sigma, 0.f, sigma * sigma});
+    event.addClusterToLayer(layer, x, y, zTF, id);
+    event.addClusterExternalIndexToLayer(layer, id);
+  };
+  for (int iTrack = 0; iTrack < nTracks; iTrack++) {
+    float phi = rnd(gen) * constants::math::TwoPi, tgl = (rnd(gen) - 0.5f) * 2.f;
+    for (int iLayer = 0; iLayer < par.NLayers; iLayer++) {
+      addCluster(iLayer, phi, par.LayerRadii[iLayer] * tgl);
+    }
+  }
+  for (int iLayer = 0; iLayer < par.NLayers; iLayer++) {
+    for (int iNoise = 0; iNoise < nTracks / 10; iNoise++) {
+      addCluster(iLayer, rnd(gen) * constants::math::TwoPi, (rnd(gen) - 0.5f) * 1.8f * (par.LayerZ[iLayer] - 1));
+    }
+  }
+  return event;
+}
+
+struct TrackerSetup {
+  TrackingParameters trkPar;
+  MemoryParameters memPar;
+  TrackerSetup()
+  {
+    trkPar.TrackletMaxDeltaPhi = 0.05f;
+    for (auto& c : memPar.TrackletsMemoryCoefficients) {
+      c = 0.05f;
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(TrackletsSoA)
+{
+  // the SoA selection must give the same tracklets and lookup tables as the former scan of the AoS clusters
+  TrackerSetup setup;
+  auto event = generateROframe(setup.trkPar, 3000);
+  TrackerTraitsCPU traits;
+  traits.UpdateTrackingParameters(setup.trkPar);
+  auto ctx = traits.getPrimaryVertexContext();
+  ctx->initialise(setup.memPar, setup.trkPar, event.getClusters(), {0.f, 0.f, 0.f}, 0);
+  for (int iLayer = 0; iLayer < setup.trkPar.NLayers; iLayer++) { // exercise the used clusters rejection
+    for (const auto& cl : ctx->getClusters()[iLayer]) {
+      if (cl.clusterId % 7 == iLayer) {
+        ctx->markUsedCluster(iLayer, cl.clusterId);
+      }
+    }
+  }
+  std::vector<std::vector<Tracklet>> trackletsRef;
+  auto lookupTablesRef = ctx->getTrackletsLookupTable();
+  computeTrackletsReference(traits, setup.trkPar, trackletsRef, lookupTablesRef);
+  traits.computeLayerTracklets();
+  for (int iLayer = 0; iLayer < setup.trkPar.TrackletsPerRoad(); iLayer++) {
+    const auto& tracklets = ctx->getTracklets()[iLayer];
+    BOOST_CHECK(trackletsRef[iLayer].size() > 0);
+    BOOST_REQUIRE(tracklets.size() == trackletsRef[iLayer].size());
+    for (size_t it = 0; it < tracklets.size(); it++) {
+      BOOST_CHECK(tracklets[it].firstClusterIndex == trackletsRef[iLayer][it].firstClusterIndex);
+      BOOST_CHECK(tracklets[it].secondClusterIndex == trackletsRef[iLayer][it].secondClusterIndex);
+      BOOST_CHECK(tracklets[it].tanLambda == trackletsRef[iLayer][it].tanLambda);
+      BOOST_CHECK(tracklets[it].phiCoordinate == trackletsRef[iLayer][it].phiCoordinate);
+    }
+  }
+  BOOST_CHECK(ctx->getTrackletsLookupTable() == lookupTablesRef);
+}
+
+BOOST_AUTO_TEST_CASE(TrackletsCellsThreads)
+{
+  TrackerSetup setup;
+  auto event = generateROframe(setup.trkPar, 3000);
+  auto findTrackletsCells = [&](TrackerTraitsCPU& traits, int nThreads) {
+    traits.UpdateTrackingParameters(setup.trkPar);
+    traits.setNThreads(nThreads);
+    traits.getPrimaryVertexContext()->initialise(setup.memPar, setup.trkPar, event.getClusters(), {0.f, 0.f, 0.f}, 0);
+    traits.computeLayerTracklets();
+    traits.computeLayerCells();
+    return traits.getPrimaryVertexContext();
+  };
+  TrackerTraitsCPU traitsRef;
+  auto ref = findTrackletsCells(traitsRef, 1);
+  for (int nThreads : {2, 4}) {
+    TrackerTraitsCPU traits;
+    auto ctx = findTrackletsCells(traits, nThreads);
+    for (int iLayer = 0; iLayer < setup.trkPar.TrackletsPerRoad(); iLayer++) {
+      const auto &tracklets = ctx->getTracklets()[iLayer], &trackletsRef = ref->getTracklets()[iLayer];
+      BOOST_CHECK(trackletsRef.size() > 0);
+      BOOST_REQUIRE(tracklets.size() == trackletsRef.size());
+      for (size_t it = 0; it < trackletsRef.size(); it++) {
+        BOOST_CHECK(tracklets[it].firstClusterIndex == trackletsRef[it].firstClusterIndex);
+        BOOST_CHECK(tracklets[it].secondClusterIndex == trackletsRef[it].secondClusterIndex);
+        BOOST_CHECK(tracklets[it].tanLambda == trackletsRef[it].tanLambda);
+        BOOST_CHECK(tracklets[it].phiCoordinate == trackletsRef[it].phiCoordinate);
+      }
+    }
+    for (int iLayer = 0; iLayer < setup.trkPar.TrackletsPerRoad() - 1; iLayer++) {
+      BOOST_CHECK(ctx->getTrackletsLookupTable()[iLayer] == ref->getTrackletsLookupTable()[iLayer]);
+    }
+    for (int iLayer = 0; iLayer < setup.trkPar.CellsPerRoad(); iLayer++) {
+      const auto &cells = ctx->getCells()[iLayer], &cellsRef = ref->getCells()[iLayer];
+      BOOST_CHECK(cellsRef.size() > 0);
+      BOOST_REQUIRE(cells.size() == cellsRef.size());
+      for (size_t ic = 0; ic < cellsRef.size(); ic++) {
+        BOOST_CHECK(cells[ic].getFirstClusterIndex() == cellsRef[ic].getFirstClusterIndex());
+        BOOST_CHECK(cells[ic].getSecondClusterIndex() == cellsRef[ic].getSecondClusterIndex());
+        BOOST_CHECK(cells[ic].getThirdClusterIndex() == cellsRef[ic].getThirdClusterIndex());
+        BOOST_CHECK(cells[ic].getFirstTrackletIndex() == cellsRef[ic].getFirstTrackletIndex());
+        BOOST_CHECK(cells[ic].getSecondTrackletIndex() == cellsRef[ic].getSecondTrackletIndex());
+        BOOST_CHECK(cells[ic].getLevel() == cellsRef[ic].getLevel());
+        BOOST_CHECK(cells[ic].getCurvature() == cellsRef[ic].getCurvature());
+        const auto &n = cells[ic].getNormalVectorCoordinates(), &nRef = cellsRef[ic].getNormalVectorCoordinates();
+        BOOST_CHECK(n.x == nRef.x && n.y == nRef.y && n.z == nRef.z);
+      }
+    }
+    for (int iLayer = 0; iLayer < setup.trkPar.CellsPerRoad() - 1; iLayer++) {
+      BOOST_CHECK(ctx->getCellsLookupTable()[iLayer] == ref->getCellsLookupTable()[iLayer]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TracksThreads)
+{
+  TrackerSetup setup;
+  auto event = generateROframe(setup.trkPar, 1000);
+  o2::base::Propagator::Instance(true);
+  auto findTracks = [&](int nThreads) {
+    TrackerTraitsCPU traits;
+    traits.setNThreads(nThreads);
+    Tracker tracker(&traits);
+    tracker.setParameters({setup.memPar}, {setup.trkPar});
+    tracker.setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE);
+    tracker.clustersToTracks(event);
+    return tracker.getTracks();
+  };
+  auto ref = findTracks(1);
+  BOOST_CHECK(ref.size() > 0);
+  for (int nThreads : {2, 4}) {
+    auto tracks = findTracks(nThreads);
+    BOOST_REQUIRE(tracks.size() == ref.size());
+    for (size_t it = 0; it < ref.size(); it++) {
+      BOOST_CHECK(tracks[it].getX() == ref[it].getX() && tracks[it].getAlpha() == ref[it].getAlpha());
+      for (int ip = 0; ip < o2::track::kNParams; ip++) {
+        BOOST_CHECK(tracks[it].getParam(ip) == ref[it].getParam(ip));
+      }
+      for (int ic = 0; ic < o2::track::kCovMatSize; ic++) {
+        BOOST_CHECK(tracks[it].getCov()[ic] == ref[it].getCov()[ic]);
+      }
+      BOOST_CHECK(tracks[it].getChi2() == ref[it].getChi2());
+      BOOST_CHECK(tracks[it].getNumberOfClusters() == ref[it].getNumberOfClusters());
+      for (int iLayer = 0; iLayer < setup.trkPar.NLayers; iLayer++) {
+        BOOST_CHECK(tracks[it].getClusterIndex(iLayer) == ref[it].getClusterIndex(iLayer));
+      }
+    }
+  }
+}
+
+} // namespace its
+} // namespace o2
@@ -16,9 +16,11 @@
 /// @author ruben.shahoyan@cern.ch
 /// @brief  Reader for (multiple) raw data files
 
+#include <array>
 #include <cstdio>
 #include <unordered_map>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <vector>
 #include <string>
@@ -46,8 +48,11 @@ struct ReaderInp {
   uint32_t errMap = 0xffffffff;
   uint32_t minTF = 0;
   uint32_t maxTF = 0xffffffff;
+  int nThreads = 1;
   bool partPerSP = true;
   bool cache = false;
+  bool mmap = false;
+  std::string indexFile{};
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
 };
@@ -135,6 +140,16 @@ class RawFileReader
     int nBlocks; // number of consecutive LinkBlock objects
   };
 
+  // location of the RDH in the input files, as seen in the 1st pass over the file
+  struct PageRef {
+    size_t offset = 0;          // RDH offset in the file
+    LinkSpec_t spec = 0;        // link spec of the RDH
+    int linkID = -1;            // entry of the link in the mLinksData
+    uint16_t fileID = 0;        // file id where the RDH is located
+    bool newSPage = false;      // link has changed wrt the previous RDH of the file
+    bool multiLinkFile = false; // was > than 1 link seen in the file up to this RDH?
+  };
+
   // info on the smallest block of data to be read when fetching the HBF
   struct LinkBlock {
     enum { StartTF = 0x1,
@@ -191,7 +206,7 @@ class RawFileReader
     LinkData(const H& rdh, RawFileReader* r) : rdhl(rdh), reader(r)
     {
     }
-    bool preprocessCRUPage(const RDHAny& rdh, bool newSPage);
+    bool preprocessCRUPage(const RDHAny& rdh, const PageRef& page);
     size_t getLargestSuperPage() const;
     size_t getLargestTF() const;
     size_t getNextHBFSize() const;
@@ -202,6 +217,7 @@ class RawFileReader
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
+    size_t mapNextSuperPage(const char*& data, std::shared_ptr<const void>& mapping, const PartStat* pstat = nullptr);
     size_t skipNextHBF();
     size_t skipNextTF();
 
@@ -264,6 +280,20 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  /// memory-map the input files at init: they are preprocessed concurrently and the superpages can be accessed w/o copying
+  bool getUseMMap() const { return mUseMMap; }
+  void setUseMMap(bool v) { mUseMMap = v; }
+  bool isMapped(int fileID) const { return fileID < int(mMappedFiles.size()) && mMappedFiles[fileID]; }
+
+  /// number of threads for the preprocessing of the memory-mapped files
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+
+  /// index file to store the preprocessing results at init and to reuse them if the input files and settings did not change
+  const std::string& getIndexFile() const { return mIndexFile; }
+  void setIndexFile(const std::string& s) { mIndexFile = s; }
+  bool isIndexLoaded() const { return mIndexLoaded; }
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -282,8 +312,29 @@ class RawFileReader
   static std::string nochk_expl(ErrTypes e);
 
  private:
+  // memory-mapped input file, unmapped once neither the reader nor the users of its data (e.g. messages sent w/o copy) refer to it
+  struct MappedFile {
+    char* data = nullptr;
+    size_t size = 0;
+    MappedFile(char* d, size_t s) : data(d), size(s) {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+  };
+
   int getLinkLocalID(const RDHAny& rdh, int fileID);
+  bool checkPage(const RDHAny& rdh, size_t offset, size_t fileSize, int fileID) const;
   bool preprocessFile(int ifl);
+  bool mapFiles();
+  void unmapFiles();
+  bool preprocessMappedFiles();
+  size_t scanMappedFile(int ifl, std::vector<PageRef>& pages) const;
+  bool readFileData(int fileID, size_t offset, size_t size, char* buff);
+  bool loadIndex(const std::vector<uint32_t>& settings);
+  bool storeIndex(const std::vector<uint32_t>& settings) const;
+  std::vector<uint32_t> getIndexSettings() const;
+  std::array<uint64_t, 3> getFileSignature(int ifl) const;
+  const RDHAny& getMappedRDH(const PageRef& page) const { return *reinterpret_cast<const RDHAny*>(mMappedFiles[page.fileID]->data + page.offset); }
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -295,6 +346,7 @@ class RawFileReader
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::shared_ptr<const MappedFile>> mMappedFiles;         //! memory-mapped input files
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -312,6 +364,10 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mUseMMap = false;                                            //! memory-map input files
+  int mNThreads = 1;                                                //! number of threads for preprocessing of memory-mapped files
+  std::string mIndexFile{};                                         //! index file with preprocessing results
+  bool mIndexLoaded = false;                                        //! preprocessing results were loaded from the index file
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
   bool mPreferCalculatedTFStart = false;                            //! prefer TFstart calculated via HBFUtils
@@ -14,7 +14,10 @@
 /// @brief  Reader for (multiple) raw data files
 
 #include <algorithm>
+#include <cerrno>
 #include <cstring>
+#include <exception>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <memory>
@@ -30,10 +33,65 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::raw;
 namespace o2h = o2::header;
 
+namespace
+{
+constexpr char IndexMagic[8] = {'O', '2', 'R', 'A', 'W', 'I', 'D', 'X'};
+constexpr uint32_t IndexVersion = 1;
+constexpr size_t IndexChecksumRange = 64 * 1024; // file head and tail used for the file checksum
+
+template <typename T>
+void writeIdx(std::ostream& out, const T& v)
+{
+  out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+bool readIdx(std::istream& inp, T& v)
+{
+  inp.read(reinterpret_cast<char*>(&v), sizeof(T));
+  return bool(inp);
+}
+
+template <typename T>
+void writeIdxVec(std::ostream& out, const std::vector<T>& v)
+{
+  writeIdx(out, uint64_t(v.size()));
+  out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <typename T>
+bool readIdxVec(std::istream& inp, std::vector<T>& v)
+{
+  uint64_t n = 0;
+  if (!readIdx(inp, n) || n > (uint64_t(1) << 32)) {
+    return false;
+  }
+  v.resize(n);
+  inp.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+  return bool(inp);
+}
+
+// FNV-1a hash
+uint64_t hashBytes(const char* data, size_t n, uint64_t h = 0xcbf29ce484222325ULL)
+{
+  for (size_t i = 0; i < n; i++) {
+    h ^= uint8_t(data[i]);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+} // namespace
+
 //====================== methods of LinkBlock ========================
 //____________________________________________
 void RawFileReader::LinkBlock::print(const std::string& pref) const
@@ -83,6 +141,7 @@ size_t RawFileReader::LinkData::getNextTFSuperPagesStat(std::vector<RawFileReade
     while (ibl < nbl && (blocks[ibl].tfID == blocks[nextBlock2Read].tfID)) {
       if (ibl > nextBlock2Read && (blocks[ibl].testFlag(LinkBlock::StartSP) ||
                                    (sz + blocks[ibl].size) > reader->mNominalSPageSize ||
+                                   blocks[ibl - 1].fileID != blocks[ibl].fileID ||
                                    (blocks[ibl - 1].offset + blocks[ibl - 1].size) < blocks[ibl].offset)) { // new superpage
         parts.emplace_back(RawFileReader::PartStat{sz, nblPart});
         sz = 0;
@@ -134,8 +193,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+      if (!reader->readFileData(blc.fileID, blc.offset, blc.size, buff + sz)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blc.print();
         error = true;
@@ -277,6 +335,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
       if (ibl > nextBlock2Read && (blc.tfID != blocks[nextBlock2Read].tfID ||
                                    blc.testFlag(LinkBlock::StartSP) ||
                                    (sz + blc.size) > reader->mNominalSPageSize ||
+                                   blocks[ibl - 1].fileID != blc.fileID ||
                                    blocks[ibl - 1].offset + blocks[ibl - 1].size < blc.offset)) { // new superpage or TF
         break;
       }
@@ -288,8 +347,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
     } else {
-      auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
-      if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
+      if (!reader->readFileData(blocks[nextBlock2Read].fileID, blocks[nextBlock2Read].offset, sz, buff)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blocks[nextBlock2Read].print();
         error = true;
@@ -303,6 +361,52 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
   return error ? 0 : sz; // in case of the error we ignore the data
 }
 
+//____________________________________________
+size_t RawFileReader::LinkData::mapNextSuperPage(const char*& data, std::shared_ptr<const void>& mapping, const RawFileReader::PartStat* pstat)
+{
+  // same as readNextSuperPage but for the memory-mapped file: the data pointer is set to the superpage data in the
+  // mapped file, which stays valid as long as the mapping reference is kept, even if the reader is cleared
+  data = nullptr;
+  mapping.reset();
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return 0;
+  }
+  const auto& blc0 = blocks[nextBlock2Read];
+  if (!reader->isMapped(blc0.fileID)) {
+    LOGF(ERROR, "File %d of the %s is not memory-mapped", int(blc0.fileID), describe());
+    return 0;
+  }
+  int ibl = nextBlock2Read, nbl = blocks.size();
+  size_t sz = 0;
+  if (pstat) { // info is provided, use it derictly
+    sz = pstat->size;
+    ibl += pstat->nBlocks;
+  } else { // need to calculate blocks to read
+    while (ibl < nbl) {
+      auto& blc = blocks[ibl];
+      if (ibl > nextBlock2Read && (blc.tfID != blc0.tfID ||
+                                   blc.testFlag(LinkBlock::StartSP) ||
+                                   (sz + blc.size) > reader->mNominalSPageSize ||
+                                   blocks[ibl - 1].fileID != blc.fileID ||
+                                   blocks[ibl - 1].offset + blocks[ibl - 1].size < blc.offset)) { // new superpage or TF
+        break;
+      }
+      ibl++;
+      sz += blc.size;
+    }
+  }
+  const auto& mapped = reader->mMappedFiles[blc0.fileID];
+  if (blc0.offset + sz > mapped->size) {
+    LOGF(ERROR, "Superpage of the %s exceeds the mapped file size:", describe());
+    blc0.print();
+    return 0;
+  }
+  data = mapped->data + blc0.offset;
+  mapping = mapped;
+  nextBlock2Read = ibl;
+  return sz;
+}
+
 //____________________________________________
 size_t RawFileReader::LinkData::getLargestSuperPage() const
 {
@@ -338,10 +442,13 @@ size_t RawFileReader::LinkData::getLargestTF() const
 }
 
 //_____________________________________________________________________
-bool RawFileReader::LinkData::preprocessCRUPage(const RDHAny& rdh, bool newSPage)
+bool RawFileReader::LinkData::preprocessCRUPage(const RDHAny& rdh, const PageRef& page)
 {
   // account RDH in statistics
+  // the reader state is not modified unless the 1st TF must be autodetected, so that different links can be
+  // processed concurrently
   bool ok = true;
+  bool newSPage = page.newSPage;
   bool newTF = false, newHB = false;
   const auto& HBU = HBFUtils::Instance();
 
@@ -477,7 +584,7 @@ bool RawFileReader::LinkData::preprocessCRUPage(const RDHAny& rdh, bool newSPage
 
   if (newTF || newSPage || newHB) {
     int nbl = blocks.size();
-    auto& bl = blocks.emplace_back(reader->mCurrentFileID, reader->mPosInFile);
+    auto& bl = blocks.emplace_back(page.fileID, page.offset);
     bl.ir = hbIR;
     bl.tfID = HBU.getTF(hbIR); // nTimeFrames - 1;
     if (newTF) {
@@ -493,7 +600,7 @@ bool RawFileReader::LinkData::preprocessCRUPage(const RDHAny& rdh, bool newSPage
       nTimeFrames++;
       bl.setFlag(LinkBlock::StartTF);
       if (reader->mCheckErrors & (0x1 << ErrNoSuperPageForTF) && cruDetector) {
-        if (reader->mMultiLinkFile && !newSPage) {
+        if (page.multiLinkFile && !newSPage) {
           LOG(ERROR) << ErrNames[ErrNoSuperPageForTF] << " @ TF#" << nTimeFrames;
           ok = false;
           nErrors++;
@@ -514,7 +621,7 @@ bool RawFileReader::LinkData::preprocessCRUPage(const RDHAny& rdh, bool newSPage
   rdhl = rdh;
   nCRUPages++;
   if (!ok) {
-    LOG(ERROR) << " ^^^Problem(s) was encountered at offset " << reader->mPosInFile << " of file " << reader->mCurrentFileID;
+    LOG(ERROR) << " ^^^Problem(s) was encountered at offset " << page.offset << " of file " << page.fileID;
     RDHUtils::printRDH(rdh);
   } else if (reader->mVerbosity > 1) {
     if (reader->mVerbosity > 2) {
@@ -560,12 +667,31 @@ int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
   return entryMap->second;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::checkPage(const RDHAny& rdh, size_t offset, size_t fileSize, int fileID) const
+{
+  // check if the RDH at given offset of the file is valid and its page is fully contained in the file
+  if (!RDHUtils::checkRDH(rdh, true)) {
+    LOGF(ERROR, "Invalid RDH at offset %zu of file %s, stop scanning it", offset, mFileNames[fileID]);
+    return false;
+  }
+  size_t offsNext = RDHUtils::getOffsetToNext(rdh);
+  if (offsNext < size_t(RDHUtils::getHeaderSize(rdh)) || offset + offsNext > fileSize) {
+    LOGF(ERROR, "RDH at offset %zu of file %s of size %zu has wrong offset to next page %zu, stop scanning it",
+         offset, mFileNames[fileID], fileSize, offsNext);
+    return false;
+  }
+  return true;
+}
+
 //_____________________________________________________________________
 bool RawFileReader::preprocessFile(int ifl)
 {
   // preprocess file, check RDH data, build statistics
   std::unique_ptr<char[]> buffer = std::make_unique<char[]>(mBufferSize);
   FILE* fl = mFiles[ifl];
+  struct stat st;
+  size_t fileSize = fstat(fileno(fl), &st) ? 0 : st.st_size;
   mCurrentFileID = ifl;
   LinkSpec_t specPrev = 0xffffffffffffffff;
   int lIDPrev = -1;
@@ -579,6 +705,10 @@ bool RawFileReader::preprocessFile(int ifl)
     boffs = 0;
     while (1) {
       auto& rdh = *reinterpret_cast<RDHUtils::RDHAny*>(&buffer[boffs]);
+      if (!checkPage(rdh, mPosInFile, fileSize, ifl)) {
+        readMore = false;
+        break;
+      }
       nRDHread++;
       LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
       int lID = lIDPrev;
@@ -589,8 +719,8 @@ bool RawFileReader::preprocessFile(int ifl)
         }
         lID = getLinkLocalID(rdh, mCurrentFileID);
       }
-      bool newSPage = lID != lIDPrev;
-      mLinksData[lID].preprocessCRUPage(rdh, newSPage);
+      PageRef page{size_t(mPosInFile), spec, lID, uint16_t(mCurrentFileID), lID != lIDPrev, mMultiLinkFile};
+      mLinksData[lID].preprocessCRUPage(rdh, page);
       if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
         mLinksData[lID].nTimeFrames--;
         mLinksData[lID].blocks.pop_back();
@@ -621,6 +751,356 @@ bool RawFileReader::preprocessFile(int ifl)
   return nRDHread > 0;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::mapFiles()
+{
+  // memory-map all input files, in case of failure nothing is mapped and the files are read in a usual way
+  mMappedFiles.clear();
+  mMappedFiles.resize(mFiles.size());
+  for (int i = 0; i < int(mFiles.size()); i++) {
+    struct stat st;
+    int fd = fileno(mFiles[i]);
+    if (fstat(fd, &st)) {
+      LOGF(ERROR, "Failed to stat file %s, will not use memory mapping: %s", mFileNames[i], strerror(errno));
+      unmapFiles();
+      return false;
+    }
+    if (st.st_size == 0) { // nothing to map
+      continue;
+    }
+    auto ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      LOGF(ERROR, "Failed to map file %s, will not use memory mapping: %s", mFileNames[i], strerror(errno));
+      unmapFiles();
+      return false;
+    }
+    mMappedFiles[i] = std::make_shared<const MappedFile>(static_cast<char*>(ptr), size_t(st.st_size));
+  }
+  return true;
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  mMappedFiles.clear(); // the files are unmapped once their data is not used anymore
+}
+
+//_____________________________________________________________________
+RawFileReader::MappedFile::~MappedFile()
+{
+  if (data) {
+    munmap(data, size);
+  }
+}
+
+//_____________________________________________________________________
+bool RawFileReader::readFileData(int fileID, size_t offset, size_t size, char* buff)
+{
+  // read the data block from the mapped file or from the file stream
+  if (isMapped(fileID)) {
+    const auto& mapped = mMappedFiles[fileID];
+    if (offset + size > mapped->size) {
+      return false;
+    }
+    memcpy(buff, mapped->data + offset, size);
+    return true;
+  }
+  auto fl = mFiles[fileID];
+  return !fseek(fl, offset, SEEK_SET) && fread(buff, 1, size, fl) == size;
+}
+
+//_____________________________________________________________________
+size_t RawFileReader::scanMappedFile(int ifl, std::vector<PageRef>& pages) const
+{
+  // locate all RDHs of the memory-mapped file, return number of bytes scanned. The links are not registered at this stage
+  const auto& mapped = *mMappedFiles[ifl];
+  auto orig = std::get<0>(mDataSpecs[ifl]);
+  LinkSpec_t specPrev = 0xffffffffffffffff;
+  bool multiLink = false;
+  size_t offs = 0;
+  while (offs + sizeof(RDHUtils::RDHAny) <= mapped.size) {
+    const auto& rdh = *reinterpret_cast<const RDHUtils::RDHAny*>(mapped.data + offs);
+    if (!checkPage(rdh, offs, mapped.size, ifl)) {
+      break;
+    }
+    LinkSpec_t spec = createSpec(orig, RDHUtils::getSubSpec(rdh));
+    bool newLink = spec != specPrev;
+    if (newLink && specPrev != 0xffffffffffffffff) {
+      multiLink = true;
+    }
+    specPrev = spec;
+    pages.push_back(PageRef{offs, spec, -1, uint16_t(ifl), newLink, multiLink});
+    offs += RDHUtils::getOffsetToNext(rdh);
+  }
+  return offs;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::preprocessMappedFiles()
+{
+  // preprocess memory-mapped files in 2 passes: at first the RDHs of every file are located (in parallel over the files),
+  // then the pages of every link are accounted in the order of the files and offsets (in parallel over the links).
+  // If the number of TFs to read is limited or the 1st TF must be autodetected, the 2nd pass is done sequentially
+  int nf = mFiles.size();
+  std::vector<std::vector<PageRef>> pages(nf);
+  std::vector<size_t> scanned(nf);
+  TStopwatch sw;
+  sw.Start();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nf; i++) {
+    scanned[i] = scanMappedFile(i, pages[i]);
+  }
+  size_t nRDHtot = 0;
+  for (int i = 0; i < nf; i++) {
+    LOGF(INFO, "File %3d : %9zu bytes mapped, %6zu RDH found in %s", i, scanned[i], pages[i].size(), mFileNames[i]);
+    nRDHtot += pages[i].size();
+  }
+
+  if (mNThreads < 2 || mMaxTFToRead < 0xffffffff || mFirstTFAutodetect == FirstTFDetection::Pending) {
+    for (int i = 0; i < nf; i++) {
+      mCurrentFileID = i;
+      int lID = -1;
+      for (auto& page : pages[i]) {
+        if (page.newSPage) { // link has changed
+          lID = getLinkLocalID(getMappedRDH(page), i);
+        }
+        page.linkID = lID;
+        auto& link = mLinksData[lID];
+        link.preprocessCRUPage(getMappedRDH(page), page);
+        if (link.nTimeFrames && (link.nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
+          link.nTimeFrames--;
+          link.blocks.pop_back();
+          if (link.nHBFrames > 0) {
+            link.nHBFrames--;
+          }
+          if (link.nCRUPages > 0) {
+            link.nCRUPages--;
+          }
+          break;
+        }
+      }
+    }
+  } else {
+    // register links in the same order as the sequential processing would do and collect their pages
+    std::vector<std::vector<const PageRef*>> linkPages;
+    for (int i = 0; i < nf; i++) {
+      int lID = -1;
+      for (auto& page : pages[i]) {
+        if (page.newSPage) {
+          lID = getLinkLocalID(getMappedRDH(page), i);
+          if (lID >= int(linkPages.size())) {
+            linkPages.resize(lID + 1);
+          }
+        }
+        page.linkID = lID;
+        linkPages[lID].push_back(&page);
+      }
+    }
+    int nl = mLinksData.size();
+    std::vector<std::exception_ptr> errors(nl);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int il = 0; il < nl; il++) {
+      try {
+        for (const auto* page : linkPages[il]) {
+          mLinksData[il].preprocessCRUPage(getMappedRDH(*page), *page);
+        }
+      } catch (...) { // exceptions must not leave the parallel region
+        errors[il] = std::current_exception();
+      }
+    }
+    for (auto& err : errors) {
+      if (err) {
+        std::rethrow_exception(err);
+      }
+    }
+  }
+  sw.Stop();
+  LOGF(INFO, "%zu RDH of %d links in %d memory-mapped files preprocessed with %d threads in %.3f s",
+       nRDHtot, int(mLinkEntries.size()), nf, mNThreads, sw.RealTime());
+  return nRDHtot > 0;
+}
+
+//_____________________________________________________________________
+std::vector<uint32_t> RawFileReader::getIndexSettings() const
+{
+  // settings affecting the preprocessing results, the index is valid only if they did not change
+  const auto& hbu = HBFUtils::Instance();
+  bool autodetect = mFirstTFAutodetect != FirstTFDetection::Disabled;
+  return {mCheckErrors, mMaxTFToRead, uint32_t(mPreferCalculatedTFStart), uint32_t(autodetect),
+          uint32_t(hbu.getNOrbitsPerTF()), autodetect ? 0 : hbu.orbitFirst};
+}
+
+//_____________________________________________________________________
+std::array<uint64_t, 3> RawFileReader::getFileSignature(int ifl) const
+{
+  // size, modification time and checksum of the head and tail of the file: scanning the whole file would defeat the purpose of the index
+  std::array<uint64_t, 3> sig{0, 0, 0};
+  struct stat st;
+  int fd = fileno(mFiles[ifl]);
+  if (fstat(fd, &st)) {
+    return sig;
+  }
+  sig[0] = st.st_size;
+  sig[1] = uint64_t(st.st_mtim.tv_sec) * 1000000000ULL + st.st_mtim.tv_nsec;
+  std::vector<char> buff(std::min(size_t(st.st_size), IndexChecksumRange));
+  uint64_t h = hashBytes(nullptr, 0);
+  if (pread(fd, buff.data(), buff.size(), 0) == ssize_t(buff.size())) {
+    h = hashBytes(buff.data(), buff.size(), h);
+  }
+  if (pread(fd, buff.data(), buff.size(), st.st_size - buff.size()) == ssize_t(buff.size())) {
+    h = hashBytes(buff.data(), buff.size(), h);
+  }
+  sig[2] = h;
+  return sig;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::storeIndex(const std::vector<uint32_t>& settings) const
+{
+  // store preprocessing results together with the signatures of the input files
+  std::ofstream out(mIndexFile + ".tmp", std::ios::binary | std::ios::trunc);
+  if (!out) {
+    LOG(ERROR) << "Failed to create index file " << mIndexFile;
+    return false;
+  }
+  out.write(IndexMagic, sizeof(IndexMagic));
+  writeIdx(out, IndexVersion);
+  writeIdxVec(out, settings);
+  writeIdx(out, HBFUtils::Instance().orbitFirst); // eventually autodetected
+  writeIdx(out, uint32_t(mFiles.size()));
+  for (int i = 0; i < int(mFiles.size()); i++) {
+    writeIdx(out, getFileSignature(i));
+    writeIdx(out, std::get<0>(mDataSpecs[i]));
+    writeIdx(out, std::get<1>(mDataSpecs[i]));
+    writeIdx(out, std::get<2>(mDataSpecs[i]));
+  }
+  writeIdx(out, uint32_t(mLinksData.size()));
+  for (const auto& link : mLinksData) {
+    writeIdx(out, link.rdhl);
+    writeIdx(out, link.irOfSOX);
+    writeIdx(out, link.spec);
+    writeIdx(out, link.subspec);
+    writeIdx(out, link.nTimeFrames);
+    writeIdx(out, link.nHBFrames);
+    writeIdx(out, link.nSPages);
+    writeIdx(out, link.nCRUPages);
+    writeIdx(out, link.cruDetector);
+    writeIdx(out, link.continuousRO);
+    writeIdx(out, link.origin);
+    writeIdx(out, link.description);
+    writeIdx(out, link.nErrors);
+    writeIdx(out, uint64_t(link.blocks.size()));
+    for (const auto& bl : link.blocks) {
+      writeIdx(out, bl.offset);
+      writeIdx(out, bl.size);
+      writeIdx(out, bl.tfID);
+      writeIdx(out, bl.ir);
+      writeIdx(out, bl.fileID);
+      writeIdx(out, bl.flags);
+    }
+    writeIdxVec(out, link.tfStartBlock);
+  }
+  out.close();
+  if (!out || std::rename((mIndexFile + ".tmp").c_str(), mIndexFile.c_str())) { // readers see either old or complete new index
+    LOG(ERROR) << "Failed to write index file " << mIndexFile;
+    std::remove((mIndexFile + ".tmp").c_str());
+    return false;
+  }
+  LOGF(INFO, "Preprocessing results for %d links stored in the index file %s", int(mLinksData.size()), mIndexFile);
+  return true;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::loadIndex(const std::vector<uint32_t>& settings)
+{
+  // load preprocessing results if the index is compatible with the input files and settings
+  std::ifstream inp(mIndexFile, std::ios::binary);
+  if (!inp) {
+    LOG(INFO) << "Index file " << mIndexFile << " is not available, input files will be preprocessed";
+    return false;
+  }
+  auto reject = [this](const std::string& reason) {
+    LOG(INFO) << "Index file " << mIndexFile << " is not used (" << reason << "), input files will be preprocessed";
+    return false;
+  };
+  char magic[sizeof(IndexMagic)];
+  uint32_t version = 0, orbitFirst = 0, nFiles = 0, nLinks = 0;
+  std::vector<uint32_t> idxSettings;
+  if (!readIdx(inp, magic) || memcmp(magic, IndexMagic, sizeof(IndexMagic)) || !readIdx(inp, version) || version != IndexVersion) {
+    return reject("wrong format");
+  }
+  if (!readIdxVec(inp, idxSettings) || idxSettings != settings || !readIdx(inp, orbitFirst)) {
+    return reject("different settings");
+  }
+  if (!readIdx(inp, nFiles) || nFiles != mFiles.size()) {
+    return reject("different number of files");
+  }
+  for (int i = 0; i < int(nFiles); i++) {
+    std::array<uint64_t, 3> sig;
+    o2h::DataOrigin origin;
+    o2h::DataDescription desc;
+    ReadoutCardType card;
+    if (!readIdx(inp, sig) || !readIdx(inp, origin) || !readIdx(inp, desc) || !readIdx(inp, card) ||
+        sig != getFileSignature(i) || OrigDescCard{origin, desc, card} != mDataSpecs[i]) {
+      return reject("file " + mFileNames[i] + " has changed");
+    }
+  }
+  if (!readIdx(inp, nLinks)) {
+    return reject("corrupted");
+  }
+  std::vector<LinkData> links;
+  links.reserve(nLinks);
+  for (int il = 0; il < int(nLinks); il++) {
+    RDHAny rdh;
+    uint64_t nBlocks = 0;
+    if (!readIdx(inp, rdh)) {
+      return reject("corrupted");
+    }
+    auto& link = links.emplace_back(rdh, this);
+    readIdx(inp, link.irOfSOX);
+    readIdx(inp, link.spec);
+    readIdx(inp, link.subspec);
+    readIdx(inp, link.nTimeFrames);
+    readIdx(inp, link.nHBFrames);
+    readIdx(inp, link.nSPages);
+    readIdx(inp, link.nCRUPages);
+    readIdx(inp, link.cruDetector);
+    readIdx(inp, link.continuousRO);
+    readIdx(inp, link.origin);
+    readIdx(inp, link.description);
+    readIdx(inp, link.nErrors);
+    if (!readIdx(inp, nBlocks) || nBlocks > (uint64_t(1) << 32)) {
+      return reject("corrupted");
+    }
+    link.blocks.resize(nBlocks);
+    for (auto& bl : link.blocks) {
+      readIdx(inp, bl.offset);
+      readIdx(inp, bl.size);
+      readIdx(inp, bl.tfID);
+      readIdx(inp, bl.ir);
+      readIdx(inp, bl.fileID);
+      readIdx(inp, bl.flags);
+    }
+    if (!readIdxVec(inp, link.tfStartBlock)) {
+      return reject("corrupted");
+    }
+  }
+  if (mFirstTFAutodetect == FirstTFDetection::Pending) {
+    imposeFirstTF(orbitFirst);
+  }
+  mLinksData.swap(links);
+  mLinkEntries.clear();
+  for (int il = 0; il < int(mLinksData.size()); il++) {
+    mLinkEntries[mLinksData[il].spec] = il;
+  }
+  LOGF(INFO, "Preprocessing results for %d links loaded from the index file %s", int(mLinksData.size()), mIndexFile);
+  return true;
+}
+
 //_____________________________________________________________________
 void RawFileReader::printStat(bool verbose) const
 {
@@ -639,6 +1119,7 @@ void RawFileReader::clear()
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
+  unmapFiles();
   for (auto fl : mFiles) {
     fclose(fl);
   }
@@ -701,11 +1182,23 @@ bool RawFileReader::init()
 
   int nf = mFiles.size();
   mEmpty = true;
-  for (int i = 0; i < nf; i++) {
-    if (preprocessFile(i)) {
-      mEmpty = false;
+  const auto idxSettings = getIndexSettings(); // must be taken before the eventual TF0 autodetection
+  bool mapped = mUseMMap && mapFiles();
+  mIndexLoaded = !mIndexFile.empty() && loadIndex(idxSettings);
+  if (mIndexLoaded) {
+    mEmpty = mLinksData.empty();
+  } else if (mapped) {
+    mEmpty = !preprocessMappedFiles();
+  } else {
+    for (int i = 0; i < nf; i++) {
+      if (preprocessFile(i)) {
+        mEmpty = false;
+      }
     }
   }
+  if (!mIndexLoaded && !mIndexFile.empty() && !mEmpty) {
+    storeIndex(idxSettings);
+  }
   mOrderedIDs.resize(mLinksData.size());
   for (int i = mLinksData.size(); i--;) {
     mOrderedIDs[i] = i;
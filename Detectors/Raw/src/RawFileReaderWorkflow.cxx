@@ -96,6 +96,9 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setUseMMap(rinp.mmap);
+  mReader->setNThreads(rinp.nThreads);
+  mReader->setIndexFile(rinp.indexFile);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(INFO) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -255,9 +258,22 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
       hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
       auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+      FairMQMessagePtr plMessage;
       mTimer[TimerIO].Start(false);
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      const char* spData = nullptr;
+      std::shared_ptr<const void> mapping;
+      size_t bread = 0;
+      if (mPartPerSP && mReader->getUseMMap()) { // superpage can be sent directly from the mapped file
+        bread = link.mapNextSuperPage(spData, mapping, &partsSP[hdrTmpl.splitPayloadIndex]);
+      }
+      if (spData) { // the message keeps a reference on the mapping, which is released by its deleter
+        plMessage = fmqFactory->CreateMessage(
+          const_cast<char*>(spData), bread, [](void*, void* hint) { delete static_cast<std::shared_ptr<const void>*>(hint); },
+          new std::shared_ptr<const void>(std::move(mapping)));
+      } else {
+        plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      }
       if (bread != hdrTmpl.payloadSize) {
         LOG(ERROR) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
@@ -34,6 +34,9 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"part-per-hbf", VariantType::Bool, false, {"FMQ parts per superpage (default) of HBF"}});
   options.push_back(ConfigParamSpec{"raw-channel-config", VariantType::String, "", {"optional raw FMQ channel for non-DPL output"}});
   options.push_back(ConfigParamSpec{"cache-data", VariantType::Bool, false, {"cache data at 1st reading, may require excessive memory!!!"}});
+  options.push_back(ConfigParamSpec{"mmap", VariantType::Bool, false, {"memory-map input files, send superpages w/o copying"}});
+  options.push_back(ConfigParamSpec{"preprocess-threads", VariantType::Int, 1, {"number of threads to preprocess memory-mapped files"}});
+  options.push_back(ConfigParamSpec{"index-file", VariantType::String, "", {"store preprocessing results in this file or reuse them if inputs did not change"}});
   options.push_back(ConfigParamSpec{"detect-tf0", VariantType::Bool, false, {"autodetect HBFUtils start Orbit/BC from 1st TF seen"}});
   options.push_back(ConfigParamSpec{"calculate-tf-start", VariantType::Bool, false, {"calculate TF start instead of using TType"}});
   options.push_back(ConfigParamSpec{"drop-tf", VariantType::String, "none", {"Drop each TFid%(1)==(2) of detector, e.g. ITS,2,4;TPC,4[,0];..."}});
@@ -62,6 +65,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   rinp.spSize = uint64_t(configcontext.options().get<int64_t>("super-page-size"));
   rinp.partPerSP = !configcontext.options().get<bool>("part-per-hbf");
   rinp.cache = configcontext.options().get<bool>("cache-data");
+  rinp.mmap = configcontext.options().get<bool>("mmap");
+  rinp.nThreads = configcontext.options().get<int>("preprocess-threads");
+  rinp.indexFile = configcontext.options().get<std::string>("index-file");
   rinp.autodetectTF0 = configcontext.options().get<bool>("detect-tf0");
   rinp.preferCalcTF = configcontext.options().get<bool>("calculate-tf-start");
   rinp.rawChannelConfig = configcontext.options().get<std::string>("raw-channel-config");
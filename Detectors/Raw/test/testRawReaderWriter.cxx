@@ -13,6 +13,9 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -190,9 +193,12 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
 
   std::unique_ptr<RawFileReader> reader;
   std::string confName;
+  std::string indexName;
+  bool mmap = false;
+  int nThreads = 1;
 
   //_________________________________________________________________
-  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg") : confName(cfg) {}
+  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg", const std::string& idx = "") : confName(cfg), indexName(idx) {}
 
   //_________________________________________________________________
   void init()
@@ -201,6 +207,9 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
     uint32_t errCheck = 0xffffffff;
     errCheck ^= 0x1 << RawFileReader::ErrNoSuperPageForTF; // makes no sense for superpages not interleaved by others
     reader->setCheckErrors(errCheck);
+    reader->setIndexFile(indexName);
+    reader->setUseMMap(mmap);
+    reader->setNThreads(nThreads);
     reader->init();
   }
 
@@ -308,6 +317,23 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
   } // run
 };
 
+// check that 2 readers of the same input built the same index of the data blocks
+void checkSameIndex(const RawFileReader& ref, const RawFileReader& test)
+{
+  BOOST_REQUIRE(ref.getNLinks() == test.getNLinks());
+  BOOST_CHECK(ref.getNTimeFrames() == test.getNTimeFrames());
+  for (int il = 0; il < ref.getNLinks(); il++) {
+    const auto &lr = ref.getLink(il), &lt = test.getLink(il);
+    BOOST_CHECK(lr.spec == lt.spec && lr.nTimeFrames == lt.nTimeFrames && lr.nHBFrames == lt.nHBFrames && lr.nSPages == lt.nSPages);
+    BOOST_CHECK(lr.nCRUPages == lt.nCRUPages && lr.nErrors == lt.nErrors);
+    BOOST_REQUIRE(lr.blocks.size() == lt.blocks.size());
+    for (size_t ib = 0; ib < lr.blocks.size(); ib++) {
+      const auto &br = lr.blocks[ib], &bt = lt.blocks[ib];
+      BOOST_CHECK(br.offset == bt.offset && br.size == bt.size && br.tfID == bt.tfID && br.ir == bt.ir && br.fileID == bt.fileID && br.flags == bt.flags);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU)
 {
   TestRawWriter dw{"TST", true, "test_raw_conf_GBT.cfg"}; // this is a CRU detector with origin TST
@@ -318,6 +344,40 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU)
   dr.init();
   dr.run(); // read back and check
 
+  // 1st reader stores the index file, 2nd one reuses it instead of scanning the files
+  std::remove("test_raw_GBT.idx");
+  for (int i = 0; i < 2; i++) {
+    TestRawReader dri{"TST", "test_raw_conf_GBT.cfg", "test_raw_GBT.idx"};
+    dri.init();
+    BOOST_CHECK(dri.reader->isIndexLoaded() == (i == 1));
+    BOOST_CHECK(dri.reader->getNTimeFrames() == dr.reader->getNTimeFrames());
+    dri.run();
+  }
+
+  // memory-mapped files preprocessed by several threads must give the same index as the sequential scan
+  {
+    TestRawReader drm{"TST", "test_raw_conf_GBT.cfg"};
+    drm.mmap = true;
+    drm.nThreads = 4;
+    drm.init();
+    BOOST_CHECK(drm.reader->isMapped(0));
+    checkSameIndex(*dr.reader, *drm.reader);
+    drm.run();
+
+    // superpage accessed w/o copy stays valid after the reader which mapped it is gone
+    auto& lnk = drm.reader->getLink(0);
+    auto& lnkRef = dr.reader->getLink(0);
+    BOOST_REQUIRE(lnk.rewindToTF(0) && lnkRef.rewindToTF(0));
+    const char* spData = nullptr;
+    std::shared_ptr<const void> mapping;
+    auto spSize = lnk.mapNextSuperPage(spData, mapping);
+    BOOST_REQUIRE(spSize > 0 && spData && mapping);
+    drm.reader.reset();
+    std::vector<char> spRef(spSize);
+    BOOST_CHECK(lnkRef.readNextSuperPage(spRef.data()) == spSize);
+    BOOST_CHECK(std::memcmp(spRef.data(), spData, spSize) == 0);
+  }
+
   // test SimpleReader
   int nLoops = 5;
   SimpleRawReader sr(dr.confName, false, nLoops);
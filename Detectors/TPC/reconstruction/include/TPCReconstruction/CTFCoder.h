@@ -218,10 +218,11 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
 
-  auto encodeTPC = [&buff, &optField, &coders = mCoders](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  o2::ctf::ConcurrentBlocksEncoder<CTF, VEC> blocksEncoder(buff, mNThreads, getAutoEncoding());
+  auto encodeTPC = [&blocksEncoder, &optField, &coders = mCoders](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
     const auto slotVal = static_cast<int>(slot);
-    CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal].get());
+    blocksEncoder.add(begin, end, slotVal, probabilityBits, optField[slotVal], coders[slotVal].get());
   };
 
   if (mCombineColumns) {
@@ -286,6 +287,7 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
 
   encodeTPC(ccl.nTrackClusters, ccl.nTrackClusters + ccl.nTracks, CTF::BLCnTrackClusters, 0);
   encodeTPC(ccl.nSliceRowClusters, ccl.nSliceRowClusters + ccl.nSliceRows, CTF::BLCnSliceRowClusters, 0);
+  blocksEncoder.encode();
   CTF::get(buff.data())->print(getPrefix());
 }
 
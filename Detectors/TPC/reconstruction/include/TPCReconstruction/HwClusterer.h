@@ -81,6 +81,15 @@ class HwClusterer : public Clusterer
   void finishProcess(gsl::span<o2::tpc::Digit const> const& digits, ConstMCLabelContainerView const& mcDigitTruth) override;
   void finishProcess(gsl::span<o2::tpc::Digit const> const& digits, ConstMCLabelContainerView const& mcDigitTruth, bool clearContainerFirst);
 
+  /// Process the digits of several sectors concurrently, clusterers share no data and fill their own output containers.
+  /// For each clusterer it is equivalent to process(digits, mcDigitTruth, true) followed by finishProcess({}, {}, false)
+  /// \param clusterers Clusterers of the sectors to process
+  /// \param digits Containers with TPC digits of each sector
+  /// \param mcDigitTruth MC Digit Truth containers of each sector, empty if MC is not processed
+  /// \param nThreads Number of sectors processed in parallel
+  static void processSectors(std::vector<HwClusterer*> const& clusterers, std::vector<gsl::span<o2::tpc::Digit const>> const& digits,
+                             std::vector<ConstMCLabelContainerView> const& mcDigitTruth, int nThreads);
+
   /// Switch for triggered / continuous readout
   /// \param isContinuous - false for triggered readout, true for continuous readout
   void setContinuousReadout(bool isContinuous);
@@ -24,6 +24,7 @@
 #include "TPCFastTransform.h"
 #include "Rtypes.h"
 #include <functional>
+#include <vector>
 
 namespace o2
 {
@@ -61,6 +62,14 @@ class TPCFastTransformHelperO2
     mSpaceChargeCorrection = spaceChargeCorrection;
   };
 
+  /// set an external space charge correction in the global coordinates, which evaluates a batch of points at once.
+  /// When set, it is used instead of the point-wise correction to fill the correction splines.
+  template <typename F>
+  void setSpaceChargeCorrectionBatch(F&& spaceChargeCorrectionBatch)
+  {
+    mSpaceChargeCorrectionBatch = spaceChargeCorrectionBatch;
+  };
+
   /// creates TPCFastTransform object
   std::unique_ptr<TPCFastTransform> create(Long_t TimeStamp);
 
@@ -76,13 +85,18 @@ class TPCFastTransformHelperO2
   void init();
   /// get space charge correction in internal TPCFastTransform coordinates su,sv->dx,du,dv
   int getSpaceChargeCorrection(int slice, int row, double su, double sv, double& dx, double& du, double& dv);
+  /// get space charge correction in internal TPCFastTransform coordinates for a batch of points su,sv->dx,du,dv
+  void getSpaceChargeCorrectionBatch(int slice, int row, const std::vector<double>& su, const std::vector<double>& sv, std::vector<double> dxuv[3]);
+  /// check if an external space charge correction is set
+  bool isSpaceChargeCorrectionSet() const { return mSpaceChargeCorrection || mSpaceChargeCorrectionBatch; }
 
   static TPCFastTransformHelperO2* sInstance;                                                  ///< singleton instance
   bool mIsInitialized = 0;                                                                     ///< initialization flag
   std::function<void(int roc, const double XYZ[3], double dXdYdZ[3])> mSpaceChargeCorrection = nullptr; ///< pointer to an external correction method
+  std::function<void(int roc, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, std::vector<double>& dx, std::vector<double>& dy, std::vector<double>& dz)> mSpaceChargeCorrectionBatch = nullptr; ///< pointer to an external correction method for a batch of points
   TPCFastTransformGeo mGeo;                                                                    ///< geometry parameters
 
-  ClassDefNV(TPCFastTransformHelperO2, 2);
+  ClassDefNV(TPCFastTransformHelperO2, 3);
 };
 } // namespace tpc
 } // namespace o2
@@ -24,6 +24,10 @@
 #include <cassert>
 #include <limits>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::tpc;
 
 //______________________________________________________________________________
@@ -286,6 +290,24 @@ void HwClusterer::finishProcess(gsl::span<o2::tpc::Digit const> const& digits, C
   finishFrame(false);
 }
 
+//______________________________________________________________________________
+void HwClusterer::processSectors(std::vector<HwClusterer*> const& clusterers, std::vector<gsl::span<o2::tpc::Digit const>> const& digits,
+                                 std::vector<ConstMCLabelContainerView> const& mcDigitTruth, int nThreads)
+{
+  assert(digits.size() == clusterers.size() && (mcDigitTruth.empty() || mcDigitTruth.size() == clusterers.size()));
+  const int nSectors = clusterers.size();
+  const std::vector<o2::tpc::Digit> emptyDigits;
+  const ConstMCLabelContainerView emptyLabels;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads > 0 ? nThreads : 1)
+#endif
+  for (int isec = 0; isec < nSectors; isec++) {
+    auto* clusterer = clusterers[isec];
+    clusterer->process(digits[isec], mcDigitTruth.empty() ? emptyLabels : mcDigitTruth[isec], true);
+    clusterer->finishProcess(emptyDigits, emptyLabels, false);
+  }
+}
+
 //______________________________________________________________________________
 void HwClusterer::hwClusterProcessor(const Vc::uint_m peakMask, unsigned qMaxIndex, short centerPad, int centerTime, unsigned short row)
 {
@@ -134,7 +134,7 @@ std::unique_ptr<TPCFastTransform> TPCFastTransformHelperO2::create(Long_t TimeSt
     for (int scenario = 0; scenario < nCorrectionScenarios; scenario++) {
       int row = scenario * 10;
       TPCFastSpaceChargeCorrection::SplineType spline;
-      if (!mSpaceChargeCorrection || row >= nRows) {
+      if (!isSpaceChargeCorrectionSet() || row >= nRows) {
         spline.recreate(8, 20);
       } else {
         // TODO: update the calibrator
@@ -262,17 +262,25 @@ int TPCFastTransformHelperO2::updateCalibration(TPCFastTransform& fastTransform,
 
   // for the future: switch TOF correction off for a while
 
-  if (mSpaceChargeCorrection) {
+  if (isSpaceChargeCorrectionSet()) {
     for (int slice = 0; slice < correction.getGeometry().getNumberOfSlices(); slice++) {
       for (int row = 0; row < correction.getGeometry().getNumberOfRows(); row++) {
         const TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
         float* data = correction.getSplineData(slice, row);
         Spline2DHelper<float> helper;
         helper.setSpline(spline, 3, 3);
-        auto F = [&](double su, double sv, double dxuv[3]) {
-          getSpaceChargeCorrection(slice, row, su, sv, dxuv[0], dxuv[1], dxuv[2]);
-        };
-        helper.approximateFunction(data, 0., 1., 0., 1., F);
+        if (mSpaceChargeCorrectionBatch) {
+          // evaluate all data points of the row at once
+          auto F = [&](const std::vector<double>& su, const std::vector<double>& sv, std::vector<double> dxuv[3]) {
+            getSpaceChargeCorrectionBatch(slice, row, su, sv, dxuv);
+          };
+          helper.approximateFunctionBatch(data, 0., 1., 0., 1., F, helper.getNumberOfDataPoints());
+        } else {
+          auto F = [&](double su, double sv, double dxuv[3]) {
+            getSpaceChargeCorrection(slice, row, su, sv, dxuv[0], dxuv[1], dxuv[2]);
+          };
+          helper.approximateFunction(data, 0., 1., 0., 1., F);
+        }
       } // row
     }   // slice
     correction.initInverse();
@@ -341,6 +349,67 @@ int TPCFastTransformHelperO2::getSpaceChargeCorrection(int slice, int row, doubl
   return 0;
 }
 
+void TPCFastTransformHelperO2::getSpaceChargeCorrectionBatch(int slice, int row, const std::vector<double>& su, const std::vector<double>& sv, std::vector<double> dxuv[3])
+{
+  // get space charge correction in internal TPCFastTransform coordinates for a batch of points su,sv->dx,du,dv
+
+  if (!mIsInitialized) {
+    init();
+  }
+
+  const size_t nPoints = su.size();
+  for (int iDim = 0; iDim < 3; ++iDim) {
+    dxuv[iDim].assign(nPoints, 0.);
+  }
+
+  if (!mSpaceChargeCorrectionBatch) {
+    return;
+  }
+
+  const TPCFastTransformGeo::RowInfo& rowInfo = mGeo.getRowInfo(row);
+
+  const float x = rowInfo.x;
+
+  // global coordinates of the points
+  std::vector<double> gx(nPoints);
+  std::vector<double> gy(nPoints);
+  std::vector<double> gz(nPoints);
+  std::vector<float> u(nPoints);
+  std::vector<float> v(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    mGeo.convScaledUVtoUV(slice, row, su[i], sv[i], u[i], v[i]);
+    float y = 0, z = 0;
+    mGeo.convUVtoLocal(slice, u[i], v[i], y, z);
+    float gxTmp, gyTmp, gzTmp;
+    mGeo.convLocalToGlobal(slice, x, y, z, gxTmp, gyTmp, gzTmp);
+    gx[i] = gxTmp;
+    gy[i] = gyTmp;
+    gz[i] = gzTmp;
+  }
+
+  std::vector<double> dgx;
+  std::vector<double> dgy;
+  std::vector<double> dgz;
+  mSpaceChargeCorrectionBatch(slice, gx, gy, gz, dgx, dgy, dgz);
+
+  for (size_t i = 0; i < nPoints; ++i) {
+    // corrections in the local coordinates
+    const float gx1 = gx[i] + dgx[i];
+    const float gy1 = gy[i] + dgy[i];
+    const float gz1 = gz[i] + dgz[i];
+    float x1, y1, z1;
+    mGeo.convGlobalToLocal(slice, gx1, gy1, gz1, x1, y1, z1);
+
+    // correction corrections in u,v
+    float u1 = 0, v1 = 0;
+    mGeo.convLocalToUV(slice, y1, z1, u1, v1);
+
+    dxuv[0][i] = x1 - x;
+    dxuv[1][i] = u1 - u[i];
+    dxuv[2][i] = v1 - v[i];
+  }
+}
+
 void TPCFastTransformHelperO2::testGeometry(const TPCFastTransformGeo& geo) const
 {
   const Mapper& mapper = Mapper::instance();
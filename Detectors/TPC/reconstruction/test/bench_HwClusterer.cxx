@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_HwClusterer.cxx
+/// \brief  Benchmark of the concurrent clusterization of the TPC sectors by the HwClusterer
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsTPC/Digit.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/Sector.h"
+#include "TPCReconstruction/HwClusterer.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2::tpc;
+
+// Pb-Pb like occupancy: charge blobs of 3 pads x 5 time bins at random positions of every sector, sorted in time
+std::vector<std::vector<Digit>> generateDigits(int nBlobsPerSector, int nTimeBins)
+{
+  constexpr int NSectors = Sector::MAXSECTOR;
+  const auto& mapper = Mapper::instance();
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rndRow(0, Mapper::PADROWS - 1), rndTime(2, nTimeBins - 3);
+  std::uniform_real_distribution<float> rndCharge(20.f, 200.f);
+  std::vector<std::vector<Digit>> digits(NSectors);
+  for (int sector = 0; sector < NSectors; sector++) {
+    auto& sectorDigits = digits[sector];
+    for (int iBlob = 0; iBlob < nBlobsPerSector; iBlob++) {
+      const int row = rndRow(gen), time = rndTime(gen);
+      const int cru = sector * Mapper::NREGIONS + Mapper::REGION[row];
+      const int pad = std::uniform_int_distribution<int>(1, mapper.getNumberOfPadsInRowSector(row) - 2)(gen);
+      const float qMax = rndCharge(gen);
+      for (int dp = -1; dp <= 1; dp++) {
+        for (int dt = -2; dt <= 2; dt++) {
+          sectorDigits.emplace_back(cru, qMax / float((1 + std::abs(dp)) * (1 + std::abs(dt))), row, pad + dp, time + dt);
+        }
+      }
+    }
+    std::stable_sort(sectorDigits.begin(), sectorDigits.end(), [](const auto& a, const auto& b) { return a.getTimeStamp() < b.getTimeStamp(); });
+  }
+  return digits;
+}
+
+static void BM_HwClustererSectors(benchmark::State& state)
+{
+  constexpr int NSectors = Sector::MAXSECTOR;
+  const auto digits = generateDigits(state.range(0), 2000);
+  std::vector<std::vector<ClusterHardwareContainer8kb>> clusterArrays(NSectors);
+  std::vector<o2::dataformats::MCLabelContainer> mctruthArrays(NSectors);
+  std::vector<std::unique_ptr<HwClusterer>> clusterers;
+  std::vector<HwClusterer*> clustererPtrs;
+  std::vector<gsl::span<Digit const>> sectorDigits;
+  for (int sector = 0; sector < NSectors; sector++) {
+    clusterers.emplace_back(std::make_unique<HwClusterer>(&clusterArrays[sector], sector, &mctruthArrays[sector]));
+    clusterers.back()->init();
+    clusterers.back()->setContinuousReadout(false);
+    clustererPtrs.push_back(clusterers.back().get());
+    sectorDigits.emplace_back(digits[sector]);
+  }
+  const std::vector<o2::dataformats::ConstMCLabelContainerView> sectorMCLabels(NSectors);
+
+  size_t nClusters = 0;
+  for (auto _ : state) {
+    HwClusterer::processSectors(clustererPtrs, sectorDigits, sectorMCLabels, state.range(1));
+    nClusters = 0;
+    for (const auto& clusterArray : clusterArrays) {
+      for (const auto& container : clusterArray) {
+        nClusters += container.getContainer()->numberOfClusters;
+      }
+    }
+  }
+  state.counters["clusters/s"] = benchmark::Counter(double(nClusters) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// args: number of charge blobs per sector, number of threads
+BENCHMARK(BM_HwClustererSectors)->Args({10000, 1})->Args({10000, 4})->Args({10000, 8})->Args({10000, 36})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
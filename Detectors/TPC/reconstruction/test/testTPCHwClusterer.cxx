@@ -28,6 +28,7 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <random>
 
 using MCLabelContainer = o2::dataformats::MCLabelContainer;
 
@@ -1003,5 +1004,95 @@ BOOST_AUTO_TEST_CASE(HwClusterer_test6)
   std::cout << "##" << std::endl
             << std::endl;
 }
+
+/// @brief Test 7 concurrent processing of several sectors
+BOOST_AUTO_TEST_CASE(HwClusterer_test7)
+{
+  std::cout << "##" << std::endl;
+  std::cout << "## Starting test 7, concurrent processing of several sectors." << std::endl;
+  const int nSectors = 8, nBlobs = 2000, nTimeBins = 500;
+  const auto& mapper = Mapper::instance();
+
+  // charge blobs of 3 pads x 5 time bins at random positions of every sector, sorted in time, each labeled by its blob
+  std::vector<std::vector<o2::tpc::Digit>> digits(nSectors);
+  std::vector<o2::dataformats::ConstMCLabelContainer> flatLabels(nSectors);
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rndRow(0, Mapper::PADROWS - 1), rndTime(2, nTimeBins - 3);
+  std::uniform_real_distribution<float> rndCharge(20.f, 200.f);
+  for (int sector = 0; sector < nSectors; ++sector) {
+    std::vector<std::pair<o2::tpc::Digit, int>> labeledDigits;
+    for (int blob = 0; blob < nBlobs; ++blob) {
+      const int row = rndRow(gen), time = rndTime(gen);
+      const int cru = sector * Mapper::NREGIONS + Mapper::REGION[row];
+      const int pad = std::uniform_int_distribution<int>(1, mapper.getNumberOfPadsInRowSector(row) - 2)(gen);
+      const float qMax = rndCharge(gen);
+      for (int dp = -1; dp <= 1; ++dp) {
+        for (int dt = -2; dt <= 2; ++dt) {
+          labeledDigits.emplace_back(o2::tpc::Digit(cru, qMax / float((1 + std::abs(dp)) * (1 + std::abs(dt))), row, pad + dp, time + dt), blob);
+        }
+      }
+    }
+    std::stable_sort(labeledDigits.begin(), labeledDigits.end(), [](const auto& a, const auto& b) { return a.first.getTimeStamp() < b.first.getTimeStamp(); });
+    MCLabelContainer labels;
+    for (size_t i = 0; i < labeledDigits.size(); ++i) {
+      digits[sector].push_back(labeledDigits[i].first);
+      labels.addElement(i, o2::MCCompLabel(labeledDigits[i].second, 0, sector));
+    }
+    labels.flatten_to(flatLabels[sector]);
+  }
+  std::vector<gsl::span<o2::tpc::Digit const>> sectorDigits(digits.begin(), digits.end());
+  std::vector<o2::dataformats::ConstMCLabelContainerView> sectorLabels(flatLabels.begin(), flatLabels.end());
+
+  // clusters and labels found by sequentially processed clusterers are the reference
+  std::vector<std::vector<ClusterHardwareContainer8kb>> refClusters(nSectors);
+  std::vector<MCLabelContainer> refLabels(nSectors);
+  for (int sector = 0; sector < nSectors; ++sector) {
+    o2::tpc::HwClusterer clusterer(&refClusters[sector], sector, &refLabels[sector]);
+    clusterer.init();
+    clusterer.setContinuousReadout(false);
+    clusterer.process(sectorDigits[sector], sectorLabels[sector], true);
+    clusterer.finishProcess({}, {}, false);
+    BOOST_CHECK(refClusters[sector].size() > 0);
+  }
+
+  for (int nThreads : {1, 4}) {
+    std::cout << "testing with " << nThreads << " thread(s)..." << std::endl;
+    std::vector<std::vector<ClusterHardwareContainer8kb>> clusters(nSectors);
+    std::vector<MCLabelContainer> labels(nSectors);
+    std::vector<std::unique_ptr<o2::tpc::HwClusterer>> clusterers;
+    std::vector<o2::tpc::HwClusterer*> clustererPtrs;
+    for (int sector = 0; sector < nSectors; ++sector) {
+      clusterers.emplace_back(std::make_unique<o2::tpc::HwClusterer>(&clusters[sector], sector, &labels[sector]));
+      clusterers.back()->init();
+      clusterers.back()->setContinuousReadout(false);
+      clustererPtrs.push_back(clusterers.back().get());
+    }
+    o2::tpc::HwClusterer::processSectors(clustererPtrs, sectorDigits, sectorLabels, nThreads);
+
+    for (int sector = 0; sector < nSectors; ++sector) {
+      BOOST_REQUIRE_EQUAL(clusters[sector].size(), refClusters[sector].size());
+      for (size_t ic = 0; ic < clusters[sector].size(); ++ic) {
+        const auto *container = clusters[sector][ic].getContainer(), *refContainer = refClusters[sector][ic].getContainer();
+        BOOST_CHECK_EQUAL(container->CRU, refContainer->CRU);
+        BOOST_CHECK_EQUAL(container->timeBinOffset, refContainer->timeBinOffset);
+        BOOST_REQUIRE_EQUAL(container->numberOfClusters, refContainer->numberOfClusters);
+        for (int icl = 0; icl < container->numberOfClusters; ++icl) {
+          const auto &cl = container->clusters[icl], &refCl = refContainer->clusters[icl];
+          BOOST_CHECK(cl.word0 == refCl.word0 && cl.word1 == refCl.word1 && cl.word2 == refCl.word2 && cl.word3 == refCl.word3 && cl.word4 == refCl.word4);
+        }
+      }
+      BOOST_REQUIRE_EQUAL(labels[sector].getIndexedSize(), refLabels[sector].getIndexedSize());
+      BOOST_CHECK_EQUAL(labels[sector].getNElements(), refLabels[sector].getNElements());
+      for (size_t il = 0; il < labels[sector].getIndexedSize(); ++il) {
+        auto lbl = labels[sector].getLabels(il), refLbl = refLabels[sector].getLabels(il);
+        BOOST_CHECK(std::equal(lbl.begin(), lbl.end(), refLbl.begin(), refLbl.end()));
+      }
+    }
+  }
+
+  std::cout << "## Test 7 done." << std::endl;
+  std::cout << "##" << std::endl
+            << std::endl;
+}
 } // namespace tpc
 } // namespace o2
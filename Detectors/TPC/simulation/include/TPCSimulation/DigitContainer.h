@@ -37,7 +37,8 @@ class DigitMCMetaData;
 /// This is the base class of the intermediate Digit Containers, in which all incoming electrons from the hits are
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
-/// This class holds the CRU containers.
+/// This class holds the time bin containers, which only store the occupied pads. In continuous readout the time bins
+/// before the current event are written out and released at each flush.
 
 class DigitContainer
 {
@@ -77,9 +78,25 @@ class DigitContainer
   /// \param finalFlush Flag whether the whole container is dumped
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
 
+  /// Move the content of another container into this one, the time bins of the other container are cleared
+  /// The other container must not start before this one
+  /// \param other Container to be merged
+  void merge(DigitContainer& other);
+
+  /// Drop the leading time bins to start at a given time bin, used to follow a container which was flushed
+  /// \param timeBin New first time bin
+  void dropTimeBinsBefore(TimeBin timeBin);
+
+  /// Get the first time bin of the container
+  TimeBin getFirstTimeBin() const { return mFirstTimeBin; }
+
   /// Get the size of the container for one event
   size_t size() const { return mTimeBins.size(); }
 
+  /// Get the memory allocated by the time bins of the container
+  /// \return Allocated memory in bytes
+  size_t getAllocatedMemory() const;
+
  private:
   TimeBin mFirstTimeBin = 0;       ///< First time bin to consider
   TimeBin mEffectiveTimeBin = 0;   ///< Effective time bin of that digit
@@ -116,6 +133,37 @@ inline void DigitContainer::reserve(TimeBin eventTimeBin)
   }
 }
 
+inline void DigitContainer::merge(DigitContainer& other)
+{
+  const size_t offset = other.mFirstTimeBin - mFirstTimeBin;
+  if (mTimeBins.size() < offset + other.mTimeBins.size()) {
+    mTimeBins.resize(offset + other.mTimeBins.size());
+  }
+  for (size_t i = 0; i < other.mTimeBins.size(); ++i) {
+    if (other.mTimeBins[i].hasDigits()) {
+      mTimeBins[offset + i].merge(other.mTimeBins[i]);
+    }
+  }
+}
+
+inline void DigitContainer::dropTimeBinsBefore(TimeBin timeBin)
+{
+  while (mFirstTimeBin < timeBin && !mTimeBins.empty()) {
+    mTimeBins.pop_front();
+    ++mFirstTimeBin;
+  }
+  mFirstTimeBin = timeBin;
+}
+
+inline size_t DigitContainer::getAllocatedMemory() const
+{
+  size_t memory = sizeof(DigitContainer);
+  for (const auto& time : mTimeBins) {
+    memory += time.getAllocatedMemory();
+  }
+  return memory;
+}
+
 inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, TimeBin timeBin, GlobalPadNumber globalPad,
                                      float signal)
 {
@@ -66,6 +66,14 @@ class DigitGlobalPad
   void addDigit(const MCCompLabel& label, float signal,
                 o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>&);
 
+  /// Add the charge and the MC labels of the same pad in another container
+  /// \param other Pad to be added
+  /// \param otherLabels Label container of the other pad
+  /// \param labels Label container of this pad
+  void merge(const DigitGlobalPad& other,
+             o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& otherLabels,
+             o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels);
+
   void setID(int id) { mID = id; }
   int getID() const { return mID; }
 
@@ -115,6 +123,27 @@ inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
   mChargePad += signal;
 }
 
+inline void DigitGlobalPad::merge(const DigitGlobalPad& other,
+                                  o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& otherLabels,
+                                  o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels)
+{
+  // labels keep the order of their first occurrence, as if the digits of the other pad were added after the ones of this pad
+  for (const auto& otherLabel : otherLabels.getLabels(other.mID)) {
+    bool isKnown = false;
+    for (auto& mcLabel : labels.getLabels(mID)) {
+      if (compareMClabels(otherLabel.first, mcLabel.first)) {
+        mcLabel.second += otherLabel.second;
+        isKnown = true;
+        break;
+      }
+    }
+    if (!isKnown) {
+      labels.addLabel(mID, otherLabel);
+    }
+  }
+  mChargePad += other.mChargePad;
+}
+
 inline void DigitGlobalPad::reset()
 {
   mChargePad = 0;
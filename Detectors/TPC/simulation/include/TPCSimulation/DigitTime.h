@@ -21,6 +21,10 @@
 #include "SimulationDataFormat/LabelContainer.h"
 #include "TPCSimulation/CommonMode.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 namespace o2
 {
 namespace tpc
@@ -33,7 +37,9 @@ class DigitMCMetaData;
 /// This is the second class of the intermediate Digit Containers, in which all incoming electrons from the hits are
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
-/// This class holds the individual Pad Row containers and is contained within the CRU Container.
+/// This class holds the occupied pads of one time bin, their memory is proportional to the occupancy. The pads are
+/// found via an open-addressing hash table and are sorted by their global pad number when written out. The MC labels
+/// of all pads are stored in one label container of the time bin.
 
 class DigitTime
 {
@@ -44,9 +50,12 @@ class DigitTime
   /// Destructor
   ~DigitTime() = default;
 
-  /// Resets the container
+  /// Resets the container, the allocated memory is kept
   void reset();
 
+  /// Check whether digits were added to this time bin
+  bool hasDigits() const { return !mGlobalPads.empty(); }
+
   /// Get common mode for a given GEM stack
   /// \param gemstack GEM stack of the digit
   /// \return Common mode value in that time bin for a given GEM ROC
@@ -65,6 +74,14 @@ class DigitTime
   /// \param signal Charge of the digit in ADC counts
   void addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal);
 
+  /// Add the content of another time bin (charges, MC labels and common mode), the other time bin is reset
+  /// \param other Time bin to be merged into this one
+  void merge(DigitTime& other);
+
+  /// Get the memory allocated by the time bin
+  /// \return Allocated memory in bytes
+  size_t getAllocatedMemory() const;
+
   /// Fill output vector
   /// \param output Output container
   /// \param mcTruth MC Truth container
@@ -77,40 +94,88 @@ class DigitTime
                            std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin, float commonMode = 0.f);
 
  private:
-  std::array<float, GEMSTACKSPERSECTOR> mCommonMode;                 ///< Common mode container - 4 GEM ROCs per sector
-  std::array<DigitGlobalPad, Mapper::getPadsInSector()> mGlobalPads; ///< Pad Container for the ADC value
-  int mDigitCounter = 0;                                             ///< counts the number of digits in this timebin
+  /// Get the occupied pad with the given number, the pad is added if it is not yet occupied
+  /// \param globalPad Global pad number
+  /// \return Pad container, its ID is the index in the list of occupied pads
+  DigitGlobalPad& getPad(GlobalPadNumber globalPad);
+
+  /// Double the size of the hash table of the occupied pads
+  void growPadLookup();
+
+  static unsigned int hashPad(GlobalPadNumber globalPad) { return (globalPad * 0x9E3779B1u) >> 16; }
+
+  std::array<float, GEMSTACKSPERSECTOR> mCommonMode; ///< Common mode container - 4 GEM ROCs per sector
+  std::vector<DigitGlobalPad> mGlobalPads;           ///< Occupied pads, in the order of their first digit
+  std::vector<GlobalPadNumber> mPadNumbers;          ///< Global pad numbers of the occupied pads
+  std::vector<unsigned int> mPadLookup;              ///< Hash table of the occupied pads, (globalPad + 1) << 16 | ID, 0 for empty slots
 
   o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
-  // std::deque<int> mOccupiedPads; // iterable container of occupied pads
 };
 
-inline DigitTime::DigitTime() : mCommonMode(), mGlobalPads()
+inline DigitTime::DigitTime() : mCommonMode()
 {
   mCommonMode.fill(0.f);
-  mLabels.reserve(Mapper::getPadsInSector() / 3);
 }
 
-inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
+inline DigitGlobalPad& DigitTime::getPad(GlobalPadNumber globalPad)
 {
-  auto& paddigit = mGlobalPads[globalPad];
-  if (paddigit.getID() == -1) {
-    // this means we have a new digit
-    paddigit.setID(mDigitCounter++);
-    // could also register this pad in a vector of digits
+  if (2 * (mGlobalPads.size() + 1) > mPadLookup.size()) {
+    growPadLookup();
+  }
+  const unsigned int mask = mPadLookup.size() - 1;
+  const unsigned int key = (static_cast<unsigned int>(globalPad) + 1) << 16;
+  for (unsigned int slot = hashPad(globalPad) & mask;; slot = (slot + 1) & mask) {
+    const unsigned int entry = mPadLookup[slot];
+    if (entry == 0) {
+      // this means we have a new digit
+      const unsigned int id = mGlobalPads.size();
+      mPadLookup[slot] = key | id;
+      mPadNumbers.push_back(globalPad);
+      auto& paddigit = mGlobalPads.emplace_back();
+      paddigit.setID(id);
+      return paddigit;
+    }
+    if ((entry & 0xffff0000u) == key) {
+      return mGlobalPads[entry & 0xffffu];
+    }
   }
-  paddigit.addDigit(label, signal, mLabels);
+}
+
+inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
+{
+  getPad(globalPad).addDigit(label, signal, mLabels);
   mCommonMode[cru.gemStack()] += signal;
 }
 
 inline void DigitTime::reset()
 {
-  for (auto& pad : mGlobalPads) {
-    pad.reset();
-  }
+  mGlobalPads.clear();
+  mPadNumbers.clear();
+  std::fill(mPadLookup.begin(), mPadLookup.end(), 0u);
+  mLabels.clear();
   mCommonMode.fill(0.f);
 }
 
+inline void DigitTime::merge(DigitTime& other)
+{
+  if (!other.hasDigits()) {
+    return;
+  }
+  for (size_t i = 0; i < other.mGlobalPads.size(); ++i) {
+    getPad(other.mPadNumbers[i]).merge(other.mGlobalPads[i], other.mLabels, mLabels);
+  }
+  for (size_t i = 0; i < mCommonMode.size(); ++i) {
+    mCommonMode[i] += other.mCommonMode[i];
+  }
+  other.reset();
+}
+
+inline size_t DigitTime::getAllocatedMemory() const
+{
+  return sizeof(DigitTime) + mGlobalPads.capacity() * sizeof(DigitGlobalPad) + mPadNumbers.capacity() * sizeof(GlobalPadNumber) +
+         mPadLookup.capacity() * sizeof(unsigned int) + mLabels.getAllocatedMemory();
+}
+
 inline float DigitTime::getCommonMode(const GEMstack& gemstack) const
 {
   /// simple case when there is no external capacitance on the ROC
@@ -125,19 +190,23 @@ inline void DigitTime::fillOutputContainer(std::vector<Digit>& output, dataforma
                                            float commonMode)
 {
   static Mapper& mapper = Mapper::instance();
-  GlobalPadNumber globalPad = 0;
   for (size_t i = 0; i < mCommonMode.size(); ++i) {
     const float cm = getCommonMode(GEMstack(i));
     if (cm > 0.) {
       commonModeOutput.push_back({cm, timeBin, static_cast<unsigned char>(i)});
     }
   }
-  for (auto& pad : mGlobalPads) {
+  /// the digits are written out ordered in global pad number
+  std::vector<unsigned int> padOrder(mGlobalPads.size()); // not static: digitizers of several lanes may flush concurrently
+  std::iota(padOrder.begin(), padOrder.end(), 0u);
+  std::sort(padOrder.begin(), padOrder.end(), [this](unsigned int a, unsigned int b) { return mPadNumbers[a] < mPadNumbers[b]; });
+  for (const auto id : padOrder) {
+    auto& pad = mGlobalPads[id];
     if (pad.getChargePad() > 0.) {
+      const GlobalPadNumber globalPad = mPadNumbers[id];
       const CRU cru = mapper.getCRU(sector, globalPad);
       pad.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, globalPad, mLabels, getCommonMode(cru));
     }
-    ++globalPad;
   }
 }
 } // namespace tpc
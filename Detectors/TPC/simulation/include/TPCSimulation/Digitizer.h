@@ -17,6 +17,8 @@
 #define ALICEO2_TPC_Digitizer_H_
 
 #include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
 #include "TPCSimulation/PadResponse.h"
 #include "TPCSimulation/Point.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
@@ -89,8 +91,23 @@ class Digitizer
   {
     mSector = sec;
     mDigitContainer.reset();
+    for (auto& digitContainer : mThreadDigitContainers) {
+      digitContainer.reset();
+    }
   }
 
+  /// Set the number of threads used for the processing of the hits of a sector
+  /// The hit groups are split in chunks which are processed concurrently into partial digit containers,
+  /// merged at flush. SAMPA processing and mapping are shared, each thread has its own copy of the random
+  /// rings of the electron transport and GEM amplification. The space-charge interpolators keep a cache per
+  /// thread, sized at their creation by SpaceCharge::getNThreads(): this must be called before the space-charge
+  /// distortions are set, otherwise the number of threads is limited to the one the interpolators were created for
+  /// \param n Number of threads
+  void setNThreads(int n);
+
+  /// Get the number of threads used for the processing of the hits of a sector
+  int getNThreads() const { return mNThreads; }
+
   /// Set the start time of the first event
   /// \param time Time of the first event
   void setStartTime(double time);
@@ -126,6 +143,20 @@ class Digitizer
   void setUseSCDistortions(TFile& finp);
 
  private:
+  /// Process a range of hit groups into a digit container
+  /// \param hits Container with TPC hit groups
+  /// \param first First hit group to process
+  /// \param last Hit group after the last one to process
+  /// \param eventID ID of the event to be processed
+  /// \param sourceID ID of the source to be processed
+  /// \param digitContainer Container for the Digits
+  /// \param electronTransport Electron transport
+  /// \param gemAmplification GEM amplification
+  /// \param signalArray Workspace for the shaped signal
+  void processHits(const std::vector<o2::tpc::HitGroup>& hits, size_t first, size_t last, const int eventID, const int sourceID,
+                   DigitContainer& digitContainer, ElectronTransport& electronTransport, GEMAmplification& gemAmplification,
+                   std::vector<float>& signalArray) const;
+
   DigitContainer mDigitContainer;    ///< Container for the Digits
   std::unique_ptr<SC> mSpaceCharge;  ///< Handler of space-charge distortions
   Sector mSector = -1;               ///< ID of the currently processed sector
@@ -134,6 +165,12 @@ class Digitizer
   // FIXME: whats the reason for hving this static?
   static bool mIsContinuous;      ///< Switch for continuous readout
   bool mUseSCDistortions = false; ///< Flag to switch on the use of space-charge distortions
+  int mNThreads = 1;              ///< Number of threads for the processing of the hits of a sector
+  int mNThreadsSC = 1;            ///< Number of threads the space-charge interpolators were created for
+  std::vector<DigitContainer> mThreadDigitContainers;      //! partial Digit containers of the threads
+  std::vector<ElectronTransport> mThreadElectronTransport; //! electron transport of the threads, with shifted random rings
+  std::vector<GEMAmplification> mThreadGEMAmplification;   //! GEM amplification of the threads, with shifted random rings
+  std::vector<std::vector<float>> mThreadSignalArrays;     //! shaped signal workspace of the threads
   ClassDefNV(Digitizer, 1);
 };
 } // namespace tpc
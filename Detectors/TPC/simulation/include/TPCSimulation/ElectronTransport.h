@@ -71,6 +71,14 @@ class ElectronTransport
   /// \return Time of the charge
   float getDriftTime(float zPos, float signChange = 1.f) const;
 
+  /// Advance the position in the random rings, used to obtain independent random streams in copies of the instance
+  /// \param n Number of values to skip
+  void skipRandomValues(size_t n)
+  {
+    mRandomGaus.skip(n);
+    mRandomFlat.skip(n);
+  }
+
  private:
   ElectronTransport();
 
@@ -89,6 +89,10 @@ class GEMAmplification
   /// \return Number of electrons after amplification in the GEM
   int getGEMMultiplication(int nElectrons, int GEM);
 
+  /// Advance the position in the random rings, used to obtain independent random streams in copies of the instance
+  /// \param n Number of values to skip
+  void skipRandomValues(size_t n);
+
  private:
   GEMAmplification();
 
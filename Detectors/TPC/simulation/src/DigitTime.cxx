@@ -16,3 +16,17 @@
 #include "TPCSimulation/DigitTime.h"
 
 using namespace o2::tpc;
+
+void DigitTime::growPadLookup()
+{
+  mPadLookup.assign(mPadLookup.empty() ? 64 : 2 * mPadLookup.size(), 0u);
+  const unsigned int mask = mPadLookup.size() - 1;
+  for (unsigned int id = 0; id < mPadNumbers.size(); ++id) {
+    const auto globalPad = mPadNumbers[id];
+    unsigned int slot = hashPad(globalPad) & mask;
+    while (mPadLookup[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    mPadLookup[slot] = ((static_cast<unsigned int>(globalPad) + 1) << 16) | id;
+  }
+}
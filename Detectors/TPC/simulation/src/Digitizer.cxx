@@ -31,6 +31,8 @@
 
 #include "FairLogger.h"
 
+#include <algorithm>
+
 ClassImp(o2::tpc::Digitizer);
 
 using namespace o2::tpc;
@@ -48,10 +50,7 @@ void Digitizer::init()
 void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
                         const int eventID, const int sourceID)
 {
-  const static Mapper& mapper = Mapper::instance();
-  auto& detParam = ParameterDetector::Instance();
   auto& eleParam = ParameterElectronics::Instance();
-  auto& gemParam = ParameterGEM::Instance();
 
   static GEMAmplification& gemAmplification = GEMAmplification::instance();
   gemAmplification.updateParameters();
@@ -61,17 +60,87 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
   sampaProcessing.updateParameters();
 
   const int nShapedPoints = eleParam.NShapedPoints;
-  const auto amplificationMode = gemParam.AmplMode;
   static std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
-  mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset));
+  const TimeBin eventTimeBin = sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset);
+  mDigitContainer.reserve(eventTimeBin);
+
+  int nChunks = std::min(mNThreads, int(hits.size()));
+  if (mUseSCDistortions) { // the threads must not exceed the per-thread caches of the space-charge interpolators
+    nChunks = std::min(nChunks, mNThreadsSC);
+  }
+  if (nChunks <= 1) {
+    processHits(hits, 0, hits.size(), eventID, sourceID, mDigitContainer, electronTransport, gemAmplification, signalArray);
+    return;
+  }
+
+  /// The copies of the electron transport and GEM amplification are created once, each with its own
+  /// position in the random rings, so that the threads use independent random streams
+  if (mThreadElectronTransport.size() != size_t(mNThreads)) {
+    mThreadElectronTransport.clear();
+    mThreadGEMAmplification.clear();
+    mThreadElectronTransport.reserve(mNThreads);
+    mThreadGEMAmplification.reserve(mNThreads);
+    for (int ithread = 0; ithread < mNThreads; ++ithread) {
+      const size_t shift = ithread * (o2::math_utils::RandomRing<>::size() / mNThreads);
+      mThreadElectronTransport.push_back(electronTransport);
+      mThreadElectronTransport.back().skipRandomValues(shift);
+      mThreadGEMAmplification.push_back(gemAmplification);
+      mThreadGEMAmplification.back().skipRandomValues(shift);
+    }
+  }
+
+  /// Split the hit groups in chunks with a similar number of hits, chunk i is always processed with
+  /// the random streams of thread i, such that the result does not depend on the scheduling
+  size_t nHits = 0;
+  for (const auto& hitGroup : hits) {
+    nHits += hitGroup.getSize();
+  }
+  std::vector<size_t> chunkStart(nChunks + 1, hits.size());
+  chunkStart[0] = 0;
+  size_t nHitsSeen = 0;
+  for (size_t igroup = 0, ichunk = 1; igroup < hits.size() && ichunk < size_t(nChunks); ++igroup) {
+    nHitsSeen += hits[igroup].getSize();
+    if (nHitsSeen * nChunks >= nHits * ichunk) {
+      chunkStart[ichunk++] = igroup + 1;
+    }
+  }
+
+  for (int ichunk = 0; ichunk < nChunks; ++ichunk) {
+    mThreadDigitContainers[ichunk].reserve(eventTimeBin);
+    mThreadElectronTransport[ichunk].updateParameters();
+    mThreadGEMAmplification[ichunk].updateParameters();
+    mThreadSignalArrays[ichunk].resize(nShapedPoints);
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nChunks)
+#endif
+  for (int ichunk = 0; ichunk < nChunks; ++ichunk) {
+    processHits(hits, chunkStart[ichunk], chunkStart[ichunk + 1], eventID, sourceID, mThreadDigitContainers[ichunk],
+                mThreadElectronTransport[ichunk], mThreadGEMAmplification[ichunk], mThreadSignalArrays[ichunk]);
+  }
+}
+
+void Digitizer::processHits(const std::vector<o2::tpc::HitGroup>& hits, size_t first, size_t last, const int eventID, const int sourceID,
+                            DigitContainer& digitContainer, ElectronTransport& electronTransport, GEMAmplification& gemAmplification,
+                            std::vector<float>& signalArray) const
+{
+  const static Mapper& mapper = Mapper::instance();
+  auto& detParam = ParameterDetector::Instance();
+  auto& eleParam = ParameterElectronics::Instance();
+  auto& gemParam = ParameterGEM::Instance();
+  static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+
+  const int nShapedPoints = eleParam.NShapedPoints;
+  const auto amplificationMode = gemParam.AmplMode;
 
   /// obtain max drift_time + hitTime which can be processed
-  float maxEleTime = (int(mDigitContainer.size()) - nShapedPoints) * eleParam.ZbinWidth;
+  float maxEleTime = (int(digitContainer.size()) - nShapedPoints) * eleParam.ZbinWidth;
 
-  for (auto& hitGroup : hits) {
+  for (size_t igroup = first; igroup < last; ++igroup) {
+    const auto& hitGroup = hits[igroup];
     const int MCTrackID = hitGroup.GetTrackID();
     for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
       const auto& eh = hitGroup.getHit(hitindex);
@@ -146,8 +215,8 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
         sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
         for (float i = 0; i < nShapedPoints; ++i) {
           const float time = absoluteTime + i * eleParam.ZbinWidth;
-          mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
-                                   signalArray[i]);
+          digitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
+                                  signalArray[i]);
         }
         /// TODO: add ion backflow to space-charge density
       }
@@ -162,7 +231,43 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
                       bool finalFlush)
 {
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+  /// the partial containers of the threads are merged in a fixed order, independent of the thread scheduling
+  for (auto& digitContainer : mThreadDigitContainers) {
+    mDigitContainer.merge(digitContainer);
+  }
   mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset), mIsContinuous, finalFlush);
+  for (auto& digitContainer : mThreadDigitContainers) {
+    digitContainer.dropTimeBinsBefore(mDigitContainer.getFirstTimeBin());
+  }
+}
+
+void Digitizer::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+  mThreadDigitContainers.clear();
+  mThreadElectronTransport.clear();
+  mThreadGEMAmplification.clear();
+  mThreadSignalArrays.clear();
+  if (!mSpaceCharge) { // the per-thread caches of the space-charge interpolators are sized at their creation
+    if (SC::getNThreads() < mNThreads) {
+      SC::setNThreads(mNThreads);
+    }
+  } else if (mNThreads > mNThreadsSC) {
+    LOG(WARNING) << "Space-charge interpolators were created for " << mNThreadsSC << " thread(s), using " << mNThreadsSC
+                 << " instead of " << mNThreads << " threads. Set the number of threads before the space-charge distortions";
+    mNThreads = mNThreadsSC;
+  }
+  if (mNThreads > 1) {
+    mThreadDigitContainers.resize(mNThreads);
+    mThreadSignalArrays.resize(mNThreads);
+    for (auto& digitContainer : mThreadDigitContainers) {
+      digitContainer.setStartTime(mDigitContainer.getFirstTimeBin());
+    }
+  }
 }
 
 void Digitizer::setUseSCDistortions(SC::SCDistortionType distortionType, const TH3* hisInitialSCDensity)
@@ -170,6 +275,7 @@ void Digitizer::setUseSCDistortions(SC::SCDistortionType distortionType, const T
   mUseSCDistortions = true;
   if (!mSpaceCharge) {
     mSpaceCharge = std::make_unique<SC>();
+    mNThreadsSC = SC::getNThreads();
   }
   mSpaceCharge->setSCDistortionType(distortionType);
   if (hisInitialSCDensity) {
@@ -182,6 +288,7 @@ void Digitizer::setUseSCDistortions(SC* spaceCharge)
 {
   mUseSCDistortions = true;
   mSpaceCharge.reset(spaceCharge);
+  mNThreadsSC = SC::getNThreads(); // assuming the object was created with the current number of threads
 }
 
 void Digitizer::setUseSCDistortions(TFile& finp)
@@ -189,6 +296,7 @@ void Digitizer::setUseSCDistortions(TFile& finp)
   mUseSCDistortions = true;
   if (!mSpaceCharge) {
     mSpaceCharge = std::make_unique<SC>();
+    mNThreadsSC = SC::getNThreads();
   }
   mSpaceCharge->setGlobalDistortionsFromFile(finp, Side::A);
   mSpaceCharge->setGlobalDistortionsFromFile(finp, Side::C);
@@ -201,4 +309,7 @@ void Digitizer::setStartTime(double time)
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
   sampaProcessing.updateParameters();
   mDigitContainer.setStartTime(sampaProcessing.getTimeBinFromTime(time - mOutputDigitTimeOffset));
+  for (auto& digitContainer : mThreadDigitContainers) {
+    digitContainer.setStartTime(mDigitContainer.getFirstTimeBin());
+  }
 }
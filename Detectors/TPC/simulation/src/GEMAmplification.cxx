@@ -103,6 +103,16 @@ GEMAmplification::GEMAmplification()
 
 GEMAmplification::~GEMAmplification() = default;
 
+void GEMAmplification::skipRandomValues(size_t n)
+{
+  mRandomGaus.skip(n);
+  mRandomFlat.skip(n);
+  for (auto& gain : mGain) {
+    gain.skip(n);
+  }
+  mGainFullStack.skip(n);
+}
+
 void GEMAmplification::updateParameters()
 {
   auto& cdb = CDBInterface::instance();
@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_DigitContainer.cxx
+/// \brief  Benchmark of the memory and throughput of the DigitContainer in continuous digitization
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsTPC/Digit.h"
+#include "TPCBase/CDBInterface.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/ParameterElectronics.h"
+#include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/SAMPAProcessing.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace o2::tpc;
+
+// continuous digitization of one sector for a TF of 128 orbits at 50 kHz Pb-Pb interaction rate,
+// the collisions are uniformly distributed in the TF, the signals of a collision are spread over one drift time
+static void BM_DigitContainerTF(benchmark::State& state)
+{
+  constexpr int NOrbits = 128;
+  constexpr double InteractionRate = 50.e3;            // Hz
+  constexpr double TFLength = NOrbits * 3564 * 25.e-3; // us
+  constexpr double DriftTime = 250. / 2.58;            // us
+  const int nSignalsPerCollision = state.range(0);
+  const int nCollisions = TFLength * 1.e-6 * InteractionRate;
+
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  const Mapper& mapper = Mapper::instance();
+  const SAMPAProcessing& sampa = SAMPAProcessing::instance();
+  const auto& eleParam = ParameterElectronics::Instance();
+  const int nShapedPoints = eleParam.NShapedPoints;
+  const Sector sector(0);
+
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0.f, 1.f);
+  std::vector<float> collisionTimes(nCollisions);
+  for (auto& t : collisionTimes) {
+    t = rnd(gen) * TFLength;
+  }
+  std::sort(collisionTimes.begin(), collisionTimes.end());
+
+  std::vector<float> signalArray(nShapedPoints);
+  std::vector<Digit> digits;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+  std::vector<CommonMode> commonMode;
+  size_t nDigits = 0, peakMemory = 0;
+  for (auto _ : state) {
+    DigitContainer digitContainer;
+    digitContainer.setStartTime(0);
+    nDigits = 0;
+    peakMemory = 0;
+    for (int iColl = 0; iColl < nCollisions; iColl++) {
+      const float eventTime = collisionTimes[iColl];
+      digitContainer.reserve(sampa.getTimeBinFromTime(eventTime));
+      for (int iSignal = 0; iSignal < nSignalsPerCollision; iSignal++) {
+        const int row = rnd(gen) * Mapper::PADROWS;
+        const int pad = rnd(gen) * mapper.getNumberOfPadsInRowSector(row);
+        const GlobalPadNumber globalPad = mapper.globalPadNumber(PadPos(row, pad));
+        const CRU cru = mapper.getCRU(sector, globalPad);
+        const o2::MCCompLabel label(rnd(gen) * 2000, iColl, 0, false);
+        const float time = eventTime + rnd(gen) * DriftTime;
+        sampa.getShapedSignal(20.f + 100.f * rnd(gen), time, signalArray);
+        for (int i = 0; i < nShapedPoints; ++i) {
+          digitContainer.addDigit(label, cru, sampa.getTimeBinFromTime(time + i * eleParam.ZbinWidth), globalPad, signalArray[i]);
+        }
+      }
+      peakMemory = std::max(peakMemory, digitContainer.getAllocatedMemory());
+      digits.clear();
+      labels.clear();
+      commonMode.clear();
+      digitContainer.fillOutputContainer(digits, labels, commonMode, sector, sampa.getTimeBinFromTime(eventTime), true, false);
+      nDigits += digits.size();
+    }
+    digits.clear();
+    labels.clear();
+    commonMode.clear();
+    digitContainer.fillOutputContainer(digits, labels, commonMode, sector, 0, true, true);
+    nDigits += digits.size();
+  }
+  state.counters["digits/s"] = benchmark::Counter(double(nDigits) * state.iterations(), benchmark::Counter::kIsRate);
+  state.counters["peakMemoryMB"] = double(peakMemory) / (1024. * 1024.);
+}
+
+// args: number of shaped signals per collision in the sector
+BENCHMARK(BM_DigitContainerTF)->Arg(2000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
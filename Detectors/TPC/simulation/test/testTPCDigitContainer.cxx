@@ -17,6 +17,7 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <array>
 #include <memory>
 #include <vector>
 #include "DataFormatsTPC/Digit.h"
@@ -167,5 +168,70 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the merging of DigitContainers
+/// The digits are split in two partial containers, which are merged as done for the multithreaded digitization,
+/// the result must be the same as when filling a single container
+BOOST_AUTO_TEST_CASE(DigitContainer_merge)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString("TPCEleParam.DigiMode=3"); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+
+  const std::vector<int> MCevent = {1, 62, 1, 62, 62, 50, 62, 1, 1, 1, 3, 3};
+  const std::vector<int> MCtrack = {22, 3, 22, 3, 3, 70, 3, 7, 7, 7, 5, 5};
+  const std::vector<int> cru = {0, 0, 3, 3, 0, 0, 3, 3, 9, 9, 0, 0};
+  const std::vector<int> Time = {231, 231, 12, 12, 231, 231, 12, 13, 40, 40, 231, 232};
+  const std::vector<int> Row = {11, 11, 5, 5, 11, 11, 5, 5, 2, 2, 11, 11};
+  const std::vector<int> Pad = {15, 15, 7, 7, 15, 15, 7, 7, 30, 30, 15, 16};
+  const std::vector<int> nEle = {60, 1, 252, 10, 2, 3, 5, 25, 24, 23, 7, 8};
+
+  DigitContainer digitContainer, digitContainerMerged;
+  std::array<DigitContainer, 2> partialContainers;
+  for (size_t i = 0; i < cru.size(); ++i) {
+    const CRU c(cru[i]);
+    const DigitPos digiPadPos(c, PadPos(Row[i], Pad[i]));
+    const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
+    const MCCompLabel label(MCtrack[i], MCevent[i], 0, false);
+    digitContainer.addDigit(label, cru[i], Time[i], globalPad, nEle[i]);
+    partialContainers[2 * i / cru.size()].addDigit(label, cru[i], Time[i], globalPad, nEle[i]);
+  }
+  for (auto& partialContainer : partialContainers) {
+    digitContainerMerged.merge(partialContainer);
+  }
+
+  std::vector<Digit> digits, digitsMerged;
+  dataformats::MCTruthContainer<MCCompLabel> mcTruth, mcTruthMerged;
+  std::vector<o2::tpc::CommonMode> commonMode, commonModeMerged;
+  digitContainer.fillOutputContainer(digits, mcTruth, commonMode, 0, 0, true, true);
+  digitContainerMerged.fillOutputContainer(digitsMerged, mcTruthMerged, commonModeMerged, 0, 0, true, true);
+
+  BOOST_CHECK(digits.size() == digitsMerged.size());
+  BOOST_CHECK(commonMode.size() == commonModeMerged.size());
+  for (size_t i = 0; i < digits.size(); ++i) {
+    BOOST_CHECK(digits[i].getCRU() == digitsMerged[i].getCRU());
+    BOOST_CHECK(digits[i].getRow() == digitsMerged[i].getRow());
+    BOOST_CHECK(digits[i].getPad() == digitsMerged[i].getPad());
+    BOOST_CHECK(digits[i].getTimeStamp() == digitsMerged[i].getTimeStamp());
+    BOOST_CHECK(digits[i].getChargeFloat() == digitsMerged[i].getChargeFloat());
+    const auto labels = mcTruth.getLabels(i);
+    const auto labelsMerged = mcTruthMerged.getLabels(i);
+    BOOST_CHECK(labels.size() == labelsMerged.size());
+    for (size_t j = 0; j < labels.size(); ++j) {
+      BOOST_CHECK(labels[j] == labelsMerged[j]);
+    }
+  }
+  for (size_t i = 0; i < commonMode.size(); ++i) {
+    BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), commonModeMerged[i].getCommonMode(), 1E-6);
+  }
+
+  // the partial containers are left empty
+  std::vector<Digit> digitsPartial;
+  for (auto& partialContainer : partialContainers) {
+    partialContainer.fillOutputContainer(digitsPartial, mcTruth, commonMode, 0, 0, true, true);
+  }
+  BOOST_CHECK(digitsPartial.empty());
+}
 } // namespace tpc
 } // namespace o2
@@ -35,7 +35,7 @@ namespace tpc
 /// \class PoissonSolver
 /// The PoissonSolver class represents methods to solve the poisson equation.
 /// Original version with more methods can be found in AliTPCPoissonSolver.
-/// Following methods are implemented: poissonSolver3D, poissonSolver3D2D, poissonSolver2D
+/// Following methods are implemented: poissonSolver3D, poissonSolver3D2D, poissonSolver2D, poissonSolver3DRedBlack
 
 /// \tparam DataT the type of data which is used during the calculations
 /// \tparam Nr number of vertices in r direction (2^N + 1)
@@ -48,6 +48,7 @@ class PoissonSolver
   using RegularGrid = RegularGrid3D<DataT, Nz, Nr, Nphi>;
   using DataContainer = DataContainer3D<DataT, Nz, Nr, Nphi>;
   using Vector = Vector3D<DataT>;
+  using VectorPhi = Vector3DPhiLines<DataT>;
 
   /// default constructor
   PoissonSolver(const RegularGrid& gridProperties) : mGrid3D{gridProperties} {};
@@ -78,6 +79,21 @@ class PoissonSolver
   /// \param matricesCharge charge density in matrix (side effect
   void poissonSolver2D(DataContainer& matricesV, const DataContainer& matricesCharge);
 
+  /// Provides poisson solver in Cylindrical 3D (TPC geometry) by geometric multi grid with full coarsening
+  ///
+  /// Same discretisation and cycles (V, Full) as poissonSolver3D with full 3D coarsening, but the grids are stored with contiguous phi lines (Vector3DPhiLines)
+  /// and the smoothing is a red-black Gauss-Seidel relaxation which is done in blocks of r and z vertices distributed among sNThreads threads.
+  /// The update of a phi line is vectorized. The result does not depend on the number of threads.
+  /// The relaxation is always Gauss-Seidel and the grid transfer is always full weighting (MGParameters::relaxType and MGParameters::gtType are ignored).
+  ///
+  /// \param matricesV potential in 3D
+  /// \param matricesCharge charge density in 3D (side effect)
+  /// \param symmetry symmetry or not
+  ///
+  /// \pre Charge density distribution in **matricesCharge** is known and boundary values for **matricesV** are set
+  /// \post Numerical solution for potential distribution is calculated and stored in each rod at **matricesV**
+  void poissonSolver3DRedBlack(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry);
+
   DataT getSpacingZ() const { return mGrid3D.getSpacingX(); }
   DataT getSpacingR() const { return mGrid3D.getSpacingY(); }
   DataT getSpacingPhi() const { return mGrid3D.getSpacingZ(); }
@@ -96,7 +112,9 @@ class PoissonSolver
   const RegularGrid& mGrid3D{};                                      ///< grid properties
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact, except for poissonSolver3DRedBlack)
+  static constexpr int RELAXBLOCKR = 16;                             ///< number of r vertices of the blocks which are relaxed by one thread in the red-black solver
+  static constexpr int RELAXBLOCKZ = 8;                              ///< number of z vertices of the blocks which are relaxed by one thread in the red-black solver
 
   /// Relative error calculation: comparison with exact solution
   ///
@@ -155,6 +173,16 @@ class PoissonSolver
   /// symmetry = 1 if we have reflection symmetry at the boundaries (eg. sector symmetry or half sector symmetries).
   void poissonMultiGrid3D(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry);
 
+  /// 3D - Solve Poisson's Equation in 3D in all direction by MultiGrid with red-black Gauss-Seidel smoothing on contiguous phi lines
+  ///
+  /// Same algorithm as poissonMultiGrid3D. See poissonSolver3DRedBlack for the differences.
+  ///
+  /// \param matricesV potential in 3D matrix
+  /// \param matricesCharge charge density in 3D matrix (side effect)
+  /// \param symmetry symmetry or not: symmetry = 0 if no phi symmetries, and no phi boundary condition.
+  /// symmetry = 1 if we have reflection symmetry at the boundaries (eg. sector symmetry or half sector symmetries).
+  void poissonMultiGrid3DRedBlack(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry);
+
   /// Solve Poisson's Equation by MultiGrid Technique in 2D (assuming cylindrical symmetry)
   ///
   /// NOTE: In order for this algorithm to work, the number of nRRow and nZColumn must be a power of 2 plus one.
@@ -413,6 +441,87 @@ class PoissonSolver
   void wCycle2D(const int gridFrom, const int gridTo, const int gamma, const int nPre, const int nPost, const DataT gridSizeR, const DataT ratio,
                 std::vector<Vector>& tvArrayV, std::vector<Vector>& tvCharge, std::vector<Vector>& tvResidue);
 
+  /// VCycle 3D for the red-black solver, V Cycle in multiGrid, fine-->coarsest-->fine, propagating the residue to correct initial guess of V
+  ///
+  /// \param symmetry symmetry or not
+  /// \param gridFrom finest level of grid
+  /// \param gridTo coarsest level of grid
+  /// \param nPre number of smoothing before coarsening
+  /// \param nPost number of smoothing after coarsening
+  /// \param ratioZ ratio between square of grid r and grid z
+  /// \param tvArrayV vector of V potential in different grids
+  /// \param tvCharge vector of charge distribution in different grids
+  /// \param tvResidue vector of residue calculation in different grids
+  void vCycle3DRedBlack(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const DataT ratioZ, std::vector<VectorPhi>& tvArrayV,
+                        std::vector<VectorPhi>& tvCharge, std::vector<VectorPhi>& tvResidue) const;
+
+  /// Red-black Gauss-Seidel relaxation on contiguous phi lines using the 7 point stencil in cylindrical coordinates (same equation as relax3D)
+  ///
+  /// For each colour the (r,z) plane is split in blocks of RELAXBLOCKR x RELAXBLOCKZ phi lines, which are relaxed in parallel.
+  /// The vertices of the current colour of a phi line are updated in one vectorized loop.
+  ///
+  /// \param matricesCurrentV potential in 3D
+  /// \param matricesCurrentCharge charge in 3D
+  /// \param symmetry is the cylinder has symmetry
+  /// \param h2 \f$  h_{r}^{2} \f$
+  /// \param tempRatioZ ration between grid size in z-direction and r-direction
+  /// \param coefficient1 coefficients for \f$  V_{x+1,y,z} \f$
+  /// \param coefficient2 coefficients for \f$  V_{x-1,y,z} \f$
+  /// \param coefficient3 coefficients for z
+  /// \param coefficient4 coefficients for f(r,\phi,z)
+  void relax3DRedBlack(VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentCharge, const int symmetry, const DataT h2, const DataT tempRatioZ,
+                       const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& coefficient4) const;
+
+  /// Residue calculation on contiguous phi lines (same equation as residue3D)
+  ///
+  /// \param residue residue in 3D
+  /// \param matricesCurrentV potential in 3D
+  /// \param matricesCurrentCharge charge in 3D
+  /// \param symmetry if the cylinder has symmetry
+  /// \param ih2 \f$ 1/ h_{r}^{2} \f$
+  /// \param tempRatioZ ration between grid size in z-direction and r-direction
+  /// \param coefficient1 coefficient for \f$  V_{x+1,y,z} \f$
+  /// \param coefficient2 coefficient for \f$  V_{x-1,y,z} \f$
+  /// \param coefficient3 coefficient for z
+  /// \param inverseCoefficient4 inverse coefficient for f(r,\phi,z)
+  void residue3DRedBlack(VectorPhi& residue, const VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentCharge, const int symmetry, const DataT ih2, const DataT tempRatioZ,
+                         const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& inverseCoefficient4) const;
+
+  /// Restriction with full weighting from fine grid (h) to coarse grid (2h) on contiguous phi lines.
+  /// Restriction in phi only if the number of phi vertices of the fine grid is twice the number of the coarse grid.
+  /// \param matricesCurrentCharge coarser grid 2h
+  /// \param residue fine grid h
+  /// \param symmetry if the cylinder has symmetry
+  void restrict3DRedBlack(VectorPhi& matricesCurrentCharge, const VectorPhi& residue, const int symmetry) const;
+
+  /// Pass boundary information from fine grid (h) to coarse grid (2h) on contiguous phi lines
+  /// \param matricesCurrentCharge coarser grid 2h
+  /// \param residue fine grid h
+  /// \param symmetry if the cylinder has symmetry
+  void restrictBoundary3DRedBlack(VectorPhi& matricesCurrentCharge, const VectorPhi& residue, const int symmetry) const;
+
+  /// Trilinear interpolation/prolongation from coarse grid (2h) to the inner vertices of the fine grid (h) on contiguous phi lines.
+  /// Interpolation in phi only if the number of phi vertices of the fine grid is twice the number of the coarse grid.
+  /// \param matricesCurrentV fine grid h
+  /// \param matricesCurrentVC coarse grid 2h
+  /// \param symmetry if the cylinder has symmetry
+  /// \param add add the interpolated values to the values of the fine grid instead of replacing them
+  void interp3DRedBlack(VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentVC, const int symmetry, const bool add) const;
+
+  /// Relative error calculation on contiguous phi lines: largest sum of the squared differences of a phi slice
+  /// \param matricesCurrentV current potential (numerical solution)
+  /// \param prevArrayV content from matricesCurrentV from previous iteration
+  DataT getConvergenceError(const VectorPhi& matricesCurrentV, const VectorPhi& prevArrayV) const;
+
+  /// calculate the coefficients of a multi grid level for the red-black solver
+  /// \param level multi grid level (0 is the finest grid)
+  /// \param tnRRow number of vertices in r direction of the level
+  /// \param tnPhi number of vertices in phi direction of the level
+  /// \param ratioZ ratio between square of grid r and grid z
+  /// \return returns the grid spacing in r direction of the level
+  DataT calcCoefficientsRedBlack(const int level, const int tnRRow, const int tnPhi, const DataT ratioZ, std::array<DataT, Nr>& coefficient1, std::array<DataT, Nr>& coefficient2,
+                                 std::array<DataT, Nr>& coefficient3, std::array<DataT, Nr>& coefficient4, std::array<DataT, Nr>& inverseCoefficient4) const;
+
   /// Residue3D
   ///
   ///    Compute residue from V(.) where V(.) is numerical potential and f(.).
@@ -90,6 +90,11 @@ class SpaceCharge
     ElectricalField ///< using electric field for calculation of global distortions/corrections
   };
 
+  enum class PoissonSolverType {
+    MultiGrid = 0,        ///< multi grid poisson solver with the settings from MGParameters (PoissonSolver::poissonSolver3D)
+    MultiGridRedBlack = 1 ///< multi grid poisson solver with full coarsening and multithreaded red-black relaxation on contiguous phi lines (PoissonSolver::poissonSolver3DRedBlack)
+  };
+
   /// step 0: set the charge density from TH3 histogram containing the space charge density
   /// \param hisSCDensity3D histogram for the space charge density
   void fillChargeDensityFromHisto(const TH3& hisSCDensity3D);
@@ -217,6 +222,24 @@ class SpaceCharge
   /// \param corrZ returns corrections in z direction
   void getCorrections(const DataT x, const DataT y, const DataT z, const Side side, DataT& corrX, DataT& corrY, DataT& corrZ) const;
 
+  /// get the global corrections for a batch of coordinates. The interpolation is done per cell of the grid, which is much faster than querying each point separately
+  /// \param z global z coordinates
+  /// \param r global r coordinates
+  /// \param phi global phi coordinates
+  /// \param corrZ returns corrections in z direction
+  /// \param corrR returns corrections in r direction
+  /// \param corrRPhi returns corrections in rphi direction
+  void getCorrectionsCyl(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, const Side side, std::vector<DataT>& corrZ, std::vector<DataT>& corrR, std::vector<DataT>& corrRPhi) const;
+
+  /// get the global corrections for a batch of coordinates
+  /// \param x global x coordinates
+  /// \param y global y coordinates
+  /// \param z global z coordinates
+  /// \param corrX returns corrections in x direction
+  /// \param corrY returns corrections in y direction
+  /// \param corrZ returns corrections in z direction
+  void getCorrections(const std::vector<DataT>& x, const std::vector<DataT>& y, const std::vector<DataT>& z, const Side side, std::vector<DataT>& corrX, std::vector<DataT>& corrY, std::vector<DataT>& corrZ) const;
+
   /// get the local distortions for given coordinate
   /// \param z global z coordinate
   /// \param r global r coordinate
@@ -262,6 +285,24 @@ class SpaceCharge
   /// \param distZ returns distortion in z direction
   void getDistortions(const DataT x, const DataT y, const DataT z, const Side side, DataT& distX, DataT& distY, DataT& distZ) const;
 
+  /// get the global distortions for a batch of coordinates. The interpolation is done per cell of the grid, which is much faster than querying each point separately
+  /// \param z global z coordinates
+  /// \param r global r coordinates
+  /// \param phi global phi coordinates
+  /// \param distZ returns distortions in z direction
+  /// \param distR returns distortions in r direction
+  /// \param distRPhi returns distortions in rphi direction
+  void getDistortionsCyl(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, const Side side, std::vector<DataT>& distZ, std::vector<DataT>& distR, std::vector<DataT>& distRPhi) const;
+
+  /// get the global distortions for a batch of coordinates
+  /// \param x global x coordinates
+  /// \param y global y coordinates
+  /// \param z global z coordinates
+  /// \param distX returns distortions in x direction
+  /// \param distY returns distortions in y direction
+  /// \param distZ returns distortions in z direction
+  void getDistortions(const std::vector<DataT>& x, const std::vector<DataT>& y, const std::vector<DataT>& z, const Side side, std::vector<DataT>& distX, std::vector<DataT>& distY, std::vector<DataT>& distZ) const;
+
   /// convert x and y coordinates from cartesian to the radius in polar coordinates
   static DataT getRadiusFromCartesian(const DataT x, const DataT y) { return std::sqrt(x * x + y * y); }
 
@@ -559,6 +600,7 @@ class SpaceCharge
   {
     sNThreads = nThreads;
     o2::tpc::TriCubicInterpolator<DataT, Nz, Nr, Nphi>::setNThreads(nThreads);
+    o2::tpc::PoissonSolver<DataT, Nz, Nr, Nphi>::setNThreads(nThreads);
   }
 
   /// set which kind of numerical integration is used for calcution of the integrals int Er/Ez dz, int Ephi/Ez dz, int Ez dz
@@ -572,6 +614,11 @@ class SpaceCharge
   static void setGlobalDistCorrMethod(const GlobalDistCorrMethod globalDistCorrMethod) { sGlobalDistCorrCalcMethod = globalDistCorrMethod; }
   static GlobalDistCorrMethod getGlobalDistCorrMethod() { return sGlobalDistCorrCalcMethod; }
 
+  /// set which poisson solver is used in poissonSolver()
+  /// \param poissonSolverType type of the poisson solver. see enum PoissonSolverType for the different types
+  static void setPoissonSolverType(const PoissonSolverType poissonSolverType) { sPoissonSolverType = poissonSolverType; }
+  static PoissonSolverType getPoissonSolverType() { return sPoissonSolverType; }
+
   static void setSimpsonNIteratives(const int nIter) { sSimpsonNIteratives = nIter; }
   static int getSimpsonNIteratives() { return sSimpsonNIteratives; }
 
@@ -708,6 +755,7 @@ class SpaceCharge
   inline static GlobalDistType sGlobalDistType{GlobalDistType::Fast};                                     ///< setting for global distortions: 0: standard method,      1: interpolation of global corrections
   inline static GlobalDistCorrMethod sGlobalDistCorrCalcMethod{GlobalDistCorrMethod::LocalDistCorr};      ///< setting for  global distortions/corrections: 0: using electric field, 1: using local dis/corr interpolator
   inline static SCDistortionType sSCDistortionType{SCDistortionType::SCDistortionsConstant};              ///< Type of space-charge distortions
+  inline static PoissonSolverType sPoissonSolverType{PoissonSolverType::MultiGrid};                       ///< poisson solver which is used to calculate the potential
 
   DataT mC0 = 0; ///< coefficient C0 (compare Jim Thomas's notes for definitions)
   DataT mC1 = 0; ///< coefficient C1 (compare Jim Thomas's notes for definitions)
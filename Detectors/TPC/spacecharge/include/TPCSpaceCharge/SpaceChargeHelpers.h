@@ -240,6 +240,35 @@ class DistCorrInterpolator
     return interpolatorDistCorrdRPhi(z, r, phi, mInterpolType);
   }
 
+  /// evaluate the distortions or corrections for a batch of coordinates. The coordinates are grouped only once by the cell of the grid for all three components.
+  /// The batched interpolation is the sparse one, for other interpolation types the coordinates are evaluated one by one
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param dZ returns the distortions or corrections dZ
+  /// \param dR returns the distortions or corrections dR
+  /// \param dRPhi returns the distortions or corrections dRPhi
+  void evalBatch(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, std::vector<DataT>& dZ, std::vector<DataT>& dR, std::vector<DataT>& dRPhi) const
+  {
+    if (mInterpolType != TriCubic::InterpolationType::Sparse) {
+      const size_t nPoints = z.size();
+      dZ.resize(nPoints);
+      dR.resize(nPoints);
+      dRPhi.resize(nPoints);
+      for (size_t i = 0; i < nPoints; ++i) {
+        dZ[i] = evaldZ(z[i], r[i], phi[i]);
+        dR[i] = evaldR(z[i], r[i], phi[i]);
+        dRPhi[i] = evaldRPhi(z[i], r[i], phi[i]);
+      }
+      return;
+    }
+    typename TriCubic::BatchedQuery query;
+    interpolatorDistCorrdZ.prepareBatch(z, r, phi, query);
+    interpolatorDistCorrdZ(query, dZ);
+    interpolatorDistCorrdR(query, dR);
+    interpolatorDistCorrdRPhi(query, dRPhi);
+  }
+
   o2::tpc::Side getSide() const { return mSide; }
 
   static constexpr unsigned int getID() { return ID; }
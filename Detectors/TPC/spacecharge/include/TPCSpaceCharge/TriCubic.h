@@ -20,6 +20,9 @@
 #include "TPCSpaceCharge/Vector.h"
 #include "TPCSpaceCharge/RegularGrid3D.h"
 #include "TPCSpaceCharge/DataContainer3D.h"
+#include <vector>
+#include <numeric>
+#include <algorithm>
 
 #if (defined(WITH_OPENMP) || defined(_OPENMP)) && !defined(__CLING__)
 #include <omp.h>
@@ -179,6 +182,48 @@ class TriCubicInterpolator
   /// \return performs a check if the interpolator can be used with maximum number of threads
   bool checkThreadSafety() const { return sNThreads <= omp_get_max_threads(); }
 
+  /// query points of a batched interpolation sorted by the cell of the grid they are located in
+  struct BatchedQuery {
+    std::vector<unsigned int> cellIndex{}; ///< index iz, ir, iphi of each cell which contains at least one query point (3 entries per cell)
+    std::vector<size_t> cellOffset{};      ///< offset of the first sorted query point of each cell (number of cells + 1 entries)
+    std::vector<size_t> pointIndex{};      ///< index of the sorted query points in the input coordinates
+    std::vector<DataT> relZ{};             ///< relative z position of the sorted query points inside their cell
+    std::vector<DataT> relR{};             ///< relative r position of the sorted query points inside their cell
+    std::vector<DataT> relPhi{};           ///< relative phi position of the sorted query points inside their cell
+
+    /// \return returns the number of cells containing query points
+    size_t getNCells() const { return cellOffset.empty() ? 0 : cellOffset.size() - 1; }
+
+    /// \return returns the number of query points
+    size_t getNPoints() const { return pointIndex.size(); }
+  };
+
+  /// group query points by the cell of the grid. The query can be reused for all interpolators defined on the same grid
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param query output query points sorted by cell
+  void prepareBatch(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, BatchedQuery& query) const;
+
+  /// interpolate values for a batch of query points.
+  /// The polynomial coefficients of each cell are computed only once and are evaluated for all query points of that cell.
+  /// The result agrees with the sparse interpolation up to rounding.
+  /// \param query query points which were prepared with prepareBatch()
+  /// \param values interpolated values in the order of the input coordinates of the query
+  void operator()(const BatchedQuery& query, std::vector<DataT>& values) const;
+
+  /// interpolate values for a batch of coordinates
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param values interpolated values
+  void operator()(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, std::vector<DataT>& values) const
+  {
+    BatchedQuery query;
+    prepareBatch(z, r, phi, query);
+    (*this)(query, values);
+  }
+
  private:
   // matrix containing the 'relationship between the derivatives at the corners of the elements and the coefficients'
   inline static Vc::Memory<VDataT, 64> sMat[64]{
@@ -261,6 +306,9 @@ class TriCubicInterpolator
   std::unique_ptr<bool[]> mInitialized = std::make_unique<bool[]>(sNThreads);                            ///< sets the flag if the coefficients are evaluated at least once
   ExtrapolationType mExtrapolationType = ExtrapolationType::Parabola;                                    ///< sets which type of extrapolation for missing points at boundary is used. Linear and Parabola is only supported for perdiodic phi axis and non periodic z and r axis
 
+  inline static constexpr DataT sMatrixSparse[4][4]{{0, -0.5, 1, -0.5}, {1, 0, -2.5, 1.5}, {0, 0.5, 2., -1.5}, {0, 0, -0.5, 0.5}}; ///< weights of the four vertices for the powers of the relative position used in the sparse interpolation
+  static constexpr size_t sMinPointsCoefficients{8};                                                                               ///< minimum number of query points of a batched query inside a cell for which the polynomial coefficients are computed
+
   //                 DEFINITION OF enum GridPos
   //========================================================
   //              r
@@ -330,6 +378,13 @@ class TriCubicInterpolator
   /// \return returns the interpolated value at given coordinate
   DataT interpolateSparse(const DataT z, const DataT r, const DataT phi) const;
 
+  // calculate the polynomial coefficients of the sparse interpolation for one cell from the values of the surrounding 64 vertices:
+  // f(z,r,phi) = \sum_{i,j,k=0}^3 c_{ijk} * z^{i} * r^{j} * phi^{k} with c_{ijk} stored at i + 4 * j + 16 * k
+  static void calcCoefficientsSparse(const DataT cVals[64], DataT coefficients[64]);
+
+  // interpolate value at the relative position inside a cell from the values of the surrounding 64 vertices with the sparse algorithm
+  static DataT interpolateSparse(const DataT cVals[64], const DataT dz, const DataT dr, const DataT dphi);
+
   DataT evalDerivative(const DataT dz, const DataT dr, const DataT dphi, const size_t derz, const size_t derr, const size_t derphi) const;
 
   // for periodic boundary conditions
@@ -597,6 +652,175 @@ DataT TriCubicInterpolator<DataT, Nz, Nr, Nphi>::interpolateSparse(const DataT z
   return result;
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void TriCubicInterpolator<DataT, Nz, Nr, Nphi>::calcCoefficientsSparse(const DataT cVals[64], DataT coefficients[64])
+{
+  // the coefficients are separable: transform the values of the vertices successively in z, r and phi direction
+  DataT coeffZ[64]{};
+  for (int line = 0; line < 16; ++line) {
+    for (int p = 0; p < 4; ++p) {
+      for (int q = 0; q < 4; ++q) {
+        coeffZ[4 * line + q] += sMatrixSparse[p][q] * cVals[4 * line + p];
+      }
+    }
+  }
+
+  DataT coeffZR[64]{};
+  for (int slice = 0; slice < 4; ++slice) {
+    for (int p = 0; p < 4; ++p) {
+      for (int q = 0; q < 4; ++q) {
+        for (int i = 0; i < 4; ++i) {
+          coeffZR[16 * slice + 4 * q + i] += sMatrixSparse[p][q] * coeffZ[16 * slice + 4 * p + i];
+        }
+      }
+    }
+  }
+
+  std::fill(coefficients, coefficients + 64, 0);
+  for (int p = 0; p < 4; ++p) {
+    for (int q = 0; q < 4; ++q) {
+      for (int i = 0; i < 16; ++i) {
+        coefficients[16 * q + i] += sMatrixSparse[p][q] * coeffZR[16 * p + i];
+      }
+    }
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+DataT TriCubicInterpolator<DataT, Nz, Nr, Nphi>::interpolateSparse(const DataT cVals[64], const DataT dz, const DataT dr, const DataT dphi)
+{
+  DataT weightZ[4];
+  DataT weightR[4];
+  DataT weightPhi[4];
+  for (int p = 0; p < 4; ++p) {
+    const DataT* matr = sMatrixSparse[p];
+    weightZ[p] = matr[0] + dz * (matr[1] + dz * (matr[2] + dz * matr[3]));
+    weightR[p] = matr[0] + dr * (matr[1] + dr * (matr[2] + dr * matr[3]));
+    weightPhi[p] = matr[0] + dphi * (matr[1] + dphi * (matr[2] + dphi * matr[3]));
+  }
+
+  DataT result = 0;
+  for (int k = 0; k < 4; ++k) {
+    DataT resultR = 0;
+    for (int j = 0; j < 4; ++j) {
+      const DataT* vals = &cVals[16 * k + 4 * j];
+      resultR += weightR[j] * (weightZ[0] * vals[0] + weightZ[1] * vals[1] + weightZ[2] * vals[2] + weightZ[3] * vals[3]);
+    }
+    result += weightPhi[k] * resultR;
+  }
+  return result;
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void TriCubicInterpolator<DataT, Nz, Nr, Nphi>::prepareBatch(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, BatchedQuery& query) const
+{
+  const size_t nPoints = z.size();
+  std::vector<unsigned int> cellZ(nPoints);    // z index of the cell for each query point
+  std::vector<unsigned int> cellRPhi(nPoints); // r and phi index of the cell (iphi * Nr + ir) for each query point
+  std::vector<DataT> relPos(FDim * nPoints);   // relative position inside the cell for each query point
+
+  for (size_t i = 0; i < nPoints; ++i) {
+    // same as in processInp(): only the index of the cell is clamped to the grid
+    const DataT posZ = (z[i] - mGridProperties.getGridMinX()) * mGridProperties.getInvSpacingX();
+    const DataT posR = (r[i] - mGridProperties.getGridMinY()) * mGridProperties.getInvSpacingY();
+    const DataT posPhi = mGridProperties.clampToGridCircularRel((phi[i] - mGridProperties.getGridMinZ()) * mGridProperties.getInvSpacingZ(), FPHI);
+
+    const unsigned int iz = static_cast<unsigned int>(mGridProperties.clampToGridRel(posZ, FZ));
+    const unsigned int ir = static_cast<unsigned int>(mGridProperties.clampToGridRel(posR, FR));
+    const unsigned int iphi = static_cast<unsigned int>(posPhi);
+
+    cellZ[i] = iz;
+    cellRPhi[i] = iphi * Nr + ir;
+    relPos[FDim * i + FZ] = posZ - iz;
+    relPos[FDim * i + FR] = posR - ir;
+    relPos[FDim * i + FPHI] = posPhi - iphi;
+  }
+
+  // sort the query points by their cell with two passes of a counting sort: first by the z index and then by the r and phi index
+  std::vector<size_t> sortedZ(nPoints);
+  std::vector<size_t> countZ(Nz + 1);
+  for (size_t i = 0; i < nPoints; ++i) {
+    ++countZ[cellZ[i] + 1];
+  }
+  std::partial_sum(countZ.begin(), countZ.end(), countZ.begin());
+  for (size_t i = 0; i < nPoints; ++i) {
+    sortedZ[countZ[cellZ[i]]++] = i;
+  }
+
+  std::vector<size_t> countRPhi(Nr * Nphi + 1);
+  for (size_t i = 0; i < nPoints; ++i) {
+    ++countRPhi[cellRPhi[i] + 1];
+  }
+  std::partial_sum(countRPhi.begin(), countRPhi.end(), countRPhi.begin());
+  query.pointIndex.resize(nPoints);
+  for (const size_t ind : sortedZ) {
+    query.pointIndex[countRPhi[cellRPhi[ind]]++] = ind;
+  }
+
+  query.cellIndex.clear();
+  query.cellOffset.clear();
+  query.relZ.resize(nPoints);
+  query.relR.resize(nPoints);
+  query.relPhi.resize(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    const size_t ind = query.pointIndex[i];
+    if (i == 0 || cellZ[ind] != cellZ[query.pointIndex[i - 1]] || cellRPhi[ind] != cellRPhi[query.pointIndex[i - 1]]) {
+      query.cellOffset.emplace_back(i);
+      query.cellIndex.emplace_back(cellZ[ind]);
+      query.cellIndex.emplace_back(cellRPhi[ind] % Nr);
+      query.cellIndex.emplace_back(cellRPhi[ind] / Nr);
+    }
+    query.relZ[i] = relPos[FDim * ind + FZ];
+    query.relR[i] = relPos[FDim * ind + FR];
+    query.relPhi[i] = relPos[FDim * ind + FPHI];
+  }
+  query.cellOffset.emplace_back(nPoints);
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void TriCubicInterpolator<DataT, Nz, Nr, Nphi>::operator()(const BatchedQuery& query, std::vector<DataT>& values) const
+{
+  values.resize(query.getNPoints());
+  const size_t nCells = query.getNCells();
+
+#pragma omp parallel for num_threads(sNThreads) schedule(dynamic, 64)
+  for (size_t iCell = 0; iCell < nCells; ++iCell) {
+    DataT cVals[64]{};
+    setValues(query.cellIndex[3 * iCell], query.cellIndex[3 * iCell + 1], query.cellIndex[3 * iCell + 2], cVals);
+
+    const size_t firstPoint = query.cellOffset[iCell];
+    const size_t lastPoint = query.cellOffset[iCell + 1];
+    if (lastPoint - firstPoint < sMinPointsCoefficients) {
+      // only a few points inside the cell: computing the coefficients doesnt pay off
+      for (size_t iPoint = firstPoint; iPoint < lastPoint; ++iPoint) {
+        values[query.pointIndex[iPoint]] = interpolateSparse(cVals, query.relZ[iPoint], query.relR[iPoint], query.relPhi[iPoint]);
+      }
+      continue;
+    }
+
+    DataT coefficients[64];
+    calcCoefficientsSparse(cVals, coefficients);
+
+    // evaluate the polynomial with horner's method for all query points inside the cell
+#pragma omp simd
+    for (size_t iPoint = firstPoint; iPoint < lastPoint; ++iPoint) {
+      const DataT dz = query.relZ[iPoint];
+      const DataT dr = query.relR[iPoint];
+      const DataT dphi = query.relPhi[iPoint];
+      DataT result = 0;
+      for (int k = 3; k >= 0; --k) {
+        DataT resultR = 0;
+        for (int j = 3; j >= 0; --j) {
+          const DataT* coeff = &coefficients[16 * k + 4 * j];
+          resultR = resultR * dr + (coeff[0] + dz * (coeff[1] + dz * (coeff[2] + dz * coeff[3])));
+        }
+        result = result * dphi + resultR;
+      }
+      values[query.pointIndex[iPoint]] = result;
+    }
+  }
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 const Vector<DataT, 3> TriCubicInterpolator<DataT, Nz, Nr, Nphi>::processInp(const Vector<DataT, 3>& coordinates, const bool sparse) const
 {
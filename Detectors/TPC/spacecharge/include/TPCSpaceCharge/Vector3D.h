@@ -104,6 +104,97 @@ class Vector3D
   std::vector<DataT> mStorage{}; ///< vector containing the data
 };
 
+/// this is a 3D vector class which is used in the red-black poisson solver: the vertices in phi direction are stored contiguously (phi lines).
+/// Each phi line has one ghost vertex in front of the first and one behind the last phi vertex, which hold the phi neighbours of the first and last vertex.
+
+/// \tparam DataT the data type of the mStorage which is used during the calculations
+template <typename DataT = double>
+class Vector3DPhiLines
+{
+ public:
+  /// constructor
+  /// \param nr number of data points in r directions
+  /// \param nz number of data points in z directions
+  /// \param nphi number of data points in phi directions
+  Vector3DPhiLines(const unsigned int nr, const unsigned int nz, const unsigned int nphi) : mNr{nr}, mNz{nz}, mNphi{nphi}, mStorage((nphi + 2) * nr * nz){};
+
+  /// default constructor
+  Vector3DPhiLines() = default;
+
+  /// operator to set the values. iPhi=-1 and iPhi=nphi are the ghost vertices
+  DataT& operator()(const unsigned int iR, const unsigned int iZ, const int iPhi)
+  {
+    return mStorage[getIndex(iR, iZ, iPhi)];
+  }
+
+  /// operator to read the values. iPhi=-1 and iPhi=nphi are the ghost vertices
+  const DataT& operator()(const unsigned int iR, const unsigned int iZ, const int iPhi) const
+  {
+    return mStorage[getIndex(iR, iZ, iPhi)];
+  }
+
+  /// \param iR index in r direction
+  /// \param iZ index in z direction
+  /// \param iPhi index in phi direction
+  /// \return returns the index for given indices
+  int getIndex(const unsigned int iR, const unsigned int iZ, const int iPhi) const
+  {
+    return iPhi + 1 + (mNphi + 2) * (iZ + mNz * iR);
+  }
+
+  /// \return returns pointer to the first phi vertex of the phi line at given r and z index. The ghost vertices are at line[-1] and line[nphi]
+  DataT* getLine(const unsigned int iR, const unsigned int iZ) { return &mStorage[getIndex(iR, iZ, 0)]; }
+  const DataT* getLine(const unsigned int iR, const unsigned int iZ) const { return &mStorage[getIndex(iR, iZ, 0)]; }
+
+  /// set the ghost vertices of a phi line
+  /// \param iR index in r direction
+  /// \param iZ index in z direction
+  /// \param symmetry 0: continuous in phi, 1: reflection symmetry at the phi boundaries, -1: anti-symmetry at the phi boundaries
+  void fillGhostVertices(const unsigned int iR, const unsigned int iZ, const int symmetry)
+  {
+    DataT* line = getLine(iR, iZ);
+    const int nphi = mNphi;
+    if (symmetry == 1) {
+      line[-1] = line[1];
+      line[nphi] = line[nphi - 2];
+    } else if (symmetry == -1) {
+      line[-1] = -line[1];
+      line[nphi] = -line[nphi - 2];
+    } else {
+      line[-1] = line[nphi - 1];
+      line[nphi] = line[0];
+    }
+  }
+
+  /// resize the vector
+  /// \param nr number of data points in r directions
+  /// \param nz number of data points in z directions
+  /// \param nphi number of data points in phi directions
+  void resize(const unsigned int nr, const unsigned int nz, const unsigned int nphi)
+  {
+    mNr = nr;
+    mNz = nz;
+    mNphi = nphi;
+    mStorage.resize((nphi + 2) * nr * nz);
+  }
+
+  unsigned int getNr() const { return mNr; }     ///< get number of data points in r direction
+  unsigned int getNz() const { return mNz; }     ///< get number of data points in z direction
+  unsigned int getNphi() const { return mNphi; } ///< get number of data points in phi direction
+
+  auto begin() const { return mStorage.begin(); }
+  auto begin() { return mStorage.begin(); }
+
+  auto end() const { return mStorage.end(); }
+  auto end() { return mStorage.end(); }
+
+ private:
+  unsigned int mNr{};            ///< number of data points in r direction
+  unsigned int mNz{};            ///< number of data points in z direction
+  unsigned int mNphi{};          ///< number of data points in phi direction
+  std::vector<DataT> mStorage{}; ///< vector containing the data including the ghost vertices
+};
+
 } // namespace tpc
 } // namespace o2
 
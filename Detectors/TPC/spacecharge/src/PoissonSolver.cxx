@@ -20,6 +20,7 @@
 
 #include "TPCSpaceCharge/PoissonSolver.h"
 #include "Framework/Logger.h"
+#include <algorithm>
 #include <numeric>
 #include <fmt/core.h>
 
@@ -45,6 +46,12 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonSolver2D(DataContainer& matrices
   poissonMultiGrid2D(matricesV, matricesCharge);
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonSolver3DRedBlack(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry)
+{
+  poissonMultiGrid3DRedBlack(matricesV, matricesCharge, symmetry);
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid2D(DataContainer& matricesV, const DataContainer& matricesCharge, const int iPhi)
 {
@@ -566,6 +573,399 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3D(DataContainer& matri
   }
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3DRedBlack(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry)
+{
+  const DataT gridSpacingR = getSpacingR();
+  const DataT gridSpacingZ = getSpacingZ();
+  const DataT ratioZ = gridSpacingR * gridSpacingR / (gridSpacingZ * gridSpacingZ); // ratio_{Z} = gridSize_{r} / gridSize_{z}
+
+  LOGP(info, "{}", fmt::format("PoissonMultiGrid3DRedBlack: in Poisson Solver 3D multi grid full coarsening with red-black relaxation Nr={}, cols={}, Nphi={}, threads={}", Nr, Nz, Nphi, sNThreads));
+
+  // Check that the number of Nr and Nz is suitable for a binary expansion
+  if (!isPowerOfTwo((Nr - 1))) {
+    LOGP(ERROR, "PoissonMultiGrid3DRedBlack: Error in the number of Nr. Must be 2**M + 1");
+    return;
+  }
+  if (!isPowerOfTwo((Nz - 1))) {
+    LOGP(ERROR, "PoissonMultiGrid3DRedBlack: Error in the number of Nz. Must be 2**N - 1");
+    return;
+  }
+  if (Nphi <= 3) {
+    LOGP(ERROR, "PoissonMultiGrid3DRedBlack: Error in the number of Nphi. Must be larger than 3");
+    return;
+  }
+  if (Nphi > 1000) {
+    LOGP(ERROR, "PoissonMultiGrid3DRedBlack: Nphi > 1000 is not allowed (nor wise)");
+    return;
+  }
+
+  int nGridRow = 0; // number grid
+  int nGridCol = 0; // number grid
+  int nGridPhi = 0;
+
+  int nnRow = Nr;
+  while (nnRow >>= 1) {
+    ++nGridRow;
+  }
+
+  int nnCol = Nz;
+  while (nnCol >>= 1) {
+    ++nGridCol;
+  }
+
+  int nnPhi = Nphi;
+  while (nnPhi % 2 == 0) {
+    ++nGridPhi;
+    nnPhi *= 0.5;
+  }
+
+  LOGP(info, "{}", fmt::format("PoissonMultiGrid3DRedBlack: nGridRow={}, nGridCol={}, nGridPhi={}", nGridRow, nGridCol, nGridPhi));
+  const int nLoop = std::max({nGridRow, nGridCol, nGridPhi}); // Calculate the number of nLoop for the binary expansion
+
+  // 1) Memory allocation for multi grid: same grids as in poissonMultiGrid3D, phi is coarsened as long as the number of phi vertices is even
+  std::vector<VectorPhi> tvArrayV(nLoop);     // potential <--> error
+  std::vector<VectorPhi> tvChargeFMG(nLoop);  // charge is restricted in full multiGrid
+  std::vector<VectorPhi> tvCharge(nLoop);     // charge <--> residue
+  std::vector<VectorPhi> tvPrevArrayV(nLoop); // error calculation
+  std::vector<VectorPhi> tvResidue(nLoop);    // residue calculation
+  for (int count = 0; count < nLoop; ++count) {
+    const int one = 1 << count;
+    const int tnRRow = count == 0 ? Nr : Nr / one + 1;
+    const int tnZColumn = count == 0 ? Nz : Nz / one + 1;
+    const int tPhiSlice = std::max(static_cast<int>(Nphi) / one, nnPhi);
+    tvArrayV[count].resize(tnRRow, tnZColumn, tPhiSlice);
+    tvChargeFMG[count].resize(tnRRow, tnZColumn, tPhiSlice);
+    tvCharge[count].resize(tnRRow, tnZColumn, tPhiSlice);
+    tvPrevArrayV[count].resize(tnRRow, tnZColumn, tPhiSlice);
+    tvResidue[count].resize(tnRRow, tnZColumn, tPhiSlice);
+  }
+
+  // memory for the finest grid is from parameters
+#pragma omp parallel for num_threads(sNThreads)
+  for (int ir = 0; ir < Nr; ++ir) {
+    for (int iz = 0; iz < Nz; ++iz) {
+      for (int iphi = 0; iphi < Nphi; ++iphi) {
+        tvChargeFMG[0](ir, iz, iphi) = matricesCharge(iz, ir, iphi);
+        tvArrayV[0](ir, iz, iphi) = matricesV(iz, ir, iphi);
+      }
+      tvArrayV[0].fillGhostVertices(ir, iz, symmetry);
+    }
+  }
+  tvCharge[0] = tvChargeFMG[0];
+
+  std::array<DataT, Nr> coefficient1{};        // coefficient1(Nr) for storing (1 + h_{r}/2r_{i}) from central differences in r direction
+  std::array<DataT, Nr> coefficient2{};        // coefficient2(Nr) for storing (1 + h_{r}/2r_{i}) from central differences in r direction
+  std::array<DataT, Nr> coefficient3{};        // coefficient3(Nr) for storing (1/r_{i}^2) from central differences in phi direction
+  std::array<DataT, Nr> coefficient4{};        // coefficient4(Nr) for storing  1/2
+  std::array<DataT, Nr> inverseCoefficient4{}; // inverse of coefficient4(Nr)
+
+  // Case full multi grid (FMG)
+  if (MGParameters::cycleType == CycleType::FCycle) {
+    // 1) Restrict Charge and Boundary to coarser grid
+    for (int count = 1; count < nLoop; ++count) {
+      restrict3DRedBlack(tvChargeFMG[count], tvChargeFMG[count - 1], symmetry);
+      // copy boundary values of V
+      restrictBoundary3DRedBlack(tvArrayV[count], tvArrayV[count - 1], symmetry);
+    }
+
+    // 2) Relax on the coarsest grid
+    const VectorPhi& coarsestV = tvArrayV[nLoop - 1];
+    const DataT h = calcCoefficientsRedBlack(nLoop - 1, coarsestV.getNr(), coarsestV.getNphi(), ratioZ, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+    relax3DRedBlack(tvArrayV[nLoop - 1], tvChargeFMG[nLoop - 1], symmetry, h * h, ratioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+
+    // 3) V Cycle from coarsest to finest
+    for (int count = nLoop - 2; count >= 0; --count) {
+      // a) interpolate from 2h --> h grid
+      interp3DRedBlack(tvArrayV[count], tvArrayV[count + 1], symmetry, false);
+
+      // Copy the relax charge to the tvCharge
+      if (count > 0) {
+        tvCharge[count] = tvChargeFMG[count];
+      }
+      for (int mgCycle = 0; mgCycle < MGParameters::nMGCycle; ++mgCycle) {
+        // copy to store previous potential
+        tvPrevArrayV[count] = tvArrayV[count];
+
+        vCycle3DRedBlack(symmetry, count + 1, nLoop, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue);
+
+        // if already converge just break move to finer grid
+        if (getConvergenceError(tvArrayV[count], tvPrevArrayV[count]) <= sConvergenceError) {
+          break;
+        }
+      }
+    }
+  } else if (MGParameters::cycleType == CycleType::VCycle) {
+    for (int mgCycle = 0; mgCycle < MGParameters::nMGCycle; ++mgCycle) {
+      // copy to store previous potential
+      tvPrevArrayV[0] = tvArrayV[0];
+
+      // Do V Cycle from the coarsest to finest grid
+      vCycle3DRedBlack(symmetry, 1, nLoop, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue);
+
+      // if error already achieved then stop mg iteration
+      if (getConvergenceError(tvArrayV[0], tvPrevArrayV[0]) <= sConvergenceError) {
+        break;
+      }
+    }
+  }
+
+  // fill output
+#pragma omp parallel for num_threads(sNThreads)
+  for (int iphi = 0; iphi < Nphi; ++iphi) {
+    for (int ir = 0; ir < Nr; ++ir) {
+      for (int iz = 0; iz < Nz; ++iz) {
+        matricesV(iz, ir, iphi) = tvArrayV[0](ir, iz, iphi);
+      }
+    }
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::vCycle3DRedBlack(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const DataT ratioZ, std::vector<VectorPhi>& tvArrayV,
+                                                          std::vector<VectorPhi>& tvCharge, std::vector<VectorPhi>& tvResidue) const
+{
+  std::array<DataT, Nr> coefficient1{};
+  std::array<DataT, Nr> coefficient2{};
+  std::array<DataT, Nr> coefficient3{};
+  std::array<DataT, Nr> coefficient4{};
+  std::array<DataT, Nr> inverseCoefficient4{};
+
+  // r and z are coarsened in the same way: the ratio between the grid sizes is the same on all levels
+  for (int count = gridFrom; count <= gridTo - 1; ++count) {
+    const VectorPhi& arrayV = tvArrayV[count - 1];
+    const DataT h = calcCoefficientsRedBlack(count - 1, arrayV.getNr(), arrayV.getNphi(), ratioZ, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+    const DataT h2 = h * h;
+
+    // 1) Pre-Smoothing: Gauss-Seidel Relaxation
+    for (int jPre = 1; jPre <= nPre; ++jPre) {
+      relax3DRedBlack(tvArrayV[count - 1], tvCharge[count - 1], symmetry, h2, ratioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+    }
+
+    // 2) Residue calculation
+    residue3DRedBlack(tvResidue[count - 1], tvArrayV[count - 1], tvCharge[count - 1], symmetry, 1 / h2, ratioZ, coefficient1, coefficient2, coefficient3, inverseCoefficient4);
+
+    // 3) Restriction
+    restrict3DRedBlack(tvCharge[count], tvResidue[count - 1], symmetry);
+
+    // 4) Zeroing coarser V
+    std::fill(tvArrayV[count].begin(), tvArrayV[count].end(), 0);
+  }
+
+  // 5) Relax on the coarsest grid
+  const VectorPhi& coarsestV = tvArrayV[gridTo - 1];
+  const DataT h = calcCoefficientsRedBlack(gridTo - 1, coarsestV.getNr(), coarsestV.getNphi(), ratioZ, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+  relax3DRedBlack(tvArrayV[gridTo - 1], tvCharge[gridTo - 1], symmetry, h * h, ratioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+
+  // back to fine
+  for (int count = gridTo - 1; count >= gridFrom; --count) {
+    // 6) Interpolation/Prolongation
+    interp3DRedBlack(tvArrayV[count - 1], tvArrayV[count], symmetry, true);
+
+    const VectorPhi& arrayV = tvArrayV[count - 1];
+    const DataT h = calcCoefficientsRedBlack(count - 1, arrayV.getNr(), arrayV.getNphi(), ratioZ, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+
+    // 7) Post-Smoothing: Gauss-Seidel Relaxation
+    for (int jPost = 1; jPost <= nPost; ++jPost) {
+      relax3DRedBlack(tvArrayV[count - 1], tvCharge[count - 1], symmetry, h * h, ratioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+    }
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::relax3DRedBlack(VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentCharge, const int symmetry, const DataT h2, const DataT tempRatioZ,
+                                                         const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& coefficient4) const
+{
+  const int tnRRow = matricesCurrentV.getNr();
+  const int tnZColumn = matricesCurrentV.getNz();
+  const int tnPhi = matricesCurrentV.getNphi();
+  const int nBlocksR = (tnRRow - 2 + RELAXBLOCKR - 1) / RELAXBLOCKR;
+  const int nBlocksZ = (tnZColumn - 2 + RELAXBLOCKZ - 1) / RELAXBLOCKZ;
+
+  // red vertices: (i + j + m) even, black vertices: (i + j + m) odd.
+  // All neighbours of a vertex have the other colour, the vertices of one colour can be relaxed in any order
+  for (int colour = 0; colour < 2; ++colour) {
+#pragma omp parallel for collapse(2) schedule(static) num_threads(sNThreads)
+    for (int blockR = 0; blockR < nBlocksR; ++blockR) {
+      for (int blockZ = 0; blockZ < nBlocksZ; ++blockZ) {
+        const int iFirst = 1 + blockR * RELAXBLOCKR;
+        const int iLast = std::min(iFirst + RELAXBLOCKR, tnRRow - 1);
+        const int jFirst = 1 + blockZ * RELAXBLOCKZ;
+        const int jLast = std::min(jFirst + RELAXBLOCKZ, tnZColumn - 1);
+        for (int i = iFirst; i < iLast; ++i) {
+          const DataT c1 = coefficient1[i];
+          const DataT c2 = coefficient2[i];
+          const DataT c3 = coefficient3[i];
+          const DataT c4 = coefficient4[i];
+          for (int j = jFirst; j < jLast; ++j) {
+            DataT* v = matricesCurrentV.getLine(i, j);
+            const DataT* vRMinus = matricesCurrentV.getLine(i - 1, j);
+            const DataT* vRPlus = matricesCurrentV.getLine(i + 1, j);
+            const DataT* vZMinus = matricesCurrentV.getLine(i, j - 1);
+            const DataT* vZPlus = matricesCurrentV.getLine(i, j + 1);
+            const DataT* charge = matricesCurrentCharge.getLine(i, j);
+#pragma omp simd
+            for (int m = (i + j + colour) % 2; m < tnPhi; m += 2) {
+              v[m] = (c2 * vRMinus[m] + tempRatioZ * (vZMinus[m] + vZPlus[m]) + c1 * vRPlus[m] + c3 * (v[m + 1] + v[m - 1]) + h2 * charge[m]) * c4;
+            }
+            // the ghost vertices are only read by the relaxation of this phi line
+            matricesCurrentV.fillGhostVertices(i, j, symmetry);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::residue3DRedBlack(VectorPhi& residue, const VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentCharge, const int symmetry, const DataT ih2, const DataT tempRatioZ,
+                                                           const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& inverseCoefficient4) const
+{
+  const int tnRRow = matricesCurrentV.getNr();
+  const int tnZColumn = matricesCurrentV.getNz();
+  const int tnPhi = matricesCurrentV.getNphi();
+
+#pragma omp parallel for collapse(2) num_threads(sNThreads)
+  for (int i = 1; i < tnRRow - 1; ++i) {
+    for (int j = 1; j < tnZColumn - 1; ++j) {
+      const DataT c1 = coefficient1[i];
+      const DataT c2 = coefficient2[i];
+      const DataT c3 = coefficient3[i];
+      const DataT ic4 = inverseCoefficient4[i];
+      DataT* res = residue.getLine(i, j);
+      const DataT* v = matricesCurrentV.getLine(i, j);
+      const DataT* vRMinus = matricesCurrentV.getLine(i - 1, j);
+      const DataT* vRPlus = matricesCurrentV.getLine(i + 1, j);
+      const DataT* vZMinus = matricesCurrentV.getLine(i, j - 1);
+      const DataT* vZPlus = matricesCurrentV.getLine(i, j + 1);
+      const DataT* charge = matricesCurrentCharge.getLine(i, j);
+#pragma omp simd
+      for (int m = 0; m < tnPhi; ++m) {
+        res[m] = ih2 * (c2 * vRMinus[m] + tempRatioZ * (vZMinus[m] + vZPlus[m]) + c1 * vRPlus[m] + c3 * (v[m + 1] + v[m - 1]) - ic4 * v[m]) + charge[m];
+      }
+      residue.fillGhostVertices(i, j, symmetry);
+    }
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::restrict3DRedBlack(VectorPhi& matricesCurrentCharge, const VectorPhi& residue, const int symmetry) const
+{
+  const int tnRRow = matricesCurrentCharge.getNr();
+  const int tnZColumn = matricesCurrentCharge.getNz();
+  const int newPhiSlice = matricesCurrentCharge.getNphi();
+  const int oldPhiSlice = residue.getNphi();
+  const bool restrictPhi = (oldPhiSlice == 2 * newPhiSlice);
+
+#pragma omp parallel num_threads(sNThreads)
+  {
+    std::vector<DataT> weightedLine(oldPhiSlice + 2); // weighted sum in r and z of the fine phi lines around a coarse phi line (including the ghost vertices)
+#pragma omp for
+    for (int i = 1; i < tnRRow - 1; ++i) {
+      for (int j = 1; j < tnZColumn - 1; ++j) {
+        std::fill(weightedLine.begin(), weightedLine.end(), 0);
+        DataT* sum = weightedLine.data() + 1;
+        for (int di = -1; di <= 1; ++di) {
+          for (int dj = -1; dj <= 1; ++dj) {
+            // full weighting: 1/4 for the vertex, 1/8 for the direct and 1/16 for the diagonal neighbours
+            const DataT weight = (di == 0 ? 0.5 : 0.25) * (dj == 0 ? 0.5 : 0.25);
+            const DataT* fine = residue.getLine(2 * i + di, 2 * j + dj);
+#pragma omp simd
+            for (int m = -1; m <= oldPhiSlice; ++m) {
+              sum[m] += weight * fine[m];
+            }
+          }
+        }
+
+        DataT* coarse = matricesCurrentCharge.getLine(i, j);
+        if (restrictPhi) {
+          for (int m = 0; m < newPhiSlice; ++m) {
+            coarse[m] = 0.5 * sum[2 * m] + 0.25 * (sum[2 * m - 1] + sum[2 * m + 1]);
+          }
+        } else {
+          std::copy(sum, sum + newPhiSlice, coarse);
+        }
+        matricesCurrentCharge.fillGhostVertices(i, j, symmetry);
+      }
+    }
+  }
+
+  restrictBoundary3DRedBlack(matricesCurrentCharge, residue, symmetry);
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::restrictBoundary3DRedBlack(VectorPhi& matricesCurrentCharge, const VectorPhi& residue, const int symmetry) const
+{
+  const int tnRRow = matricesCurrentCharge.getNr();
+  const int tnZColumn = matricesCurrentCharge.getNz();
+  const int newPhiSlice = matricesCurrentCharge.getNphi();
+  const int phiStep = (residue.getNphi() == 2 * newPhiSlice) ? 2 : 1;
+
+  const auto copyLine = [&](const int i, const int j) {
+    DataT* coarse = matricesCurrentCharge.getLine(i, j);
+    const DataT* fine = residue.getLine(2 * i, 2 * j);
+    for (int m = 0; m < newPhiSlice; ++m) {
+      coarse[m] = fine[phiStep * m];
+    }
+    matricesCurrentCharge.fillGhostVertices(i, j, symmetry);
+  };
+
+  for (int j = 0; j < tnZColumn; ++j) {
+    copyLine(0, j);
+    copyLine(tnRRow - 1, j);
+  }
+  for (int i = 0; i < tnRRow; ++i) {
+    copyLine(i, 0);
+    copyLine(i, tnZColumn - 1);
+  }
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void PoissonSolver<DataT, Nz, Nr, Nphi>::interp3DRedBlack(VectorPhi& matricesCurrentV, const VectorPhi& matricesCurrentVC, const int symmetry, const bool add) const
+{
+  const int tnRRow = matricesCurrentV.getNr();
+  const int tnZColumn = matricesCurrentV.getNz();
+  const int newPhiSlice = matricesCurrentV.getNphi();
+  const int oldPhiSlice = matricesCurrentVC.getNphi();
+  const bool interpPhi = (newPhiSlice == 2 * oldPhiSlice);
+
+#pragma omp parallel num_threads(sNThreads)
+  {
+    std::vector<DataT> weightedLine(oldPhiSlice + 2); // coarse phi line interpolated in r and z (including the ghost vertices)
+#pragma omp for
+    for (int i = 1; i < tnRRow - 1; ++i) {
+      for (int j = 1; j < tnZColumn - 1; ++j) {
+        std::fill(weightedLine.begin(), weightedLine.end(), 0);
+        DataT* sum = weightedLine.data() + 1;
+        // vertices with odd index are located between two coarse vertices
+        const int nR = 1 + (i % 2);
+        const int nZ = 1 + (j % 2);
+        const DataT weight = DataT(1) / (nR * nZ);
+        for (int di = 0; di < nR; ++di) {
+          for (int dj = 0; dj < nZ; ++dj) {
+            const DataT* coarse = matricesCurrentVC.getLine(i / 2 + di, j / 2 + dj);
+#pragma omp simd
+            for (int m = -1; m <= oldPhiSlice; ++m) {
+              sum[m] += weight * coarse[m];
+            }
+          }
+        }
+
+        DataT* fine = matricesCurrentV.getLine(i, j);
+        for (int m = 0; m < newPhiSlice; ++m) {
+          DataT value = sum[m];
+          if (interpPhi) {
+            const int mHalf = m / 2;
+            value = (m % 2) ? 0.5 * (sum[mHalf] + sum[mHalf + 1]) : sum[mHalf];
+          }
+          fine[m] = add ? fine[m] + value : value;
+        }
+        matricesCurrentV.fillGhostVertices(i, j, symmetry);
+      }
+    }
+  }
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::wCycle2D(const int gridFrom, const int gridTo, const int gamma, const int nPre, const int nPost, const DataT gridSizeR, const DataT ratio,
                                                   std::vector<Vector>& tvArrayV, std::vector<Vector>& tvCharge, std::vector<Vector>& tvResidue)
@@ -1466,6 +1866,53 @@ DataT PoissonSolver<DataT, Nz, Nr, Nphi>::getConvergenceError(const Vector& matr
   return *std::max_element(std::begin(errorArr), std::end(errorArr));
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+DataT PoissonSolver<DataT, Nz, Nr, Nphi>::getConvergenceError(const VectorPhi& matricesCurrentV, const VectorPhi& prevArrayV) const
+{
+  const int tnRRow = matricesCurrentV.getNr();
+  const int tnZColumn = matricesCurrentV.getNz();
+  const int tnPhi = matricesCurrentV.getNphi();
+
+  // sum of the squared differences for each r and phi vertex. The sum over r is done afterwards in a fixed order to be independent of the number of threads
+  std::vector<DataT> errorArr(tnRRow * tnPhi);
+#pragma omp parallel for num_threads(sNThreads)
+  for (int i = 0; i < tnRRow; ++i) {
+    DataT* error = &errorArr[i * tnPhi];
+    for (int j = 0; j < tnZColumn; ++j) {
+      const DataT* current = matricesCurrentV.getLine(i, j);
+      const DataT* prev = prevArrayV.getLine(i, j);
+#pragma omp simd
+      for (int m = 0; m < tnPhi; ++m) {
+        const DataT diff = prev[m] - current[m];
+        error[m] += diff * diff;
+      }
+    }
+  }
+
+  for (int i = 1; i < tnRRow; ++i) {
+    for (int m = 0; m < tnPhi; ++m) {
+      errorArr[m] += errorArr[i * tnPhi + m];
+    }
+  }
+  // return largest error
+  return *std::max_element(errorArr.begin(), errorArr.begin() + tnPhi);
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+DataT PoissonSolver<DataT, Nz, Nr, Nphi>::calcCoefficientsRedBlack(const int level, const int tnRRow, const int tnPhi, const DataT ratioZ, std::array<DataT, Nr>& coefficient1, std::array<DataT, Nr>& coefficient2,
+                                                                   std::array<DataT, Nr>& coefficient3, std::array<DataT, Nr>& coefficient4, std::array<DataT, Nr>& inverseCoefficient4) const
+{
+  const DataT h = getSpacingR() * (1 << level);
+  const DataT h2 = h * h;
+  const DataT gridSizePhiInv = tnPhi * INVTWOPI;                   // h_{phi}
+  const DataT tempRatioPhi = h2 * gridSizePhiInv * gridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
+  calcCoefficients(1, tnRRow - 1, h, ratioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
+  for (int i = 1; i < tnRRow - 1; ++i) {
+    inverseCoefficient4[i] = 1.0 / coefficient4[i];
+  }
+  return h;
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::calcCoefficients(unsigned int from, unsigned int to, const DataT h, const DataT tempRatioZ, const DataT tempRatioPhi, std::array<DataT, Nr>& coefficient1, std::array<DataT, Nr>& coefficient2, std::array<DataT, Nr>& coefficient3, std::array<DataT, Nr>& coefficient4) const
 {
@@ -233,7 +233,11 @@ void SpaceCharge<DataT, Nz, Nr, Nphi>::poissonSolver(const Side side, const int
 {
   ASolv::setConvergenceError(stoppingConvergence);
   ASolv poissonSolver(mGrid3D[0]);
-  poissonSolver.poissonSolver3D(mPotential[side], mDensity[side], symmetry);
+  if (sPoissonSolverType == PoissonSolverType::MultiGridRedBlack) {
+    poissonSolver.poissonSolver3DRedBlack(mPotential[side], mDensity[side], symmetry);
+  } else {
+    poissonSolver.poissonSolver3D(mPotential[side], mDensity[side], symmetry);
+  }
 }
 
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
@@ -1273,6 +1277,40 @@ void SpaceCharge<DataT, Nz, Nr, Nphi>::getCorrections(const DataT x, const DataT
   corrY = getYFromPolar(radiusCorr, phiCorr) - y; // difference between corrected and original y coordinate
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void SpaceCharge<DataT, Nz, Nr, Nphi>::getCorrectionsCyl(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, const Side side, std::vector<DataT>& corrZ, std::vector<DataT>& corrR, std::vector<DataT>& corrRPhi) const
+{
+  mInterpolatorGlobalCorr[side].evalBatch(z, r, phi, corrZ, corrR, corrRPhi);
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void SpaceCharge<DataT, Nz, Nr, Nphi>::getCorrections(const std::vector<DataT>& x, const std::vector<DataT>& y, const std::vector<DataT>& z, const Side side, std::vector<DataT>& corrX, std::vector<DataT>& corrY, std::vector<DataT>& corrZ) const
+{
+  // convert cartesian to polar
+  const size_t nPoints = x.size();
+  std::vector<DataT> radius(nPoints);
+  std::vector<DataT> phi(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    radius[i] = getRadiusFromCartesian(x[i], y[i]);
+    phi[i] = getPhiFromCartesian(x[i], y[i]);
+  }
+
+  std::vector<DataT> corrR;
+  std::vector<DataT> corrRPhi;
+  getCorrectionsCyl(z, radius, phi, side, corrZ, corrR, corrRPhi);
+
+  corrX.resize(nPoints);
+  corrY.resize(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    // Calculate corrected position
+    const DataT radiusCorr = radius[i] + corrR[i];
+    const DataT phiCorr = phi[i] + corrRPhi[i] / radius[i];
+
+    corrX[i] = getXFromPolar(radiusCorr, phiCorr) - x[i]; // difference between corrected and original x coordinate
+    corrY[i] = getYFromPolar(radiusCorr, phiCorr) - y[i]; // difference between corrected and original y coordinate
+  }
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void SpaceCharge<DataT, Nz, Nr, Nphi>::getLocalDistortionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& ldistZ, DataT& ldistR, DataT& ldistRPhi) const
 {
@@ -1324,6 +1362,40 @@ void SpaceCharge<DataT, Nz, Nr, Nphi>::getDistortions(const DataT x, const DataT
   distY = getYFromPolar(radiusDist, phiDist) - y; // difference between distorted and original y coordinate
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void SpaceCharge<DataT, Nz, Nr, Nphi>::getDistortionsCyl(const std::vector<DataT>& z, const std::vector<DataT>& r, const std::vector<DataT>& phi, const Side side, std::vector<DataT>& distZ, std::vector<DataT>& distR, std::vector<DataT>& distRPhi) const
+{
+  mInterpolatorGlobalDist[side].evalBatch(z, r, phi, distZ, distR, distRPhi);
+}
+
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void SpaceCharge<DataT, Nz, Nr, Nphi>::getDistortions(const std::vector<DataT>& x, const std::vector<DataT>& y, const std::vector<DataT>& z, const Side side, std::vector<DataT>& distX, std::vector<DataT>& distY, std::vector<DataT>& distZ) const
+{
+  // convert cartesian to polar
+  const size_t nPoints = x.size();
+  std::vector<DataT> radius(nPoints);
+  std::vector<DataT> phi(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    radius[i] = getRadiusFromCartesian(x[i], y[i]);
+    phi[i] = getPhiFromCartesian(x[i], y[i]);
+  }
+
+  std::vector<DataT> distR;
+  std::vector<DataT> distRPhi;
+  getDistortionsCyl(z, radius, phi, side, distZ, distR, distRPhi);
+
+  distX.resize(nPoints);
+  distY.resize(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    // Calculate distorted position
+    const DataT radiusDist = radius[i] + distR[i];
+    const DataT phiDist = phi[i] + distRPhi[i] / radius[i];
+
+    distX[i] = getXFromPolar(radiusDist, phiDist) - x[i]; // difference between distorted and original x coordinate
+    distY[i] = getYFromPolar(radiusDist, phiDist) - y[i]; // difference between distorted and original y coordinate
+  }
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void SpaceCharge<DataT, Nz, Nr, Nphi>::init()
 {
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_PoissonSolver.cxx
+/// \brief  Benchmark of the 3D multi grid poisson solvers for the default TPC grid (129x129x180)
+
+#include "benchmark/benchmark.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+
+using namespace o2::tpc;
+
+using DataT = double;
+static constexpr size_t NZ = 129;
+static constexpr size_t NR = 129;
+static constexpr size_t NPHI = 180;
+using GridProp = GridProperties<DataT, NR, NZ, NPHI>;
+using DataContainer = DataContainer3D<DataT, NZ, NR, NPHI>;
+using Solver = PoissonSolver<DataT, NZ, NR, NPHI>;
+
+// solve the poisson equation for the analytical charge density with the boundary of the analytical potential
+// state.range(0): 0 for poissonSolver3D, 1 for poissonSolver3DRedBlack, state.range(1): number of threads
+static void BM_PoissonSolver3D(benchmark::State& state)
+{
+  const bool redBlack = state.range(0);
+  Solver::setNThreads(state.range(1));
+  MGParameters::isFull3D = true;
+
+  const RegularGrid3D<DataT, NZ, NR, NPHI> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::GRIDSPACINGZ, GridProp::GRIDSPACINGR, GridProp::GRIDSPACINGPHI};
+  const AnalyticalFields<DataT> analyticalFields;
+  DataContainer charge{};
+  DataContainer potentialBoundary{};
+  for (size_t iPhi = 0; iPhi < NPHI; ++iPhi) {
+    const DataT phi = grid3D.getZVertex(iPhi);
+    for (size_t iR = 0; iR < NR; ++iR) {
+      const DataT radius = grid3D.getYVertex(iR);
+      for (size_t iZ = 0; iZ < NZ; ++iZ) {
+        const DataT z = grid3D.getXVertex(iZ);
+        charge(iZ, iR, iPhi) = analyticalFields.evalDensity(z, radius, phi);
+        if (iR == 0 || iR == NR - 1 || iZ == 0 || iZ == NZ - 1) {
+          potentialBoundary(iZ, iR, iPhi) = analyticalFields.evalPotential(z, radius, phi);
+        }
+      }
+    }
+  }
+
+  Solver poissonSolver(grid3D);
+  for (auto _ : state) {
+    state.PauseTiming();
+    DataContainer potential = potentialBoundary;
+    state.ResumeTiming();
+    if (redBlack) {
+      poissonSolver.poissonSolver3DRedBlack(potential, charge, 0);
+    } else {
+      poissonSolver.poissonSolver3D(potential, charge, 0);
+    }
+    benchmark::DoNotOptimize(potential(NZ / 2, NR / 2, NPHI / 2));
+  }
+  state.counters["vertices"] = benchmark::Counter(NZ * NR * NPHI * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_PoissonSolver3D)->Args({0, 1})->Args({0, 4})->Args({1, 1})->Args({1, 2})->Args({1, 4})->Args({1, 8})->Args({1, 16})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -167,7 +167,7 @@ void testAlmostEqualArray2D(o2::tpc::DataContainer3D<DataT, Nz, Nr, Nphi>& analy
 }
 
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
-void poissonSolver3D()
+void poissonSolver3D(const bool redBlack = false)
 {
   using GridProp = GridProperties<DataT, Nr, Nz, Nphi>;
   const o2::tpc::RegularGrid3D<DataT, Nz, Nr, Nphi> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::GRIDSPACINGZ, GridProp::GRIDSPACINGR, GridProp::GRIDSPACINGPHI};
@@ -188,7 +188,11 @@ void poissonSolver3D()
   //calculate numerical potential
   PoissonSolver<DataT, Nz, Nr, Nphi> poissonSolver(grid3D);
   const int symmetry = 0;
-  poissonSolver.poissonSolver3D(potentialNumerical, charge, symmetry);
+  if (redBlack) {
+    poissonSolver.poissonSolver3DRedBlack(potentialNumerical, charge, symmetry);
+  } else {
+    poissonSolver.poissonSolver3D(potentialNumerical, charge, symmetry);
+  }
 
   // compare numerical with analytical solution of the potential
   testAlmostEqualArray<DataT, Nz, Nr, Nphi>(potentialAnalytical, potentialNumerical);
@@ -233,6 +237,11 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D2D_test)
   poissonSolver3D<DataT, NZ, NR, NPHI>();
 }
 
+BOOST_AUTO_TEST_CASE(PoissonSolver3DRedBlack_test)
+{
+  poissonSolver3D<DataT, NZ, NR, NPHI>(true);
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver2D_test)
 {
   const int Nphi = 1;
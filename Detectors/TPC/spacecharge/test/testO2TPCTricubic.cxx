@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCTricubic.cxx
+/// \brief this task tests the batched tricubic interpolation and the batched evaluation of the distortions and corrections
+
+#define BOOST_TEST_MODULE Test TPC O2TPCTriCubic class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCSpaceCharge/TriCubic.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include <random>
+
+namespace o2
+{
+namespace tpc
+{
+
+using DataT = double;
+static constexpr DataT ABSTOLERANCE = 1e-10; // absolute tolerance between the batched and the point-wise interpolation
+static constexpr int NZ = 33;                // grid in z
+static constexpr int NR = 33;                // grid in r
+static constexpr int NPHI = 40;              // grid in phi
+
+BOOST_AUTO_TEST_CASE(TriCubicBatch_test)
+{
+  using TriCubic = TriCubicInterpolator<DataT, NZ, NR, NPHI>;
+  const DataT zSpacing = 250. / (NZ - 1);
+  const DataT rSpacing = (254.5 - 83.5) / (NR - 1);
+  const DataT phiSpacing = 2 * M_PI / NPHI;
+  const RegularGrid3D<DataT, NZ, NR, NPHI> grid3D(0, 83.5, 0, zSpacing, rSpacing, phiSpacing);
+  DataContainer3D<DataT, NZ, NR, NPHI> data3D;
+  for (int iz = 0; iz < NZ; ++iz) {
+    for (int ir = 0; ir < NR; ++ir) {
+      for (int iphi = 0; iphi < NPHI; ++iphi) {
+        const DataT z = grid3D.getXVertex(iz);
+        const DataT r = grid3D.getYVertex(ir);
+        const DataT phi = grid3D.getZVertex(iphi);
+        data3D(iz, ir, iphi) = std::sin(r * z / 1000.) + std::cos(phi);
+      }
+    }
+  }
+  const TriCubic interpolator(data3D, grid3D);
+
+  // query points also outside of the grid and in cells with many and with only a few points
+  const int nPoints = 50000;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<DataT> distZ(-5, 255);
+  std::uniform_real_distribution<DataT> distR(80, 258);
+  std::uniform_real_distribution<DataT> distPhi(-7, 7);
+  std::vector<DataT> z(nPoints);
+  std::vector<DataT> r(nPoints);
+  std::vector<DataT> phi(nPoints);
+  for (int i = 0; i < nPoints; ++i) {
+    z[i] = distZ(gen);
+    r[i] = i % 2 ? distR(gen) : 120.;
+    phi[i] = distPhi(gen);
+  }
+
+  std::vector<DataT> values;
+  interpolator(z, r, phi, values);
+  BOOST_CHECK_EQUAL(values.size(), static_cast<size_t>(nPoints));
+  for (int i = 0; i < nPoints; ++i) {
+    BOOST_CHECK_SMALL(values[i] - interpolator(z[i], r[i], phi[i], TriCubic::InterpolationType::Sparse), ABSTOLERANCE);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DistCorrInterpolatorBatch_test)
+{
+  using DistCorr = DistCorrInterpolator<DataT, NZ, NR, NPHI>;
+  using TriCubic = TriCubicInterpolator<DataT, NZ, NR, NPHI>;
+  const DataT zSpacing = 250. / (NZ - 1);
+  const DataT rSpacing = (254.5 - 83.5) / (NR - 1);
+  const DataT phiSpacing = 2 * M_PI / NPHI;
+  const RegularGrid3D<DataT, NZ, NR, NPHI> grid3D(0, 83.5, 0, zSpacing, rSpacing, phiSpacing);
+  DataContainer3D<DataT, NZ, NR, NPHI> dataZ;
+  DataContainer3D<DataT, NZ, NR, NPHI> dataR;
+  DataContainer3D<DataT, NZ, NR, NPHI> dataRPhi;
+  for (int iz = 0; iz < NZ; ++iz) {
+    for (int ir = 0; ir < NR; ++ir) {
+      for (int iphi = 0; iphi < NPHI; ++iphi) {
+        const DataT z = grid3D.getXVertex(iz);
+        const DataT r = grid3D.getYVertex(ir);
+        const DataT phi = grid3D.getZVertex(iphi);
+        dataZ(iz, ir, iphi) = std::sin(r * z / 1000.);
+        dataR(iz, ir, iphi) = std::cos(phi) * r / 100.;
+        dataRPhi(iz, ir, iphi) = std::sin(phi + z / 100.);
+      }
+    }
+  }
+  DistCorr distCorr(dataR, dataZ, dataRPhi, grid3D, Side::A);
+
+  const int nPoints = 10000;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<DataT> distZ(0, 250);
+  std::uniform_real_distribution<DataT> distR(83.5, 254.5);
+  std::uniform_real_distribution<DataT> distPhi(0, 2 * M_PI);
+  std::vector<DataT> z(nPoints);
+  std::vector<DataT> r(nPoints);
+  std::vector<DataT> phi(nPoints);
+  for (int i = 0; i < nPoints; ++i) {
+    z[i] = distZ(gen);
+    r[i] = distR(gen);
+    phi[i] = distPhi(gen);
+  }
+
+  // the batched evaluation follows the interpolation type of the interpolator
+  for (const auto type : {TriCubic::InterpolationType::Sparse, TriCubic::InterpolationType::Dense}) {
+    distCorr.setInterpolationType(type);
+    std::vector<DataT> dZ;
+    std::vector<DataT> dR;
+    std::vector<DataT> dRPhi;
+    distCorr.evalBatch(z, r, phi, dZ, dR, dRPhi);
+    BOOST_CHECK_EQUAL(dZ.size(), static_cast<size_t>(nPoints));
+    for (int i = 0; i < nPoints; ++i) {
+      BOOST_CHECK_SMALL(dZ[i] - distCorr.evaldZ(z[i], r[i], phi[i]), ABSTOLERANCE);
+      BOOST_CHECK_SMALL(dR[i] - distCorr.evaldR(z[i], r[i], phi[i]), ABSTOLERANCE);
+      BOOST_CHECK_SMALL(dRPhi[i] - distCorr.evaldRPhi(z[i], r[i], phi[i]), ABSTOLERANCE);
+    }
+  }
+}
+
+} // namespace tpc
+} // namespace o2
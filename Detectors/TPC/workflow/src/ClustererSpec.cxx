@@ -48,10 +48,12 @@ DataProcessorSpec getClustererSpec(bool sendMC)
 
   constexpr static size_t NSectors = o2::tpc::Sector::MAXSECTOR;
   struct ProcessAttributes {
-    std::vector<o2::tpc::ClusterHardwareContainer8kb> clusterArray;
-    MCLabelContainer mctruthArray;
+    // every sector has its own output containers, so that the clusterers of different sectors can run concurrently
+    std::array<std::vector<o2::tpc::ClusterHardwareContainer8kb>, NSectors> clusterArrays;
+    std::array<MCLabelContainer, NSectors> mctruthArrays;
     std::array<std::shared_ptr<o2::tpc::HwClusterer>, NSectors> clusterers;
     int verbosity = 1;
+    int nThreads = 1;
     bool sendMC = false;
   };
 
@@ -62,16 +64,25 @@ DataProcessorSpec getClustererSpec(bool sendMC)
     // parameter to the clusterer processing function.
     auto processAttributes = std::make_shared<ProcessAttributes>();
     processAttributes->sendMC = sendMC;
+    processAttributes->nThreads = std::max(1, ic.options().get<int>("threads"));
 
-    auto processSectorFunction = [processAttributes](ProcessingContext& pc, DataRef const& dataref, DataRef const& mclabelref) {
-      auto& clusterArray = processAttributes->clusterArray;
-      auto& mctruthArray = processAttributes->mctruthArray;
+    struct SectorInputDesc {
+      DataRef dataref;
+      DataRef mclabelref;
+    };
+
+    // prepare the clusterer of the sector, control information is forwarded directly
+    // returns false if there is no data to be clustered
+    auto prepareSectorFunction = [processAttributes](ProcessingContext& pc, SectorInputDesc const& input,
+                                                     gsl::span<o2::tpc::Digit const>& inDigits, ConstMCLabelContainerView& inMCLabels) {
       auto& clusterers = processAttributes->clusterers;
       auto& verbosity = processAttributes->verbosity;
+      auto const& dataref = input.dataref;
+      auto const& mclabelref = input.mclabelref;
       auto const* sectorHeader = DataRefUtils::getHeader<o2::tpc::TPCSectorHeader*>(dataref);
       if (sectorHeader == nullptr) {
         LOG(ERROR) << "sector header missing on header stack";
-        return;
+        return false;
       }
       auto const* dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(dataref);
       o2::header::DataHeader::SubSpecificationType fanSpec = dataHeader->subSpecification;
@@ -85,41 +96,41 @@ DataProcessorSpec getClustererSpec(bool sendMC)
         if (DataRefUtils::isValid(mclabelref)) {
           pc.outputs().snapshot(Output{gDataOriginTPC, "CLUSTERHWMCLBL", fanSpec, Lifetime::Timeframe, {header}}, fanSpec);
         }
-        return;
+        return false;
       }
-      ConstMCLabelContainerView inMCLabels;
       if (DataRefUtils::isValid(mclabelref)) {
         inMCLabels = pc.inputs().get<gsl::span<char>>(mclabelref);
       }
-      auto inDigits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(dataref);
+      inDigits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(dataref);
       if (verbosity > 0 && inMCLabels.getBuffer().size()) {
         LOG(INFO) << "received " << inDigits.size() << " digits, "
                   << inMCLabels.getIndexedSize() << " MC label objects"
                   << " input MC label size " << DataRefUtils::getPayloadSize(mclabelref);
       }
       if (!clusterers[sector]) {
-        // create the clusterer for this sector, take the same target arrays for all clusterers
-        // as they are not invoked in parallel
+        // create the clusterer for this sector with its own target arrays
         // the cost of creating the clusterer should be small so we do it in the processing
-        clusterers[sector] = std::make_shared<o2::tpc::HwClusterer>(&clusterArray, sector, &mctruthArray);
+        clusterers[sector] = std::make_shared<o2::tpc::HwClusterer>(&processAttributes->clusterArrays[sector], sector, &processAttributes->mctruthArrays[sector]);
         clusterers[sector]->init();
       }
-      auto& clusterer = clusterers[sector];
-
       if (verbosity > 0) {
         LOG(INFO) << "processing " << inDigits.size() << " digit object(s) of sector " << sectorHeader->sector()
                   << " input size " << DataRefUtils::getPayloadSize(dataref);
       }
-      // process the digits and MC labels, the bool parameter controls whether to clear all
-      // internal data or not. Have to clear it inside the process method as not only the containers
-      // are cleared but also the cluster counter. Clearing the containers externally leaves the
-      // cluster counter unchanged and leads to an inconsistency between cluster container and
-      // MC label container (the latter just grows with every call).
-      clusterer->process(inDigits, inMCLabels, true /* clear output containers and cluster counter */);
-      const std::vector<o2::tpc::Digit> emptyDigits;
-      ConstMCLabelContainerView emptyLabels;
-      clusterer->finishProcess(emptyDigits, emptyLabels, false); // keep here the false, otherwise the clusters are lost of they are not stored in the meantime
-      if (verbosity > 0) {
+      return true;
+    };
+
+    // send the clusters and MC labels of a processed sector
+    auto sendSectorFunction = [processAttributes](ProcessingContext& pc, SectorInputDesc const& input) {
+      auto const& dataref = input.dataref;
+      auto const& mclabelref = input.mclabelref;
+      auto const* sectorHeader = DataRefUtils::getHeader<o2::tpc::TPCSectorHeader*>(dataref);
+      auto const* dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(dataref);
+      o2::header::DataHeader::SubSpecificationType fanSpec = dataHeader->subSpecification;
+      const auto sector = sectorHeader->sector();
+      auto& clusterArray = processAttributes->clusterArrays[sector];
+      auto& mctruthArray = processAttributes->mctruthArrays[sector];
+      if (processAttributes->verbosity > 0) {
         LOG(INFO) << "clusterer produced "
                   << std::accumulate(clusterArray.begin(), clusterArray.end(), size_t(0), [](size_t l, auto const& r) { return l + r.getContainer()->numberOfClusters; })
                   << " cluster(s)"
@@ -140,18 +151,10 @@ DataProcessorSpec getClustererSpec(bool sendMC)
       }
     };
 
-    auto processingFct = [processAttributes, processSectorFunction](ProcessingContext& pc) {
-      struct SectorInputDesc {
-        DataRef dataref;
-        DataRef mclabelref;
-      };
+    auto processingFct = [processAttributes, prepareSectorFunction, sendSectorFunction](ProcessingContext& pc) {
       // loop over all inputs and their parts and associate data with corresponding mc truth data
       // by the subspecification
       std::map<int, SectorInputDesc> inputs;
-      std::vector<InputSpec> filter = {
-        {"check", ConcreteDataTypeMatcher{gDataOriginTPC, "DIGITS"}, Lifetime::Timeframe},
-        {"check", ConcreteDataTypeMatcher{gDataOriginTPC, "DIGITSMCTR"}, Lifetime::Timeframe},
-      };
       for (auto const& inputRef : InputRecordWalker(pc.inputs())) {
         auto const* sectorHeader = DataRefUtils::getHeader<o2::tpc::TPCSectorHeader*>(inputRef);
         if (sectorHeader == nullptr) {
@@ -166,11 +169,34 @@ DataProcessorSpec getClustererSpec(bool sendMC)
           inputs[sector].mclabelref = inputRef;
         }
       }
+      // the framework calls (input access, output allocation) are done sequentially, only the
+      // clusterization of the sectors, which share no data, runs concurrently
+      std::vector<SectorInputDesc const*> sectorInputs;
+      std::vector<o2::tpc::HwClusterer*> sectorClusterers;
+      std::vector<gsl::span<o2::tpc::Digit const>> sectorDigits;
+      std::vector<ConstMCLabelContainerView> sectorMCLabels;
       for (auto const& input : inputs) {
         if (processAttributes->sendMC && !DataRefUtils::isValid(input.second.mclabelref)) {
           throw std::runtime_error("missing the required MC label data for sector " + std::to_string(input.first));
         }
-        processSectorFunction(pc, input.second.dataref, input.second.mclabelref);
+        gsl::span<o2::tpc::Digit const> inDigits;
+        ConstMCLabelContainerView inMCLabels;
+        if (!prepareSectorFunction(pc, input.second, inDigits, inMCLabels)) {
+          continue;
+        }
+        sectorInputs.push_back(&input.second);
+        sectorClusterers.push_back(processAttributes->clusterers[input.first].get());
+        sectorDigits.push_back(inDigits);
+        sectorMCLabels.push_back(inMCLabels);
+      }
+      // process the digits and MC labels, the output containers and the cluster counter are cleared
+      // inside the process method. Clearing the containers externally leaves the cluster counter
+      // unchanged and leads to an inconsistency between cluster container and MC label container
+      // (the latter just grows with every call).
+      o2::tpc::HwClusterer::processSectors(sectorClusterers, sectorDigits, sectorMCLabels, processAttributes->nThreads);
+      // outputs are sent in the sector order, independent of the number of threads
+      for (auto const* input : sectorInputs) {
+        sendSectorFunction(pc, *input);
       }
     };
     return processingFct;
@@ -203,7 +229,9 @@ DataProcessorSpec getClustererSpec(bool sendMC)
   return DataProcessorSpec{processorName,
                            {createInputSpecs(sendMC)},
                            {createOutputSpecs(sendMC)},
-                           AlgorithmSpec(initFunction)};
+                           AlgorithmSpec(initFunction),
+                           Options{
+                             {"threads", VariantType::Int, 1, {"Number of threads for the concurrent clusterization of the sectors"}}}};
 }
 
 } // namespace tpc
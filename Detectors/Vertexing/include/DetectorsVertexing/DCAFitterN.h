@@ -17,6 +17,7 @@
 #ifndef _ALICEO2_DCA_FITTERN_
 #define _ALICEO2_DCA_FITTERN_
 #include <TMath.h>
+#include <vector>
 #include "MathUtils/Cartesian.h"
 #include "ReconstructionDataFormats/Track.h"
 #include "DetectorsVertexing/HelixHelper.h"
@@ -94,6 +95,25 @@ class DCAFitterN
   using ArrTrPos = std::array<Vec3D, N>;         // container of Track positions
 
  public:
+  ///< SoA output of the batched processing: best PCA candidate of each prongs combination
+  struct BatchResult {
+    std::vector<int> nCand;     // number of PCA candidates found, the rest is defined only if >0
+    std::vector<int> nIter;     // number of iterations for the best candidate
+    std::vector<float> chi2;    // chi2 at the best candidate
+    std::vector<float> x, y, z; // best candidate position
+    size_t size() const { return nCand.size(); }
+    void resize(size_t n)
+    {
+      nCand.resize(n);
+      nIter.resize(n);
+      chi2.resize(n);
+      x.resize(n);
+      y.resize(n);
+      z.resize(n);
+    }
+  };
+  using Combination = std::array<int, N>; // indices of the prongs of the candidate in the input containers
+
   static constexpr int getNProngs() { return N; }
 
   DCAFitterN() = default;
@@ -186,6 +206,25 @@ class DCAFitterN
 
   template <class... Tr>
   int process(const Tr&... args);
+
+  ///< batched processing of combinations of prongs: i-th prong of every combination is taken from the i-th container.
+  ///  The auxiliary track parameters are evaluated once per track rather than once per combination, results are
+  ///  identical to those of process called for each combination. Returns the number of combinations with at least 1 PCA
+  int processBatch(const std::array<const std::vector<Track>*, N>& prongs, const std::vector<Combination>& combs, BatchResult& res);
+
+  ///< set the containers of the prongs (i-th prong from i-th container) for the batched processing of their combinations
+  ///  by processCombination: the auxiliary track parameters are evaluated once per track. The containers must not change
+  ///  while their combinations are processed
+  template <class... C>
+  void setBatchProngs(const C&... prongs)
+  {
+    static_assert(sizeof...(prongs) == N, "incorrect number of input containers");
+    assignBatch(0, prongs...);
+  }
+
+  ///< fit PCA of the combination of the tracks of the containers set by setBatchProngs, identical to process called with
+  ///  these tracks, after which the fitter can be queried in the same way
+  int processCombination(const Combination& comb);
   void print() const;
 
  protected:
@@ -207,6 +246,7 @@ class DCAFitterN
   bool minimizeChi2NoErr();
   bool roughDZCut() const;
   bool closerToAlternative() const;
+  int processAssigned();
   static double getAbsMax(const VecND& v);
 
   ///< track param positions at V0 candidate (no check for the candidate validity)
@@ -245,6 +285,27 @@ class DCAFitterN
     assign(i + 1, args...);
   }
 
+  void assignBatch(int) {}
+  template <class C, class... Cr>
+  void assignBatch(int i, const C& tracks, const Cr&... rest)
+  {
+    static_assert(std::is_convertible<typename C::value_type, Track>(), "Wrong track type");
+    assignBatchProng(i, tracks);
+    assignBatch(i + 1, rest...);
+  }
+  template <class C>
+  void assignBatchProng(int i, const C& tracks)
+  {
+    auto& aux = mBatchTrAux[i];
+    auto& ptr = mBatchTrPtr[i];
+    aux.resize(tracks.size());
+    ptr.resize(tracks.size());
+    for (size_t it = 0; it < tracks.size(); it++) { // aux. params (circle and alpha sin/cos) of each input track are shared by all its combinations
+      ptr[it] = &tracks[it];
+      aux[it].set(tracks[it], mBz);
+    }
+  }
+
   void clear()
   {
     mCurHyp = 0;
@@ -269,8 +330,10 @@ class DCAFitterN
   MatSymND mCosDif;    // matrix with cos(alp_j-alp_i) for j<i
   MatSymND mSinDif;    // matrix with sin(alp_j-alp_i) for j<i
   std::array<const Track*, N> mOrigTrPtr;
-  std::array<TrackAuxPar, N> mTrAux; // Aux track info for each track at each cand. vertex
-  CrossInfo mCrossings;              // info on track crossing
+  std::array<TrackAuxPar, N> mTrAux;                   // Aux track info for each track at each cand. vertex
+  std::array<std::vector<TrackAuxPar>, N> mBatchTrAux; //! Aux track info of the input tracks of the batched processing
+  std::array<std::vector<const Track*>, N> mBatchTrPtr; //! input tracks of the batched processing
+  CrossInfo mCrossings;                                // info on track crossing
 
   std::array<ArrTrackCovI, MAXHYP> mTrcEInv; // errors for each track at each cand. vertex
   std::array<ArrTrack, MAXHYP> mCandTr;      // tracks at each cond. vertex (Note: Errors are at seed XY point)
@@ -311,10 +374,57 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
   // This is a main entry point: fit PCA of N tracks
   static_assert(sizeof...(args) == N, "incorrect number of input tracks");
   assign(0, args...);
-  clear();
   for (int i = 0; i < N; i++) {
     mTrAux[i].set(*mOrigTrPtr[i], mBz);
   }
+  return processAssigned();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterN<N, Args...>::processBatch(const std::array<const std::vector<Track>*, N>& prongs, const std::vector<Combination>& combs, BatchResult& res)
+{
+  // fit PCA for each combination of prongs, filling the SoA result
+  for (int i = 0; i < N; i++) {
+    assignBatchProng(i, *prongs[i]);
+  }
+  int nFound = 0;
+  size_t nComb = combs.size();
+  res.resize(nComb);
+  for (size_t ic = 0; ic < nComb; ic++) {
+    int nc = processCombination(combs[ic]);
+    res.nCand[ic] = nc;
+    if (nc) {
+      const auto& pca = getPCACandidate();
+      res.nIter[ic] = getNIterations();
+      res.chi2[ic] = getChi2AtPCACandidate();
+      res.x[ic] = pca[0];
+      res.y[ic] = pca[1];
+      res.z[ic] = pca[2];
+      nFound++;
+    }
+  }
+  return nFound;
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterN<N, Args...>::processCombination(const Combination& comb)
+{
+  // fit PCA of N tracks of the batch, using their precalculated aux. params
+  for (int i = 0; i < N; i++) {
+    mOrigTrPtr[i] = mBatchTrPtr[i][comb[i]];
+    mTrAux[i] = mBatchTrAux[i][comb[i]];
+  }
+  return processAssigned();
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterN<N, Args...>::processAssigned()
+{
+  // fit PCA of N tracks already assigned to mOrigTrPtr, with aux. params in mTrAux
+  clear();
   if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni)) { // even for N>2 it should be enough to test just 1 loop
     return 0;                                                                  // no crossing
   }
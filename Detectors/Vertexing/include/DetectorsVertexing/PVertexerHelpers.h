@@ -42,6 +42,13 @@ struct VertexingInput {
   float scaleSigma2 = 10;
 };
 
+///< vertices found for single VertexingInput, with local indices of contributing tracks
+struct VertexingOutput {
+  std::vector<PVertex> vertices;
+  std::vector<uint32_t> trackIDs;
+  std::vector<V2TRef> v2tRefs;
+};
+
 ///< weights and scaling params for current vertex
 struct VertexSeed : public PVertex {
   double wghSum = 0.;                                                                              // sum of tracks weights
@@ -77,6 +77,13 @@ class SVertexer
   void setMeanVertex(const o2d::VertexBase& v) { mMeanVertex = v; }
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
+  size_t getNPairsTested() const { return mNPairsTested; }
+  const std::vector<TrackCand>& getTracksPool(int posneg) const { return mTracksPool[posneg]; }
+
+  ///< call f(itn) for every negative seed itn sharing a vertex with the positive seed itp, restricting to those with
+  ///  |tgl difference| <= maxDTgl if the latter is positive
+  template <typename F>
+  void forEachV0Candidate(int itp, float maxDTgl, F&& f) const;
 
   template <typename V0CONT, typename V0REFCONT, typename CASCCONT, typename CASCREFCONT>
   void extractSecondaryVertices(V0CONT& v0s, V0REFCONT& vtx2V0Refs, CASCCONT& cascades, CASCREFCONT& vtx2CascRefs);
@@ -86,6 +93,7 @@ class SVertexer
   int checkCascades(float r2v0, std::array<float, 3> pV0, float p2v0, int avoidTrackID, int posneg, int ithread);
   void setupThreads();
   void buildT2V(const o2::globaltracking::RecoContainer& recoTracks);
+  void buildNegTglIndex();
   void updateTimeDependentParams();
 
   uint64_t getPairIdx(GIndex id1, GIndex id2) const
@@ -98,6 +106,10 @@ class SVertexer
   std::vector<std::vector<Cascade>> mCascadesTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  // pair index: negative seeds grouped by their lowest-ID vertex and sorted in tgl within the group
+  std::vector<int> mNegGroupStart; // start of the group of each vertex in mNegTglOrder, +1 entry for the end
+  std::vector<int> mNegTglOrder;   // indices of the negative seeds in mTracksPool[NEG]
+  std::vector<float> mNegTgl;      // tgl of the seeds in mNegTglOrder
   o2d::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
   std::array<SVertexHypothesis, NHypV0> mV0Hyps;
@@ -113,8 +125,27 @@ class SVertexer
   float mMaxR2ToMeanVertexCascV0 = 0;
 
   bool mEnableCascades = true;
+  size_t mNPairsTested = 0; // number of pairs fed to the V0 fitter in the last TF
 };
 
+template <typename F>
+void SVertexer::forEachV0Candidate(int itp, float maxDTgl, F&& f) const
+{
+  // negative seeds sharing a vertex with seedP are those whose lowest-ID vertex is within the seedP vertex bracket,
+  // within each vertex group only those with compatible tgl are considered
+  const auto& seedP = mTracksPool[POS][itp];
+  for (int iv = seedP.vBracket.getMin(); iv <= seedP.vBracket.getMax(); iv++) {
+    auto itFirst = mNegTgl.begin() + mNegGroupStart[iv], itLast = mNegTgl.begin() + mNegGroupStart[iv + 1];
+    if (maxDTgl > 0.f) {
+      itFirst = std::lower_bound(itFirst, itLast, seedP.getTgl() - maxDTgl);
+      itLast = std::upper_bound(itFirst, itLast, seedP.getTgl() + maxDTgl);
+    }
+    for (auto it = itFirst; it < itLast; ++it) {
+      f(mNegTglOrder[it - mNegTgl.begin()]);
+    }
+  }
+}
+
 // input containers can be std::vectors or pmr vectors
 template <typename V0CONT, typename V0REFCONT, typename CASCCONT, typename CASCREFCONT>
 void SVertexer::extractSecondaryVertices(V0CONT& v0s, V0REFCONT& vtx2V0Refs, CASCCONT& cascades, CASCREFCONT& vtx2CascRefs)
@@ -40,7 +40,22 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
 
-  for (auto tc : mTimeZClusters) {
+  // time clusters share no tracks, so they can be processed concurrently. Each cluster fills its own output, which are
+  // merged in the order of clusters, so that the result does not depend on the number of threads.
+  // Largest clusters are processed first for better load balancing.
+  int nClus = mTimeZClusters.size();
+  std::vector<VertexingOutput> clusOutput(nClus);
+  std::vector<int> clusOrder(nClus);
+  std::iota(clusOrder.begin(), clusOrder.end(), 0);
+  std::sort(clusOrder.begin(), clusOrder.end(), [this](int i, int j) {
+    return mTimeZClusters[i].trackIDs.size() > mTimeZClusters[j].trackIDs.size();
+  });
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ic = 0; ic < nClus; ic++) {
+    auto& tc = mTimeZClusters[clusOrder[ic]];
+    auto& out = clusOutput[clusOrder[ic]];
     VertexingInput inp;
     inp.idRange = gsl::span<int>(tc.trackIDs);
     inp.scaleSigma2 = mPVParams->iniScale2;
@@ -48,8 +63,9 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
 #ifdef _PV_DEBUG_TREE_
     doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    findVertices(inp, out.vertices, out.trackIDs, out.v2tRefs);
   }
+  mergeVertexingOutput(clusOutput, verticesLoc, trackIDs, v2tRefsLoc);
 
   // sort in time
   std::vector<int> vtTimeSortID(verticesLoc.size());
@@ -442,10 +458,14 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
       trc.bin = -1;
     }
   }
-  // refit vertices with reattached tracks
+  // refit vertices with reattached tracks, every track is attached to at most 1 vertex, so they can be refitted concurrently
   v2tRefs.clear();
   trackIDs.clear();
   std::vector<PVertex> verticesUpd;
+  std::vector<VertexingOutput> vtxOutput(nvtOrig);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
   for (int ivt = 0; ivt < nvtOrig; ivt++) {
     auto& clusZT = mTimeZClusters[ivt];
     auto& vtx = vertices[ivt];
@@ -460,8 +480,10 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
       vtx.setNContributors(0);
       continue;
     }
-    finalizeVertex(inp, vtx, verticesUpd, v2tRefs, trackIDs);
+    auto& out = vtxOutput[ivt];
+    finalizeVertex(inp, vtx, out.vertices, out.v2tRefs, out.trackIDs);
   }
+  mergeVertexingOutput(vtxOutput, verticesUpd, trackIDs, v2tRefs);
   // reorder in time since the time-stamp of vertices might have been changed
   vertices.swap(verticesUpd);
   timeSort.resize(vertices.size());
@@ -667,6 +689,34 @@ void PVertexer::finalizeVertex(const VertexingInput& input, const PVertex& vtx,
   ref.setEntries(trackIDs.size() - ref.getFirstEntry());
 }
 
+//___________________________________________________________________
+void PVertexer::mergeVertexingOutput(std::vector<VertexingOutput>& parts, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs)
+{
+  // append vertices found for independent inputs, shifting the references to global track IDs and vertex IDs
+  for (auto& part : parts) {
+    int vtxOffs = vertices.size(), trcOffs = trackIDs.size();
+    vertices.insert(vertices.end(), part.vertices.begin(), part.vertices.end());
+    for (const auto& ref : part.v2tRefs) {
+      v2tRefs.emplace_back(ref.getFirstEntry() + trcOffs, ref.getEntries());
+    }
+    for (auto id : part.trackIDs) {
+      mTracksPool[id].vtxID += vtxOffs;
+    }
+    trackIDs.insert(trackIDs.end(), part.trackIDs.begin(), part.trackIDs.end());
+    part = VertexingOutput{};
+  }
+}
+
+//___________________________________________________________________
+void PVertexer::setNThreads(int n)
+{
+#if defined(WITH_OPENMP) && !defined(_PV_DEBUG_TREE_)
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
 //___________________________________________________________________
 void PVertexer::createMCLabels(gsl::span<const o2::MCCompLabel> lblTracks,
                                const std::vector<uint32_t>& trackIDs, const std::vector<V2TRef>& v2tRefs,
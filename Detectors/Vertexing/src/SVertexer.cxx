@@ -18,6 +18,9 @@
 #include "ReconstructionDataFormats/TrackTPCITS.h"
 #include "DataFormatsTPC/TrackTPC.h"
 #include "DataFormatsITS/TrackITS.h"
+#include <TStopwatch.h>
+#include <algorithm>
+#include <numeric>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -34,29 +37,32 @@ using TrackTPC = o2::tpc::TrackTPC;
 void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // accessor to various reconstrucred data types
 {
   updateTimeDependentParams(); // TODO RS: strictly speaking, one should do this only in case of the CCDB objects update
+  TStopwatch timer;
   mPVertices = recoData.getPrimaryVertices();
   buildT2V(recoData); // build track->vertex refs from vertex->track (if other workflow will need this, consider producing a message in the VertexTrackMatcher)
-  int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size(), iThread = 0;
+  for (auto& fitter : mFitterV0) { // aux. params of each seed are evaluated once, rather than for every pair it enters
+    fitter.setBatchProngs(mTracksPool[POS], mTracksPool[NEG]);
+  }
+  int ntrP = mTracksPool[POS].size(), iThread = 0;
   mV0sTmp[0].clear();
   mCascadesTmp[0].clear();
+  const float maxDTgl = mSVParams->maxV0TglAbsDiff;
+  size_t nPairs = 0;
 
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
   int dynGrp = std::min(4, std::max(1, mNThreads / 2));
-#pragma omp parallel for schedule(dynamic, dynGrp)
+#pragma omp parallel for schedule(dynamic, dynGrp) reduction(+ : nPairs)
 #endif
   for (int itp = 0; itp < ntrP; itp++) {
     auto& seedP = mTracksPool[POS][itp];
-    for (int itn = mVtxFirstTrack[NEG][seedP.vBracket.getMin()]; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
-      auto& seedN = mTracksPool[NEG][itn];
-      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
-        break;
-      }
 #ifdef WITH_OPENMP
-      iThread = omp_get_thread_num();
+    iThread = omp_get_thread_num();
 #endif
-      checkV0(seedP, seedN, itp, itn, iThread);
-    }
+    forEachV0Candidate(itp, maxDTgl, [&](int itn) {
+      checkV0(seedP, mTracksPool[NEG][itn], itp, itn, iThread);
+      nPairs++;
+    });
   }
 #ifdef WITH_OPENMP
   for (int i = 1; i < mNThreads; i++) { // merge results of all threads
@@ -69,7 +75,11 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // ac
     mCascadesTmp[i].clear();
   }
 #endif
-  LOG(INFO) << "DONE : " << mV0sTmp[0].size() << " " << mCascadesTmp[0].size();
+  mNPairsTested = nPairs;
+  timer.Stop();
+  float dt = std::max(timer.RealTime(), 1e-9);
+  LOGF(INFO, "Found %lu V0s and %lu cascades out of %lu pairs in %.3e s with %d thread(s): %.3e V0/s, %.3e cascades/s, %.3e pairs/s",
+       mV0sTmp[0].size(), mCascadesTmp[0].size(), mNPairsTested, dt, mNThreads, mV0sTmp[0].size() / dt, mCascadesTmp[0].size() / dt, mNPairsTested / dt);
 }
 
 //__________________________________________________________________
@@ -201,14 +211,42 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
     }
   }
 
+  buildNegTglIndex();
+
   LOG(INFO) << "Collected " << mTracksPool[POS].size() << " positive and " << mTracksPool[NEG].size() << " negative seeds";
 }
 
+//__________________________________________________________________
+void SVertexer::buildNegTglIndex()
+{
+  // negative seeds are ordered in the lowest-ID compatible vertex, sort them in tgl within each vertex group
+  const auto& tracksPool = mTracksPool[NEG];
+  int nv = mVtxFirstTrack[NEG].size(), ntr = tracksPool.size();
+  mNegGroupStart.clear();
+  mNegGroupStart.resize(nv + 1, ntr);
+  for (int it = ntr; it--;) {
+    mNegGroupStart[tracksPool[it].vBracket.getMin()] = it;
+  }
+  for (int iv = nv; iv--;) { // empty groups start where the next one does
+    mNegGroupStart[iv] = std::min(mNegGroupStart[iv], mNegGroupStart[iv + 1]);
+  }
+  mNegTglOrder.resize(ntr);
+  std::iota(mNegTglOrder.begin(), mNegTglOrder.end(), 0);
+  for (int iv = 0; iv < nv; iv++) {
+    std::sort(mNegTglOrder.begin() + mNegGroupStart[iv], mNegTglOrder.begin() + mNegGroupStart[iv + 1],
+              [&tracksPool](int a, int b) { return tracksPool[a].getTgl() < tracksPool[b].getTgl(); });
+  }
+  mNegTgl.resize(ntr);
+  for (int i = 0; i < ntr; i++) {
+    mNegTgl[i] = tracksPool[mNegTglOrder[i]].getTgl();
+  }
+}
+
 //__________________________________________________________________
 bool SVertexer::checkV0(TrackCand& seedP, TrackCand& seedN, int iP, int iN, int ithread)
 {
   auto& fitterV0 = mFitterV0[ithread];
-  int nCand = fitterV0.process(seedP, seedN);
+  int nCand = fitterV0.processCombination({iP, iN}); // same as fitterV0.process(seedP, seedN)
   if (nCand == 0) { // discard this pair
     return false;
   }
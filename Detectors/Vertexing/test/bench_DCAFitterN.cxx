@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_DCAFitterN.cxx
+/// \brief  Benchmark of the 2-prong DCA fitter: scalar processing of prongs pairs vs batched processing
+
+#include "benchmark/benchmark.h"
+#include "DetectorsVertexing/DCAFitterN.h"
+#include <random>
+#include <vector>
+
+using namespace o2::vertexing;
+
+constexpr float Bz = -5.;
+
+// nTracks of each charge with displaced origin, all positive-negative combinations are fitted
+struct PairsSetup {
+  std::vector<o2::track::TrackParCov> pos, neg;
+  std::vector<DCAFitter2::Combination> combs;
+
+  PairsSetup(int nTracks)
+  {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> rnd(0., 1.);
+    std::normal_distribution<float> gaus(0., 1.);
+    std::array<float, o2::track::kCovMatSize> cov = {1e-4, 0., 1e-4, 0., 0., 1e-6, 0., 0., 0., 1e-6, 0., 0., 0., 0., 1e-3};
+    for (int it = 0; it < 2 * nTracks; it++) {
+      float pt = 0.2f + 2.f * rnd(gen), q = it < nTracks ? 1.f : -1.f;
+      std::array<float, o2::track::kNParams> par = {0.5f * gaus(gen), 0.5f * gaus(gen), 0.3f * (rnd(gen) - 0.5f), 2.f * (rnd(gen) - 0.5f), q / pt};
+      o2::track::TrackParCov trc(5.f * rnd(gen), 2.f * float(M_PI) * (rnd(gen) - 0.5f), par, cov);
+      (q > 0 ? pos : neg).push_back(trc);
+    }
+    for (int ip = 0; ip < nTracks; ip++) {
+      for (int in = 0; in < nTracks; in++) {
+        combs.push_back({ip, in});
+      }
+    }
+  }
+};
+
+DCAFitter2 createFitter()
+{
+  DCAFitter2 ft;
+  ft.setBz(Bz);
+  ft.setUseAbsDCA(true);
+  ft.setPropagateToPCA(false);
+  return ft;
+}
+
+static void BM_DCAFitterScalar(benchmark::State& state)
+{
+  PairsSetup setup(state.range(0));
+  auto ft = createFitter();
+  int nFound = 0;
+  for (auto _ : state) {
+    nFound = 0;
+    for (const auto& c : setup.combs) {
+      nFound += ft.process(setup.pos[c[0]], setup.neg[c[1]]) > 0;
+    }
+    benchmark::DoNotOptimize(nFound);
+  }
+  state.counters["found"] = nFound;
+  state.counters["pairs/s"] = benchmark::Counter(double(setup.combs.size()) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+static void BM_DCAFitterBatch(benchmark::State& state)
+{
+  PairsSetup setup(state.range(0));
+  auto ft = createFitter();
+  DCAFitter2::BatchResult res;
+  int nFound = 0;
+  for (auto _ : state) {
+    nFound = ft.processBatch({&setup.pos, &setup.neg}, setup.combs, res);
+    benchmark::DoNotOptimize(nFound);
+  }
+  state.counters["found"] = nFound;
+  state.counters["pairs/s"] = benchmark::Counter(double(setup.combs.size()) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// arg: number of tracks of each charge
+BENCHMARK(BM_DCAFitterScalar)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DCAFitterBatch)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_PVertexer.cxx
+/// \brief  Throughput benchmark of the primary vertex finder on synthetic TF data
+
+#include "benchmark/benchmark.h"
+#include "DetectorsVertexing/PVertexer.h"
+#include "DetectorsBase/Propagator.h"
+#include <random>
+#include <vector>
+
+using namespace o2::vertexing;
+using GTrackID = o2::dataformats::GlobalTrackID;
+
+// TF of nColl collisions uniformly distributed over 128 orbits. The tracks are created at the DCA to the nominal beam line,
+// so that the vertexer does not need material corrections to relate them to the mean vertex
+struct SyntheticTF {
+  std::vector<TrackWithTimeStamp> tracks;
+  std::vector<GTrackID> gids;
+
+  SyntheticTF(int nColl)
+  {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> rnd(0., 1.);
+    std::normal_distribution<float> gaus(0., 1.);
+    std::exponential_distribution<float> mult(1. / 300.);
+    const float tfDurationMUS = 128 * o2::constants::lhc::LHCOrbitMUS, sigZ = 0.01, sigT = 0.1;
+    std::array<float, o2::track::kCovMatSize> cov = {sigZ * sigZ, 0., sigZ * sigZ, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+    for (int ic = 0; ic < nColl; ic++) {
+      float zv = 6. * gaus(gen), tv = tfDurationMUS * rnd(gen);
+      int ntr = 2 + int(mult(gen));
+      for (int it = 0; it < ntr; it++) {
+        std::array<float, o2::track::kNParams> par = {0., zv + sigZ * gaus(gen), 0.05f * gaus(gen), 2.f * (rnd(gen) - 0.5f), 4.f * (rnd(gen) - 0.5f)};
+        o2::track::TrackParCov trc(0., 2.f * float(M_PI) * (rnd(gen) - 0.5f), par, cov);
+        tracks.emplace_back(TrackWithTimeStamp{trc, {tv + sigT * gaus(gen), sigT}});
+        gids.emplace_back(tracks.size() - 1, GTrackID::ITSTPC);
+      }
+    }
+  }
+};
+
+static void BM_PVertexer(benchmark::State& state)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  prop->setBz(-5.);
+  SyntheticTF tf(state.range(0));
+  o2::BunchFilling bf;
+  for (int i = 0; i < o2::constants::lhc::LHCMaxBunches; i++) {
+    bf.setBC(i);
+  }
+  PVertexer vertexer;
+  vertexer.setBunchFilling(bf);
+  vertexer.init();
+  vertexer.setNThreads(state.range(1));
+
+  std::vector<PVertex> vertices;
+  std::vector<o2::dataformats::VtxTrackIndex> vertexTrackIDs;
+  std::vector<V2TRef> v2tRefs;
+  std::vector<o2::MCEventLabel> lblVtx;
+  std::vector<o2::InteractionRecord> bcData;
+  int nVertices = 0;
+  for (auto _ : state) {
+    nVertices = vertexer.process(tf.tracks, tf.gids, bcData, vertices, vertexTrackIDs, v2tRefs, {}, lblVtx);
+  }
+  state.counters["vertices"] = nVertices;
+  state.SetItemsProcessed(state.iterations() * tf.tracks.size());
+}
+
+// args: number of collisions per TF, number of threads
+BENCHMARK(BM_PVertexer)->Args({500, 1})->Args({500, 2})->Args({500, 4})->Args({500, 8})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -387,5 +387,60 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(DCAFitterNBatch)
+{
+  // batched processing of all combinations of positive and negative prongs must reproduce the scalar one
+  constexpr int NDecays = 200;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<o2::track::TrackParCov> vctracks, posTracks, negTracks;
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (int iev = 0; iev < NDecays; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+    posTracks.push_back(vctracks[0]);
+    negTracks.push_back(vctracks[1]);
+  }
+  std::vector<DCAFitter2::Combination> combs;
+  for (int ip = 0; ip < NDecays; ip++) {
+    for (int in = 0; in < NDecays; in++) {
+      combs.push_back({ip, in});
+    }
+  }
+  for (bool absDCA : {true, false}) {
+    DCAFitter2 ft;
+    ft.setBz(bz);
+    ft.setUseAbsDCA(absDCA);
+    DCAFitter2::BatchResult res;
+    TStopwatch swB, swS;
+    int nFoundB = ft.processBatch({&posTracks, &negTracks}, combs, res);
+    swB.Stop();
+    int nFoundS = 0, nDiff = 0;
+    swS.Start();
+    for (size_t ic = 0; ic < combs.size(); ic++) {
+      int nc = ft.process(posTracks[combs[ic][0]], negTracks[combs[ic][1]]);
+      if (nc) {
+        nFoundS++;
+        const auto& pca = ft.getPCACandidate();
+        if (ft.getChi2AtPCACandidate() != res.chi2[ic] || ft.getNIterations() != res.nIter[ic] ||
+            float(pca[0]) != res.x[ic] || float(pca[1]) != res.y[ic] || float(pca[2]) != res.z[ic]) {
+          nDiff++;
+        }
+      }
+      if (nc != res.nCand[ic]) {
+        nDiff++;
+      }
+    }
+    swS.Stop();
+    LOG(INFO) << "Batched " << (absDCA ? "abs." : "weighted") << " DCA fit of " << combs.size() << " combinations: "
+              << nFoundB << " found, CPU time: " << swB.CpuTime() << " vs " << swS.CpuTime() << " for scalar processing";
+    BOOST_CHECK(nFoundB == nFoundS);
+    BOOST_CHECK(nDiff == 0);
+  }
+}
+
 } // namespace vertexing
 } // namespace o2
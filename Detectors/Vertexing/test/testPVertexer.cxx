@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PVertexer class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsVertexing/PVertexer.h"
+#include "DetectorsBase/Propagator.h"
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace vertexing
+{
+using GTrackID = o2::dataformats::GlobalTrackID;
+
+struct PVertexerOutput {
+  std::vector<PVertex> vertices;
+  std::vector<o2::dataformats::VtxTrackIndex> vertexTrackIDs;
+  std::vector<V2TRef> v2tRefs;
+};
+
+// run the vertexer on the same input with given number of threads
+PVertexerOutput runPVertexer(const std::vector<TrackWithTimeStamp>& tracks, const std::vector<GTrackID>& gids, int nThreads)
+{
+  o2::BunchFilling bf;
+  for (int i = 0; i < o2::constants::lhc::LHCMaxBunches; i++) {
+    bf.setBC(i);
+  }
+  PVertexer vertexer;
+  vertexer.setBunchFilling(bf);
+  vertexer.init();
+  vertexer.setNThreads(nThreads);
+  PVertexerOutput out;
+  std::vector<o2::MCEventLabel> lblVtx;
+  std::vector<o2::InteractionRecord> bcData;
+  vertexer.process(tracks, gids, bcData, out.vertices, out.vertexTrackIDs, out.v2tRefs, {}, lblVtx);
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(PVertexerThreads)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  prop->setBz(-5.);
+
+  // tracks at the DCA to the nominal beam line from collisions spread over 128 orbits, as in the bench_PVertexer
+  std::vector<TrackWithTimeStamp> tracks;
+  std::vector<GTrackID> gids;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  std::exponential_distribution<float> mult(1. / 100.);
+  const float tfDurationMUS = 128 * o2::constants::lhc::LHCOrbitMUS, sigZ = 0.01, sigT = 0.1;
+  std::array<float, o2::track::kCovMatSize> cov = {sigZ * sigZ, 0., sigZ * sigZ, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  for (int ic = 0; ic < 200; ic++) {
+    float zv = 6. * gaus(gen), tv = tfDurationMUS * rnd(gen);
+    int ntr = 2 + int(mult(gen));
+    for (int it = 0; it < ntr; it++) {
+      std::array<float, o2::track::kNParams> par = {0., zv + sigZ * gaus(gen), 0.05f * gaus(gen), 2.f * (rnd(gen) - 0.5f), 4.f * (rnd(gen) - 0.5f)};
+      o2::track::TrackParCov trc(0., 2.f * float(M_PI) * (rnd(gen) - 0.5f), par, cov);
+      tracks.emplace_back(TrackWithTimeStamp{trc, {tv + sigT * gaus(gen), sigT}});
+      gids.emplace_back(tracks.size() - 1, GTrackID::ITSTPC);
+    }
+  }
+
+  // the clusters processed concurrently are merged in the same order as in the sequential processing
+  auto ref = runPVertexer(tracks, gids, 1);
+  BOOST_CHECK(ref.vertices.size() > 0);
+  for (int nThreads : {2, 4}) {
+    auto out = runPVertexer(tracks, gids, nThreads);
+    BOOST_REQUIRE(out.vertices.size() == ref.vertices.size());
+    for (size_t iv = 0; iv < ref.vertices.size(); iv++) {
+      const auto &vtx = out.vertices[iv], &vtxRef = ref.vertices[iv];
+      BOOST_CHECK(vtx.getX() == vtxRef.getX() && vtx.getY() == vtxRef.getY() && vtx.getZ() == vtxRef.getZ());
+      BOOST_CHECK(vtx.getCov() == vtxRef.getCov());
+      BOOST_CHECK(vtx.getChi2() == vtxRef.getChi2());
+      BOOST_CHECK(vtx.getNContributors() == vtxRef.getNContributors());
+      BOOST_CHECK(vtx.getTimeStamp().getTimeStamp() == vtxRef.getTimeStamp().getTimeStamp());
+    }
+    BOOST_REQUIRE(out.v2tRefs.size() == ref.v2tRefs.size());
+    for (size_t ir = 0; ir < ref.v2tRefs.size(); ir++) {
+      BOOST_CHECK(out.v2tRefs[ir].getVtxID() == ref.v2tRefs[ir].getVtxID());
+      BOOST_CHECK(out.v2tRefs[ir].asString(false) == ref.v2tRefs[ir].asString(false));
+    }
+    BOOST_REQUIRE(out.vertexTrackIDs.size() == ref.vertexTrackIDs.size());
+    for (size_t it = 0; it < ref.vertexTrackIDs.size(); it++) {
+      BOOST_CHECK(out.vertexTrackIDs[it].getRaw() == ref.vertexTrackIDs[it].getRaw());
+    }
+  }
+}
+
+} // namespace vertexing
+} // namespace o2
@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test SVertexer class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsVertexing/SVertexer.h"
+#include "DetectorsBase/Propagator.h"
+#include <random>
+#include <set>
+#include <vector>
+
+namespace o2
+{
+namespace vertexing
+{
+using GTrackID = o2::dataformats::GlobalTrackID;
+using RecoContainer = o2::globaltracking::RecoContainer;
+
+BOOST_AUTO_TEST_CASE(SVertexerPairScan)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  prop->setBz(-5.);
+
+  // vertices with their own tracks, some tracks being also attached to the next vertex
+  std::vector<o2::track::TrackParCov> tracks;
+  std::vector<PVertex> vertices;
+  std::vector<o2::dataformats::VtxTrackIndex> vtxTrackIDs;
+  std::vector<o2::dataformats::VtxTrackRef> vtxRefs;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  std::array<float, o2::track::kCovMatSize> cov = {1e-4, 0., 1e-4, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+  const int nVtx = 30;
+  std::vector<GTrackID> shared; // tracks attached also to the next vertex
+  for (int iv = 0; iv < nVtx; iv++) {
+    auto& vtx = vertices.emplace_back();
+    vtx.setXYZ(0., 0., 6. * gaus(gen));
+    auto& ref = vtxRefs.emplace_back();
+    ref.setFirstEntry(vtxTrackIDs.size());
+    for (auto gid : shared) {
+      vtxTrackIDs.push_back(gid);
+    }
+    shared.clear();
+    int ntr = iv % 7 == 3 ? 0 : 1 + int(20 * rnd(gen)); // some vertices without tracks
+    for (int it = 0; it < ntr; it++) {
+      std::array<float, o2::track::kNParams> par = {0.5f * gaus(gen), vtx.getZ() + gaus(gen), 0.05f * gaus(gen), 2.f * (rnd(gen) - 0.5f), 4.f * (rnd(gen) - 0.5f)};
+      tracks.emplace_back(0., 2.f * float(M_PI) * (rnd(gen) - 0.5f), par, cov);
+      auto& gid = vtxTrackIDs.emplace_back(tracks.size() - 1, GTrackID::ITS);
+      if (iv < nVtx - 1 && rnd(gen) < 0.2) {
+        gid.setAmbiguous();
+        shared.push_back(gid);
+      }
+    }
+    ref.setEntries(vtxTrackIDs.size() - ref.getFirstEntry());
+  }
+  auto& refUnassigned = vtxRefs.emplace_back(); // last entry is for unassigned tracks
+  refUnassigned.setFirstEntry(vtxTrackIDs.size());
+  refUnassigned.setEntries(0);
+
+  RecoContainer recoData;
+  recoData.commonPool[GTrackID::ITS].registerContainer(tracks, RecoContainer::TRACKS);
+  recoData.pvtxPool.registerContainer(vertices, RecoContainer::PVTX);
+  recoData.pvtxPool.registerContainer(vtxTrackIDs, RecoContainer::PVTX_TRMTC);
+  recoData.pvtxPool.registerContainer(vtxRefs, RecoContainer::PVTX_TRMTCREFS);
+
+  SVertexer svertexer;
+  svertexer.setNThreads(1);
+  svertexer.init();
+  svertexer.process(recoData);
+
+  // exhaustive scan: pairs of positive and negative seeds sharing a vertex and with |dtgl| <= maxDTgl if the latter is positive
+  const auto &poolP = svertexer.getTracksPool(SVertexer::POS), &poolN = svertexer.getTracksPool(SVertexer::NEG);
+  BOOST_CHECK(poolP.size() > 0 && poolN.size() > 0);
+  auto exhaustiveScan = [&](float maxDTgl) {
+    std::set<std::pair<int, int>> pairs;
+    for (int itp = 0; itp < (int)poolP.size(); itp++) {
+      for (int itn = 0; itn < (int)poolN.size(); itn++) {
+        const auto &seedP = poolP[itp], &seedN = poolN[itn];
+        if (seedN.vBracket.getMin() < seedP.vBracket.getMin() || seedN.vBracket.getMin() > seedP.vBracket.getMax()) {
+          continue;
+        }
+        if (maxDTgl > 0.f && (seedN.getTgl() < seedP.getTgl() - maxDTgl || seedN.getTgl() > seedP.getTgl() + maxDTgl)) {
+          continue;
+        }
+        pairs.emplace(itp, itn);
+      }
+    }
+    return pairs;
+  };
+  auto bucketedScan = [&](float maxDTgl) {
+    std::set<std::pair<int, int>> pairs;
+    size_t nPairs = 0;
+    for (int itp = 0; itp < (int)poolP.size(); itp++) {
+      svertexer.forEachV0Candidate(itp, maxDTgl, [&](int itn) {
+        pairs.emplace(itp, itn);
+        nPairs++;
+      });
+    }
+    BOOST_CHECK_EQUAL(nPairs, pairs.size()); // every pair is visited once
+    return pairs;
+  };
+
+  auto allPairs = exhaustiveScan(-1.);
+  BOOST_CHECK_EQUAL(svertexer.getNPairsTested(), allPairs.size()); // by default all pairs are tested
+  for (float maxDTgl : {-1.f, 0.05f, 0.3f, 1.f}) {
+    auto ref = exhaustiveScan(maxDTgl), buck = bucketedScan(maxDTgl);
+    BOOST_CHECK(ref.size() > 0);
+    BOOST_CHECK(ref == buck);
+  }
+}
+
+} // namespace vertexing
+} // namespace o2
@@ -60,6 +60,9 @@ struct CompletionPolicy {
   Matcher matcher = nullptr;
   /// Actual policy which decides what to do with a partial InputRecord.
   Callback callback = nullptr;
+  /// Hint for the DataRelayer: the callback returns Wait as long as some of the
+  /// inputs is missing, so it does not need to be invoked for incomplete records.
+  bool waitsForAllInputs = false;
 
   /// Helper to create the default configuration.
   static std::vector<CompletionPolicy> createDefaultPolicies();
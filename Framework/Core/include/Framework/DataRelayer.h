@@ -20,6 +20,7 @@
 #include "Framework/TimesliceIndex.h"
 #include "Framework/Tracing.h"
 
+#include <atomic>
 #include <cstddef>
 #include <mutex>
 #include <vector>
@@ -53,8 +54,9 @@ class DataRelayer
 {
  public:
   /// DataRelayer is thread safe because we have a lock around
-  /// each method and there is no particular order in which
-  /// methods need to be called.
+  /// each method accessing the cache or the TimesliceIndex and there
+  /// is no particular order in which methods need to be called.
+  /// The cache entry status used for monitoring is updated lock-free.
   constexpr static ServiceKind service_kind = ServiceKind::Global;
   enum RelayChoice {
     WillRelay,     /// Ownership of the data has been taken
@@ -156,7 +158,12 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
   std::vector<data_matcher::VariableContext> mVariableContextes;
-  std::vector<CacheEntryStatus> mCachedStateMetrics;
+  std::vector<std::atomic<CacheEntryStatus>> mCachedStateMetrics;
+  /// Number of inputs of each slot which have data, maintained incrementally
+  /// so that completeness can be known without rescanning the inputs.
+  std::vector<size_t> mFilledInputs;
+  /// Scratch space for the routes which can match the message being relayed.
+  std::vector<size_t> mCandidateRoutes;
 
   static std::vector<std::string> sMetricsNames;
   static std::vector<std::string> sVariablesMetricsNames;
@@ -104,7 +104,9 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAll(const char* name, Compl
     }
     return CompletionPolicy::CompletionOp::Consume;
   };
-  return CompletionPolicy{name, matcher, callback};
+  CompletionPolicy policy{name, matcher, callback};
+  policy.waitsForAllInputs = true;
+  return policy;
 }
 
 CompletionPolicy CompletionPolicyHelpers::consumeWhenAny(const char* name, CompletionPolicy::Matcher matcher)
@@ -142,6 +142,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       // expired, so we create one entry
       if (part.size() == 0) {
         part.parts.resize(1);
+        mFilledInputs[ti]++;
       }
       expirator.handler(services, part[0], timestamp.value, variables);
       activity.expiredSlots++;
@@ -174,6 +175,26 @@ size_t matchToContext(void* data,
   return INVALID_INPUT;
 }
 
+/// Same as matchToContext, but only the routes in @a candidates (positions in
+/// @a index, in increasing order) are tried.
+size_t matchCandidatesToContext(void* data,
+                                std::vector<DataDescriptorMatcher> const& matchers,
+                                std::vector<size_t> const& index,
+                                std::vector<size_t> const& candidates,
+                                VariableContext& context)
+{
+  for (auto ri : candidates) {
+    auto& matcher = matchers[index[ri]];
+
+    if (matcher.match(reinterpret_cast<char const*>(data), context)) {
+      context.commit();
+      return ri;
+    }
+    context.discard();
+  }
+  return INVALID_INPUT;
+}
+
 /// Send the contents of a context as metrics, so that we can examine them in
 /// the GUI.
 void sendVariableContextMetrics(VariableContext& context, TimesliceSlot slot,
@@ -224,14 +245,30 @@ DataRelayer::RelayChoice
   // This returns the identifier for the given input. We use a separate
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
+  // Routes which match the incoming data when no variable is bound. Binding
+  // variables can only restrict a match, so these are the only routes which need
+  // to be tried against the context of each slot, rather than all of them.
+  auto& candidates = mCandidateRoutes;
+  candidates.clear();
+  {
+    VariableContext unbound;
+    for (size_t ri = 0; ri < mDistinctRoutesIndex.size(); ++ri) {
+      if (mInputMatchers[mDistinctRoutesIndex[ri]].match(reinterpret_cast<char const*>(firstPart->GetData()), unbound)) {
+        candidates.push_back(ri);
+      }
+      unbound.discard();
+    }
+  }
+
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &candidates,
                             &firstPart,
                             &index](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, context);
+    auto input = matchCandidatesToContext(firstPart->GetData(), matchers, distinctRoutes, candidates, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -257,6 +294,7 @@ DataRelayer::RelayChoice
   // hence the first if.
   auto pruneCache = [&cache,
                      &cachedStateMetrics = mCachedStateMetrics,
+                     &filledInputs = mFilledInputs,
                      &numInputTypes,
                      &index,
                      &metrics](TimesliceSlot slot) {
@@ -270,11 +308,13 @@ DataRelayer::RelayChoice
       cache[ai].clear();
       cachedStateMetrics[ai] = CacheEntryStatus::EMPTY;
     }
+    filledInputs[slot.index] = 0;
   };
 
   // Actually save the header / payload in the slot
   auto saveInSlot = [&firstPart,
                      &cachedStateMetrics = mCachedStateMetrics,
+                     &filledInputs = mFilledInputs,
                      &restOfParts,
                      &restOfPartsSize,
                      &cache,
@@ -283,6 +323,9 @@ DataRelayer::RelayChoice
     auto cacheIdx = numInputTypes * slot.index + input;
     std::vector<PartRef>& parts = cache[cacheIdx].parts;
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    if (parts.empty()) {
+      filledInputs[slot.index]++;
+    }
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     PartRef entry{std::move(firstPart), std::move(restOfParts[0])};
@@ -499,6 +542,11 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     if (mTimesliceIndex.isDirty(slot) == false) {
       continue;
     }
+    // Nothing to ask to the policy as long as some input is missing.
+    if (mCompletionPolicy.waitsForAllInputs && mFilledInputs[li] < numInputTypes) {
+      mTimesliceIndex.markAsDirty(slot, false);
+      continue;
+    }
     auto partial = getPartialRecord(li);
     auto getter = [&partial](size_t idx, size_t part) {
       if (partial[idx].size() > 0 && partial[idx].at(part).header && partial[idx].at(part).payload) {
@@ -530,16 +578,13 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
 
 void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus)
 {
-  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  // No lock needed, this only touches the status of the entries, which is atomic.
   const auto numInputTypes = mDistinctRoutesIndex.size();
-  auto& index = mTimesliceIndex;
 
   auto markInputDone = [&cachedStateMetrics = mCachedStateMetrics,
-                        &index, &numInputTypes](TimesliceSlot s, size_t arg, CacheEntryStatus oldStatus, CacheEntryStatus newStatus) {
+                        &numInputTypes](TimesliceSlot s, size_t arg, CacheEntryStatus oldStatus, CacheEntryStatus newStatus) {
     auto cacheId = s.index * numInputTypes + arg;
-    if (cachedStateMetrics[cacheId] == oldStatus) {
-      cachedStateMetrics[cacheId] = newStatus;
-    }
+    cachedStateMetrics[cacheId].compare_exchange_strong(oldStatus, newStatus);
   };
 
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
@@ -584,11 +629,12 @@ std::vector<o2::framework::MessageSet> DataRelayer::getInputsForTimeslice(Timesl
   // timeslice, so I can simply do that. I keep the assertion there because in principle
   // we should have dispatched the timeslice already!
   // FIXME: what happens when we have enough timeslices to hit the invalid one?
-  auto invalidateCacheFor = [&numInputTypes, &cachedStateMetrics = mCachedStateMetrics, &index, &cache](TimesliceSlot s) {
+  auto invalidateCacheFor = [&numInputTypes, &filledInputs = mFilledInputs, &index, &cache](TimesliceSlot s) {
     for (size_t ai = s.index * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
       assert(std::accumulate(cache[ai].begin(), cache[ai].end(), true, [](bool result, auto const& element) { return result && element.header.get() == nullptr && element.payload.get() == nullptr; }));
       cache[ai].clear();
     }
+    filledInputs[s.index] = 0;
     index.markAsInvalid(s);
   };
 
@@ -609,6 +655,7 @@ void DataRelayer::clear()
   for (auto& cache : mCache) {
     cache.clear();
   }
+  std::fill(mFilledInputs.begin(), mFilledInputs.end(), 0);
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
@@ -642,7 +689,10 @@ void DataRelayer::publishMetrics()
   mMetrics.send({(int)numInputTypes, "data_relayer/h"});
   mMetrics.send({(int)mTimesliceIndex.size(), "data_relayer/w"});
   sMetricsNames.resize(mCache.size());
-  mCachedStateMetrics.resize(mCache.size());
+  mFilledInputs.resize(mTimesliceIndex.size());
+  if (mCachedStateMetrics.size() != mCache.size()) { // atomics cannot be moved, so the status is reset
+    mCachedStateMetrics = std::vector<std::atomic<CacheEntryStatus>>(mCache.size());
+  }
   for (size_t i = 0; i < sMetricsNames.size(); ++i) {
     sMetricsNames[i] = std::string("data_relayer/") + std::to_string(i);
   }
@@ -693,11 +743,12 @@ void DataRelayer::sendContextState()
                                mMetrics, sVariablesMetricsNames);
   }
   for (size_t si = 0; si < mCachedStateMetrics.size(); ++si) {
-    mMetrics.send({static_cast<int>(mCachedStateMetrics[si]), sMetricsNames[si]});
+    auto status = mCachedStateMetrics[si].load();
+    mMetrics.send({static_cast<int>(status), sMetricsNames[si]});
     // Anything which is done is actually already empty,
     // so after we report it we mark it as such.
-    if (mCachedStateMetrics[si] == CacheEntryStatus::DONE) {
-      mCachedStateMetrics[si] = CacheEntryStatus::EMPTY;
+    if (status == CacheEntryStatus::DONE) {
+      mCachedStateMetrics[si].compare_exchange_strong(status, CacheEntryStatus::EMPTY);
     }
   }
 }
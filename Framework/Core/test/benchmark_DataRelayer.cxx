@@ -303,4 +303,76 @@ static void BM_RelaySplitParts(benchmark::State& state)
 
 BENCHMARK(BM_RelaySplitParts);
 
+/// Relay latency per message for a record with many inputs (e.g. one per
+/// subspecification), consumed only once all of them arrived. Messages of
+/// several timeslices are interleaved, so that all the pipeline slots are in use.
+static void BM_RelayManyInputs(benchmark::State& state)
+{
+  Monitoring metrics;
+  const size_t nInputs = state.range(0);
+  const size_t nInFlight = 4;
+
+  std::vector<InputRoute> inputs;
+  for (size_t i = 0; i < nInputs; ++i) {
+    inputs.emplace_back(InputRoute{InputSpec{"clusters" + std::to_string(i), "TPC", "CLUSTERS", static_cast<o2::header::DataHeader::SubSpecificationType>(i)},
+                                   i, "Fake" + std::to_string(i), 0});
+  }
+
+  std::vector<ForwardRoute> forwards;
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(16);
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<FairMQMessagePtr> messages;
+    for (size_t i = 0; i < nInputs; ++i) {
+      for (size_t t = 0; t < nInFlight; ++t) {
+        dh.subSpecification = i;
+        DataProcessingHeader dph{timeslice + t, 1};
+        Stack stack{dh, dph};
+        FairMQMessagePtr header = transport->CreateMessage(stack.size());
+        memcpy(header->GetData(), stack.data(), stack.size());
+        messages.emplace_back(std::move(header));
+        messages.emplace_back(transport->CreateMessage(100));
+      }
+    }
+    state.ResumeTiming();
+
+    size_t nCompleted = 0;
+    std::vector<RecordAction> ready;
+    for (size_t mi = 0; mi < messages.size(); mi += 2) {
+      relayer.relay(messages[mi], messages[mi + 1]);
+      ready.clear();
+      relayer.getReadyToProcess(ready);
+      for (auto& action : ready) {
+        auto result = relayer.getInputsForTimeslice(action.slot);
+        benchmark::DoNotOptimize(result);
+        if (result.size() != nInputs) {
+          state.SkipWithError("incomplete record was reported as ready");
+        }
+        nCompleted++;
+      }
+    }
+    if (nCompleted != nInFlight) {
+      state.SkipWithError("not all records were completed");
+      break;
+    }
+    timeslice += nInFlight;
+  }
+  // kIsRate | kInvert gives the time per message, printed in seconds with a unit prefix
+  state.counters["time/message"] = benchmark::Counter(state.iterations() * nInputs * nInFlight, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_RelayManyInputs)->RangeMultiplier(2)->Range(1, 64);
+
 BENCHMARK_MAIN();
@@ -119,6 +119,10 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     auto useDistortions = ic.options().get<int>("distortionType");
     auto triggeredMode = ic.options().get<bool>("TPCtriggered");
 
+    // the threads are set before the space-charge distortions, whose interpolators have per-thread caches
+    mDigitizer.setNThreads(ic.options().get<int>("TPCthreads"));
+    LOG(INFO) << "TPC: Digitizing the hits of a sector with " << mDigitizer.getNThreads() << " thread(s)";
+
     if (useDistortions > 0) {
       if (useDistortions == 1) {
         LOG(INFO) << "Using realistic space-charge distortions.";
@@ -484,7 +488,8 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
     Options{{"distortionType", VariantType::Int, 0, {"Distortion type to be used. 0 = no distortions (default), 1 = realistic distortions (not implemented yet), 2 = constant distortions"}},
             {"initialSpaceChargeDensity", VariantType::String, "", {"Path to root file containing TH3 with initial space-charge density and name of the TH3 (comma separated)"}},
             {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
-            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}}}};
+            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}},
+            {"TPCthreads", VariantType::Int, 1, {"Number of threads for the concurrent digitization of the hits of a sector"}}}};
 }
 
 o2::framework::WorkflowSpec getTPCDigitizerSpec(int nLanes, std::vector<int> const& sectors, bool mctruth, bool internalwriter)
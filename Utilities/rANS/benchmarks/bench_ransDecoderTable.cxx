@@ -0,0 +1,154 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_ransDecoderTable.cxx
+/// @author agent
+/// @since  2026-10-16
+/// @brief  decoding ns/symbol with the PackedDecoderTable vs the ReverseSymbolLookupTable + SymbolTable lookup
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include "rANS/rans.h"
+#include "rANS/internal/ReverseSymbolLookupTable.h"
+
+namespace
+{
+// Shapes of the symbol distributions seen in the o2-test-ctf-io tests for the columns dominating the decoding time.
+// These are synthetic, the parameters are tuned to reproduce the alphabet sizes and entropies of the real blocks.
+enum class Source : int { TPCqTot,      // log-normal-ish charge, 10 bit alphabet
+                          TPCtimeDiff,  // wide geometric distribution of time differences, ~14 bit alphabet
+                          ITSpatternID, // power law distribution of cluster pattern IDs, 12 bit alphabet
+                          ITSchipInc }; // narrow geometric distribution of chip ID increments
+
+std::vector<int32_t> makeSourceMessage(Source source, size_t nSymbols)
+{
+  std::mt19937 mt(42);
+  std::vector<int32_t> message(nSymbols);
+  switch (source) {
+    case Source::TPCqTot: {
+      std::lognormal_distribution<double> dist(4., 0.7);
+      std::generate(message.begin(), message.end(), [&]() { return std::min<int32_t>(dist(mt), 0x3ff); });
+      break;
+    }
+    case Source::TPCtimeDiff: {
+      std::geometric_distribution<int32_t> dist(0.0005);
+      std::generate(message.begin(), message.end(), [&]() { return std::min<int32_t>(dist(mt), 0x3fff); });
+      break;
+    }
+    case Source::ITSpatternID: {
+      std::uniform_real_distribution<double> dist(0., 1.);
+      std::generate(message.begin(), message.end(), [&]() { return std::min<int32_t>(std::pow(1. - dist(mt), -1.3) - 1., 0xfff); });
+      break;
+    }
+    case Source::ITSchipInc: {
+      std::geometric_distribution<int32_t> dist(0.3);
+      std::generate(message.begin(), message.end(), [&]() { return dist(mt); });
+      break;
+    }
+  }
+  return message;
+}
+
+constexpr size_t MessageSize = 1ull << 22;
+constexpr size_t NStreams = o2::rans::internal::DefaultNStreams;
+
+struct EncodedMessage {
+  std::vector<int32_t> source;
+  o2::rans::FrequencyTable frequencies;
+  std::vector<uint32_t> encoded;
+  size_t encodedSize = 0;
+  size_t precision = 0;
+
+  EncodedMessage(Source src, size_t requestedPrecision) : source{makeSourceMessage(src, MessageSize)}, encoded(MessageSize * 2)
+  {
+    frequencies.addSamples(source.begin(), source.end());
+    const o2::rans::Encoder64<int32_t> encoder{frequencies, requestedPrecision};
+    precision = encoder.getSymbolTablePrecision();
+    encodedSize = std::distance(encoded.data(), encoder.process<NStreams>(source.begin(), source.end(), encoded.data()));
+  }
+};
+
+void setCounters(benchmark::State& state, const EncodedMessage& message, size_t tableSizeB)
+{
+  state.counters["ns/symbol"] = benchmark::Counter(double(state.iterations()) * message.source.size(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["precision"] = message.precision;
+  state.counters["tableKB"] = tableSizeB / 1024.;
+}
+} // namespace
+
+// decoding as done by the Decoder before the PackedDecoderTable: cumulative -> symbol -> DecoderSymbol
+static void BM_DecodeReverseLUT(benchmark::State& state)
+{
+  using namespace o2::rans::internal;
+  const EncodedMessage message{static_cast<Source>(state.range(0)), static_cast<size_t>(state.range(1))};
+  const SymbolStatistics stats{message.frequencies, message.precision};
+  const ReverseSymbolLookupTable rLut{stats};
+  const SymbolTable<DecoderSymbol> symbolTable{stats};
+  std::vector<int32_t> decoded(message.source.size());
+
+  for (auto _ : state) {
+    auto inputIter = message.encoded.data() + message.encodedSize - 1;
+    InterleavedDecoder<uint64_t, uint32_t, NStreams> ransDecoder{message.precision};
+    inputIter = ransDecoder.init(inputIter);
+    typename decltype(ransDecoder)::symbols_t symbols;
+    auto it = decoded.begin();
+    for (size_t round = 0; round < decoded.size() / NStreams; ++round) {
+      for (size_t stream = 0; stream < NStreams; ++stream) {
+        const auto symbol = rLut[ransDecoder.get(stream)];
+        *it++ = symbol;
+        symbols[stream] = &symbolTable[symbol];
+      }
+      inputIter = ransDecoder.advanceSymbols(inputIter, symbols);
+    }
+    benchmark::ClobberMemory();
+  }
+  if (!std::equal(message.source.begin(), message.source.begin() + decoded.size() / NStreams * NStreams, decoded.begin())) {
+    state.SkipWithError("decoded message differs from source");
+  }
+  setCounters(state, message, rLut.size() * sizeof(int32_t) + stats.getNUsedAlphabetSymbols() * sizeof(DecoderSymbol) + symbolTable.size() * sizeof(void*));
+}
+
+static void BM_DecodePackedTable(benchmark::State& state)
+{
+  const EncodedMessage message{static_cast<Source>(state.range(0)), static_cast<size_t>(state.range(1))};
+  const o2::rans::Decoder64<int32_t> decoder{message.frequencies, message.precision};
+  const o2::rans::internal::PackedDecoderTable table{o2::rans::internal::SymbolStatistics{message.frequencies, message.precision}};
+  std::vector<int32_t> decoded(message.source.size());
+
+  for (auto _ : state) {
+    decoder.process<NStreams>(message.encoded.data() + message.encodedSize, decoded.data(), decoded.size());
+    benchmark::ClobberMemory();
+  }
+  if (!std::equal(message.source.begin(), message.source.end(), decoded.begin())) {
+    state.SkipWithError("decoded message differs from source");
+  }
+  setCounters(state, message, table.getSizeB());
+}
+
+// args: source distribution, requested precision (0: chosen by SymbolStatistics as for CTF)
+static void DecoderTableArgs(benchmark::internal::Benchmark* bench)
+{
+  for (auto source : {Source::TPCqTot, Source::TPCtimeDiff, Source::ITSpatternID, Source::ITSchipInc}) {
+    for (int precision : {0, 16, 20}) {
+      bench->Args({static_cast<int>(source), precision});
+    }
+  }
+}
+
+BENCHMARK(BM_DecodeReverseLUT)->Apply(DecoderTableArgs);
+BENCHMARK(BM_DecodePackedTable)->Apply(DecoderTableArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_ransInterleaved.cxx
+/// @author agent
+/// @since  2026-10-16
+/// @brief  throughput of the interleaved rANS coders vs the default 2 stream Encoder64/Decoder64
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "rANS/rans.h"
+
+namespace
+{
+// geometrically distributed 16 bit symbols, close to what we get from detector CTF data
+std::vector<uint16_t> makeSourceMessage(size_t nSymbols)
+{
+  std::mt19937 mt(42);
+  std::geometric_distribution<uint16_t> dist(0.01);
+  std::vector<uint16_t> message(nSymbols);
+  std::generate(message.begin(), message.end(), [&]() { return std::min<uint16_t>(dist(mt), 0xfff); });
+  return message;
+}
+
+constexpr size_t SymbolTablePrecision = 0; // let the SymbolStatistics choose the precision, as done for CTF
+constexpr size_t MessageSize = 1ull << 22;
+} // namespace
+
+template <size_t nStreams_V>
+static void BM_Encode64(benchmark::State& state)
+{
+  const auto source = makeSourceMessage(MessageSize);
+  o2::rans::FrequencyTable frequencies;
+  frequencies.addSamples(source.begin(), source.end());
+  const o2::rans::Encoder64<uint16_t> encoder{frequencies, SymbolTablePrecision};
+  std::vector<uint32_t> encodeBuffer(source.size());
+
+  for (auto _ : state) {
+    auto encodedEnd = encoder.process<nStreams_V>(source.begin(), source.end(), encodeBuffer.data());
+    benchmark::DoNotOptimize(encodedEnd);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * source.size() * sizeof(uint16_t));
+}
+
+template <size_t nStreams_V>
+static void BM_Decode64(benchmark::State& state)
+{
+  const auto source = makeSourceMessage(MessageSize);
+  o2::rans::FrequencyTable frequencies;
+  frequencies.addSamples(source.begin(), source.end());
+  const o2::rans::Encoder64<uint16_t> encoder{frequencies, SymbolTablePrecision};
+  const o2::rans::Decoder64<uint16_t> decoder{frequencies, encoder.getSymbolTablePrecision()};
+  std::vector<uint32_t> encodeBuffer(source.size());
+  const auto encodedEnd = encoder.process<nStreams_V>(source.begin(), source.end(), encodeBuffer.data());
+  std::vector<uint16_t> decodeBuffer(source.size());
+
+  for (auto _ : state) {
+    decoder.process<nStreams_V>(encodedEnd, decodeBuffer.data(), source.size());
+    benchmark::ClobberMemory();
+  }
+
+  if (!std::equal(source.begin(), source.end(), decodeBuffer.begin())) {
+    state.SkipWithError("decoded message differs from source");
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * source.size() * sizeof(uint16_t));
+}
+
+BENCHMARK_TEMPLATE(BM_Encode64, 2);
+BENCHMARK_TEMPLATE(BM_Encode64, 4);
+BENCHMARK_TEMPLATE(BM_Encode64, 8);
+BENCHMARK_TEMPLATE(BM_Encode64, 16);
+
+BENCHMARK_TEMPLATE(BM_Decode64, 2);
+BENCHMARK_TEMPLATE(BM_Decode64, 4);
+BENCHMARK_TEMPLATE(BM_Decode64, 8);
+BENCHMARK_TEMPLATE(BM_Decode64, 16);
+
+BENCHMARK_MAIN();
@@ -27,9 +27,10 @@
 
 #include "rANS/FrequencyTable.h"
 #include "rANS/internal/DecoderSymbol.h"
-#include "rANS/internal/ReverseSymbolLookupTable.h"
+#include "rANS/internal/PackedDecoderTable.h"
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
+#include "rANS/internal/InterleavedDecoder.h"
 #include "rANS/internal/DecoderBase.h"
 #include "rANS/internal/SymbolStatistics.h"
 #include "rANS/internal/helper.h"
@@ -45,15 +46,13 @@ class Decoder : public internal::DecoderBase<coder_T, stream_T, source_T>
  public:
   using internal::DecoderBase<coder_T, stream_T, source_T>::DecoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  // nStreams_V: number of interleaved rANS states, has to match the one used for encoding
+  template <size_t nStreams_V = internal::DefaultNStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength) const;
-
- private:
-  using ransDecoder_t = typename internal::DecoderBase<coder_T, stream_T, source_T>::ransDecoder_t;
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
 void Decoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength) const
 {
   using namespace internal;
@@ -72,26 +71,25 @@ void Decoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT
   // make Iter point to the last last element
   --inputIter;
 
-  ransDecoder_t rans0{this->mSymbolTablePrecission};
-  ransDecoder_t rans1{this->mSymbolTablePrecission};
-
-  inputIter = rans0.init(inputIter);
-  inputIter = rans1.init(inputIter);
-
-  for (size_t i = 0; i < (messageLength & ~1); i += 2) {
-    const int64_t s0 = this->mReverseLUT[rans0.get()];
-    const int64_t s1 = this->mReverseLUT[rans1.get()];
-    *it++ = s0;
-    *it++ = s1;
-    inputIter = rans0.advanceSymbol(inputIter, this->mSymbolTable[s0]);
-    inputIter = rans1.advanceSymbol(inputIter, this->mSymbolTable[s1]);
+  internal::InterleavedDecoder<coder_T, stream_T, nStreams_V> ransDecoder{this->mSymbolTablePrecission};
+  inputIter = ransDecoder.init(inputIter);
+
+  typename decltype(ransDecoder)::symbols_t symbols;
+  const size_t nFullRounds = messageLength / nStreams_V;
+  for (size_t round = 0; round < nFullRounds; ++round) {
+    for (size_t stream = 0; stream < nStreams_V; ++stream) {
+      const auto& entry = this->mDecoderTable[ransDecoder.get(stream)];
+      *it++ = entry.symbol;
+      symbols[stream] = &entry.decoderSymbol;
+    }
+    inputIter = ransDecoder.advanceSymbols(inputIter, symbols);
   }
 
-  // last byte, if message length was odd
-  if (messageLength & 1) {
-    const int64_t s0 = this->mReverseLUT[rans0.get()];
-    *it = s0;
-    inputIter = rans0.advanceSymbol(inputIter, this->mSymbolTable[s0]);
+  // tail of the message not filling all streams
+  for (size_t stream = 0; stream < messageLength % nStreams_V; ++stream) {
+    const auto& entry = this->mDecoderTable[ransDecoder.get(stream)];
+    *it++ = entry.symbol;
+    inputIter = ransDecoder.advanceSymbol(inputIter, entry.decoderSymbol, stream);
   }
   t.stop();
   LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
@@ -26,7 +26,7 @@
 #include <fairlogger/Logger.h>
 
 #include "rANS/internal/DecoderSymbol.h"
-#include "rANS/internal/ReverseSymbolLookupTable.h"
+#include "rANS/internal/PackedDecoderTable.h"
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
 #include "rANS/internal/DecoderBase.h"
@@ -77,7 +77,8 @@ void DedupDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, sour
   inputIter = rans.init(inputIter);
 
   for (size_t i = 0; i < (messageLength); i++) {
-    const auto s = (this->mReverseLUT)[rans.get()];
+    const auto& entry = (this->mDecoderTable)[rans.get()];
+    const auto s = entry.symbol;
 
     // deduplication
     auto duplicatesIter = duplicates.find(i);
@@ -89,7 +90,7 @@ void DedupDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, sour
       }
     }
     *it++ = s;
-    inputIter = rans.advanceSymbol(inputIter, (this->mSymbolTable)[s]);
+    inputIter = rans.advanceSymbol(inputIter, entry.decoderSymbol);
   }
 
   t.stop();
@@ -26,6 +26,7 @@
 
 #include "rANS/internal/EncoderBase.h"
 #include "rANS/internal/Encoder.h"
+#include "rANS/internal/InterleavedEncoder.h"
 #include "rANS/internal/EncoderSymbol.h"
 #include "rANS/internal/helper.h"
 #include "rANS/internal/SymbolTable.h"
@@ -44,15 +45,13 @@ class Encoder : public internal::EncoderBase<coder_T, stream_T, source_T>
   //inherit constructors;
   using internal::EncoderBase<coder_T, stream_T, source_T>::EncoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  // nStreams_V: number of interleaved rANS states, the decoder has to use the same number
+  template <size_t nStreams_V = internal::DefaultNStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
   const stream_IT process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin) const;
-
- private:
-  using ransCoder_t = typename internal::EncoderBase<coder_T, stream_T, source_T>::ransCoder_t;
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
 const stream_IT Encoder<coder_T, stream_T, source_T>::process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin) const
 {
   using namespace internal;
@@ -65,31 +64,21 @@ const stream_IT Encoder<coder_T, stream_T, source_T>::process(source_IT inputBeg
     return outputBegin;
   }
 
-  ransCoder_t rans0{this->mSymbolTablePrecission};
-  ransCoder_t rans1{this->mSymbolTablePrecission};
+  internal::InterleavedEncoder<coder_T, stream_T, nStreams_V> ransCoder{this->mSymbolTablePrecission};
 
   stream_IT outputIter = outputBegin;
   source_IT inputIT = inputEnd;
 
   const auto inputBufferSize = std::distance(inputBegin, inputEnd);
 
-  auto encode = [this](source_IT symbolIter, stream_IT outputIter, ransCoder_t& coder) {
-    const source_T symbol = *symbolIter;
-    const auto& encoderSymbol = (this->mSymbolTable)[symbol];
-    return coder.putSymbol(outputIter, encoderSymbol);
-  };
-
-  // odd number of bytes?
-  if (inputBufferSize & 1) {
-    outputIter = encode(--inputIT, outputIter, rans0);
-  }
-
+  // symbol i is encoded by stream i % nStreams_V
+  size_t stream = inputBufferSize % nStreams_V;
   while (inputIT != inputBegin) { // NB: working in reverse!
-    outputIter = encode(--inputIT, outputIter, rans1);
-    outputIter = encode(--inputIT, outputIter, rans0);
+    stream = (stream == 0 ? nStreams_V : stream) - 1;
+    const source_T symbol = *(--inputIT);
+    outputIter = ransCoder.putSymbol(outputIter, (this->mSymbolTable)[symbol], stream);
   }
-  outputIter = rans1.flush(outputIter);
-  outputIter = rans0.flush(outputIter);
+  outputIter = ransCoder.flush(outputIter);
   // first iterator past the range so that sizes, distances and iterators work correctly.
   ++outputIter;
 
@@ -108,6 +97,7 @@ const stream_IT Encoder<coder_T, stream_T, source_T>::process(source_IT inputBeg
               << "streamTypeB: " << sizeof(stream_T) << ", "
               << "coderTypeB: " << sizeof(coder_T) << ", "
               << "probabilityBits: " << this->mSymbolTablePrecission << ", "
+              << "nStreams: " << nStreams_V << ", "
               << "inputBufferSizeB: " << inputBufferSizeB << "}";
 #endif
 
@@ -28,9 +28,10 @@
 #include <fairlogger/Logger.h>
 
 #include "rANS/internal/DecoderSymbol.h"
-#include "rANS/internal/ReverseSymbolLookupTable.h"
+#include "rANS/internal/PackedDecoderTable.h"
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
+#include "rANS/internal/InterleavedDecoder.h"
 #include "rANS/internal/DecoderBase.h"
 
 namespace o2
@@ -44,15 +45,13 @@ class LiteralDecoder : public internal::DecoderBase<coder_T, stream_T, source_T>
  public:
   using internal::DecoderBase<coder_T, stream_T, source_T>::DecoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  // nStreams_V: number of interleaved rANS states, has to match the one used for encoding
+  template <size_t nStreams_V = internal::DefaultNStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const;
-
- private:
-  using ransDecoder_t = typename internal::DecoderBase<coder_T, stream_T, source_T>::ransDecoder_t;
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
 void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const
 {
   using namespace internal;
@@ -68,34 +67,36 @@ void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, so
   stream_IT inputIter = inputEnd;
   source_IT it = outputBegin;
 
-  auto decode = [&, this](ransDecoder_t& decoder) {
-    const auto cumul = decoder.get();
-    const auto streamSymbol = (this->mReverseLUT)[cumul];
-    source_T symbol = streamSymbol;
-    if (this->mSymbolTable.isEscapeSymbol(streamSymbol)) {
+  internal::InterleavedDecoder<coder_T, stream_T, nStreams_V> ransDecoder{this->mSymbolTablePrecission};
+
+  auto decode = [&, this](size_t stream) {
+    const auto& entry = (this->mDecoderTable)[ransDecoder.get(stream)];
+    source_T symbol = entry.symbol;
+    if (entry.isEscape) {
       symbol = literals.back();
       literals.pop_back();
     }
-
-    return std::make_tuple(symbol, decoder.advanceSymbol(inputIter, (this->mSymbolTable)[streamSymbol]));
+    return std::make_tuple(symbol, &entry.decoderSymbol);
   };
 
   // make Iter point to the last last element
   --inputIter;
+  inputIter = ransDecoder.init(inputIter);
 
-  ransDecoder_t rans0{this->mSymbolTablePrecission};
-  ransDecoder_t rans1{this->mSymbolTablePrecission};
-  inputIter = rans0.init(inputIter);
-  inputIter = rans1.init(inputIter);
-
-  for (size_t i = 0; i < (messageLength & ~1); i += 2) {
-    std::tie(*it++, inputIter) = decode(rans0);
-    std::tie(*it++, inputIter) = decode(rans1);
+  typename decltype(ransDecoder)::symbols_t symbols;
+  const size_t nFullRounds = messageLength / nStreams_V;
+  for (size_t round = 0; round < nFullRounds; ++round) {
+    for (size_t stream = 0; stream < nStreams_V; ++stream) {
+      std::tie(*it++, symbols[stream]) = decode(stream);
+    }
+    inputIter = ransDecoder.advanceSymbols(inputIter, symbols);
   }
 
-  // last byte, if message length was odd
-  if (messageLength & 1) {
-    std::tie(*it++, inputIter) = decode(rans0);
+  // tail of the message not filling all streams
+  for (size_t stream = 0; stream < messageLength % nStreams_V; ++stream) {
+    const auto [symbol, decoderSymbol] = decode(stream);
+    *it++ = symbol;
+    inputIter = ransDecoder.advanceSymbol(inputIter, *decoderSymbol, stream);
   }
   t.stop();
   LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
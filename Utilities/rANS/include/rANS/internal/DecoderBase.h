@@ -26,7 +26,7 @@
 
 #include "rANS/FrequencyTable.h"
 #include "rANS/internal/DecoderSymbol.h"
-#include "rANS/internal/ReverseSymbolLookupTable.h"
+#include "rANS/internal/PackedDecoderTable.h"
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
 #include "rANS/internal/SymbolStatistics.h"
@@ -45,7 +45,7 @@ class DecoderBase
 
  protected:
   using decoderSymbolTable_t = internal::SymbolTable<internal::DecoderSymbol>;
-  using reverseSymbolLookupTable_t = internal::ReverseSymbolLookupTable;
+  using decoderTable_t = internal::PackedDecoderTable;
   using ransDecoder_t = Decoder<coder_T, stream_T>;
 
  public:
@@ -65,7 +65,7 @@ class DecoderBase
  protected:
   size_t mSymbolTablePrecission{};
   decoderSymbolTable_t mSymbolTable{};
-  reverseSymbolLookupTable_t mReverseLUT{};
+  decoderTable_t mDecoderTable{}; // maps cumulative frequency to the symbol and its DecoderSymbol
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
@@ -82,9 +82,9 @@ DecoderBase<coder_T, stream_T, source_T>::DecoderBase(const FrequencyTable& freq
   t.stop();
   LOG(debug1) << "Decoder SymbolTable inclusive time (ms): " << t.getDurationMS();
   t.start();
-  mReverseLUT = reverseSymbolLookupTable_t{stats};
+  mDecoderTable = decoderTable_t{stats};
   t.stop();
-  LOG(debug1) << "ReverseSymbolLookupTable inclusive time (ms): " << t.getDurationMS();
+  LOG(debug1) << "PackedDecoderTable inclusive time (ms): " << t.getDurationMS();
 };
 } // namespace internal
 } // namespace rans
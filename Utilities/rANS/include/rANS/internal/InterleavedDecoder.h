@@ -0,0 +1,256 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedDecoder.h
+/// @author agent
+/// @since  2026-10-16
+/// @brief  set of nStreams_V rANS decoder states with a vectorized state update
+
+#ifndef RANS_INTERNAL_INTERLEAVEDDECODER_H
+#define RANS_INTERNAL_INTERLEAVEDDECODER_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include "rANS/internal/DecoderSymbol.h"
+#include "rANS/internal/helper.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// Counterpart of InterleavedEncoder: symbol i of the message is decoded by state (i % nStreams_V).
+// advanceSymbols() updates all states at once. With AVX2 (4x64 / 8x32 Bit lanes) or SSE4.1
+// (2x64 / 4x32 Bit lanes) available at compile time the decoding step of the states is vectorized,
+// renormalization is done only for the lanes which need it, in stream order. Otherwise, or if nStreams_V
+// is not a multiple of the vector width, a scalar loop is used. All paths produce identical results.
+template <typename state_T, typename stream_T, size_t nStreams_V>
+class InterleavedDecoder
+{
+  static_assert((sizeof(state_T) == sizeof(uint32_t) && sizeof(stream_T) == sizeof(uint8_t)) ||
+                  (sizeof(state_T) == sizeof(uint64_t) && sizeof(stream_T) == sizeof(uint32_t)),
+                "Coder can either be 32Bit with 8 Bit stream type or 64 Bit Type with 32 Bit stream type");
+  static_assert(nStreams_V > 0, "need at least one rANS state");
+
+ public:
+  using symbols_t = std::array<const DecoderSymbol*, nStreams_V>;
+
+  explicit InterleavedDecoder(size_t symbolTablePrecission) noexcept;
+
+  inline static constexpr size_t getNStreams() noexcept { return nStreams_V; };
+
+  // Initializes all states, inputIter points to the last element of the encoded stream.
+  template <typename stream_IT>
+  stream_IT init(stream_IT inputIter);
+
+  // Returns the current cumulative frequency of the given stream
+  inline uint32_t get(size_t stream) const noexcept
+  {
+    assert(stream < nStreams_V);
+    return mStates[stream] & mMask;
+  };
+
+  // advance a single state, used for the tail of messages with length % nStreams_V != 0
+  template <typename stream_IT>
+  stream_IT advanceSymbol(stream_IT inputIter, const DecoderSymbol& symbol, size_t stream);
+
+  // advance all states, symbols[i] is the symbol decoded by state i
+  template <typename stream_IT>
+  stream_IT advanceSymbols(stream_IT inputIter, const symbols_t& symbols);
+
+ private:
+  alignas(32) std::array<state_T, nStreams_V> mStates{};
+  size_t mSymbolTablePrecission{};
+  state_T mMask{};
+
+  template <typename stream_IT>
+  std::tuple<state_T, stream_IT> renorm(state_T state, stream_IT inputIter);
+
+  // decoding step of all states without renormalization, returns bitmask of states to be renormalized
+  uint32_t decodeStates(const symbols_t& symbols);
+
+  inline static constexpr size_t LOWER_BOUND_BITS = needs64Bit<state_T>() ? 31 : 23;
+  inline static constexpr state_T LOWER_BOUND = static_cast<state_T>(1) << LOWER_BOUND_BITS; // lower bound of our normalization interval
+  inline static constexpr state_T STREAM_BITS = sizeof(stream_T) * 8;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+InterleavedDecoder<state_T, stream_T, nStreams_V>::InterleavedDecoder(size_t symbolTablePrecission) noexcept
+  : mSymbolTablePrecission{symbolTablePrecission}, mMask{static_cast<state_T>(pow2(symbolTablePrecission) - 1)} {};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::init(stream_IT inputIter)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+  constexpr size_t nWords = sizeof(state_T) / sizeof(stream_T);
+
+  for (auto& state : mStates) {
+    state = 0;
+    for (size_t i = 0; i < nWords; ++i) {
+      state |= static_cast<state_T>(*inputIter) << (i * STREAM_BITS);
+      --inputIter;
+    }
+  }
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+inline stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::advanceSymbol(stream_IT inputIter, const DecoderSymbol& symbol, size_t stream)
+{
+  assert(stream < nStreams_V);
+  state_T newState = mStates[stream];
+  newState = symbol.getFrequency() * (newState >> mSymbolTablePrecission) + (newState & mMask) - symbol.getCumulative();
+  std::tie(mStates[stream], inputIter) = renorm(newState, inputIter);
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+inline stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::advanceSymbols(stream_IT inputIter, const symbols_t& symbols)
+{
+  uint32_t renormMask = decodeStates(symbols);
+  // renormalization has to happen in stream order to match the encoder
+  while (renormMask) {
+    const size_t stream = __builtin_ctz(renormMask);
+    renormMask &= renormMask - 1;
+    std::tie(mStates[stream], inputIter) = renorm(mStates[stream], inputIter);
+  }
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+inline uint32_t InterleavedDecoder<state_T, stream_T, nStreams_V>::decodeStates(const symbols_t& symbols)
+{
+  static_assert(nStreams_V <= 32, "renormalization bitmask supports up to 32 streams");
+  uint32_t renormMask = 0;
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#if defined(__AVX2__)
+  constexpr size_t VectorBytes = 32;
+#else
+  constexpr size_t VectorBytes = 16;
+#endif
+  constexpr size_t nLanes = VectorBytes / sizeof(state_T);
+
+  if constexpr (nStreams_V % nLanes == 0) {
+    alignas(32) std::array<state_T, nStreams_V> frequencies;
+    alignas(32) std::array<state_T, nStreams_V> cumulatives;
+    for (size_t stream = 0; stream < nStreams_V; ++stream) {
+      frequencies[stream] = symbols[stream]->getFrequency();
+      cumulatives[stream] = symbols[stream]->getCumulative();
+    }
+#if defined(__AVX2__)
+    using vec_t = __m256i;
+    const vec_t mask = needs64Bit<state_T>() ? _mm256_set1_epi64x(mMask) : _mm256_set1_epi32(mMask);
+    const vec_t zero = _mm256_setzero_si256();
+    const __m128i shift = _mm_cvtsi64_si128(mSymbolTablePrecission);
+#else
+    using vec_t = __m128i;
+    const vec_t mask = needs64Bit<state_T>() ? _mm_set1_epi64x(mMask) : _mm_set1_epi32(mMask);
+    const vec_t zero = _mm_setzero_si128();
+    const __m128i shift = _mm_cvtsi64_si128(mSymbolTablePrecission);
+#endif
+
+    for (size_t stream = 0; stream < nStreams_V; stream += nLanes) {
+      auto* const statePtr = reinterpret_cast<vec_t*>(&mStates[stream]);
+      const auto* const freqPtr = reinterpret_cast<const vec_t*>(&frequencies[stream]);
+      const auto* const cumulPtr = reinterpret_cast<const vec_t*>(&cumulatives[stream]);
+#if defined(__AVX2__)
+      vec_t state = _mm256_load_si256(statePtr);
+      const vec_t frequency = _mm256_load_si256(freqPtr);
+      const vec_t cumulative = _mm256_load_si256(cumulPtr);
+      if constexpr (needs64Bit<state_T>()) {
+        // frequency * (state >> precision) needs a 32x64 Bit multiply, split it into two 32x32 Bit multiplies.
+        const vec_t quotient = _mm256_srl_epi64(state, shift);
+        const vec_t productLo = _mm256_mul_epu32(quotient, frequency);
+        const vec_t productHi = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(quotient, 32), frequency), 32);
+        state = _mm256_sub_epi64(_mm256_add_epi64(_mm256_add_epi64(productLo, productHi), _mm256_and_si256(state, mask)), cumulative);
+        const vec_t needsRenorm = _mm256_cmpeq_epi64(_mm256_srli_epi64(state, LOWER_BOUND_BITS), zero);
+        renormMask |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(needsRenorm))) << stream;
+      } else {
+        const vec_t quotient = _mm256_srl_epi32(state, shift);
+        state = _mm256_sub_epi32(_mm256_add_epi32(_mm256_mullo_epi32(quotient, frequency), _mm256_and_si256(state, mask)), cumulative);
+        const vec_t needsRenorm = _mm256_cmpeq_epi32(_mm256_srli_epi32(state, LOWER_BOUND_BITS), zero);
+        renormMask |= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(needsRenorm))) << stream;
+      }
+      _mm256_store_si256(statePtr, state);
+#else
+      vec_t state = _mm_load_si128(statePtr);
+      const vec_t frequency = _mm_load_si128(freqPtr);
+      const vec_t cumulative = _mm_load_si128(cumulPtr);
+      if constexpr (needs64Bit<state_T>()) {
+        // frequency * (state >> precision) needs a 32x64 Bit multiply, split it into two 32x32 Bit multiplies.
+        const vec_t quotient = _mm_srl_epi64(state, shift);
+        const vec_t productLo = _mm_mul_epu32(quotient, frequency);
+        const vec_t productHi = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(quotient, 32), frequency), 32);
+        state = _mm_sub_epi64(_mm_add_epi64(_mm_add_epi64(productLo, productHi), _mm_and_si128(state, mask)), cumulative);
+        const vec_t needsRenorm = _mm_cmpeq_epi64(_mm_srli_epi64(state, LOWER_BOUND_BITS), zero);
+        renormMask |= static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(needsRenorm))) << stream;
+      } else {
+        const vec_t quotient = _mm_srl_epi32(state, shift);
+        state = _mm_sub_epi32(_mm_add_epi32(_mm_mullo_epi32(quotient, frequency), _mm_and_si128(state, mask)), cumulative);
+        const vec_t needsRenorm = _mm_cmpeq_epi32(_mm_srli_epi32(state, LOWER_BOUND_BITS), zero);
+        renormMask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(needsRenorm))) << stream;
+      }
+      _mm_store_si128(statePtr, state);
+#endif
+    }
+    return renormMask;
+  }
+#endif
+
+  // scalar fallback
+  for (size_t stream = 0; stream < nStreams_V; ++stream) {
+    state_T& state = mStates[stream];
+    state = symbols[stream]->getFrequency() * (state >> mSymbolTablePrecission) + (state & mMask) - symbols[stream]->getCumulative();
+    renormMask |= static_cast<uint32_t>(state < LOWER_BOUND) << stream;
+  }
+  return renormMask;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+inline std::tuple<state_T, stream_IT> InterleavedDecoder<state_T, stream_T, nStreams_V>::renorm(state_T state, stream_IT inputIter)
+{
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+
+  if (state < LOWER_BOUND) {
+    if constexpr (needs64Bit<state_T>()) {
+      state = (state << STREAM_BITS) | *inputIter;
+      --inputIter;
+      assert(state >= LOWER_BOUND);
+    } else {
+      do {
+        state = (state << STREAM_BITS) | *inputIter;
+        --inputIter;
+      } while (state < LOWER_BOUND);
+    }
+  }
+  return std::make_tuple(state, inputIter);
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_INTERLEAVEDDECODER_H */
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedEncoder.h
+/// @author agent
+/// @since  2026-10-16
+/// @brief  set of nStreams_V rANS encoder states working on a common output stream
+
+#ifndef RANS_INTERNAL_INTERLEAVEDENCODER_H
+#define RANS_INTERNAL_INTERLEAVEDENCODER_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "rANS/internal/Encoder.h"
+#include "rANS/internal/EncoderSymbol.h"
+#include "rANS/internal/helper.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// Symbol i of a message is always coded by state (i % nStreams_V). Since encoding works in reverse,
+// the states are flushed from the last to the first one, so that the decoder can initialize
+// them in natural order while reading the stream backwards.
+template <typename state_T, typename stream_T, size_t nStreams_V>
+class InterleavedEncoder
+{
+  static_assert(nStreams_V > 0, "need at least one rANS state");
+
+ public:
+  explicit InterleavedEncoder(size_t symbolTablePrecission) noexcept
+    : mCoders{makeCoders(symbolTablePrecission, std::make_index_sequence<nStreams_V>{})} {};
+
+  inline static constexpr size_t getNStreams() noexcept { return nStreams_V; };
+
+  template <typename stream_IT>
+  inline stream_IT putSymbol(stream_IT outputIter, const EncoderSymbol<state_T>& symbol, size_t stream)
+  {
+    assert(stream < nStreams_V);
+    return mCoders[stream].putSymbol(outputIter, symbol);
+  };
+
+  template <typename stream_IT>
+  stream_IT flush(stream_IT outputIter)
+  {
+    for (size_t stream = nStreams_V; stream-- > 0;) {
+      outputIter = mCoders[stream].flush(outputIter);
+    }
+    return outputIter;
+  };
+
+ private:
+  using coder_t = Encoder<state_T, stream_T>;
+
+  template <size_t... Is>
+  static std::array<coder_t, nStreams_V> makeCoders(size_t symbolTablePrecission, std::index_sequence<Is...>) noexcept
+  {
+    return {((void)Is, coder_t{symbolTablePrecission})...};
+  };
+
+  std::array<coder_t, nStreams_V> mCoders;
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_INTERLEAVEDENCODER_H */
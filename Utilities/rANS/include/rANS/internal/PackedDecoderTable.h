@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   PackedDecoderTable.h
+/// @author agent
+/// @since  2026-10-16
+/// @brief  Cache friendly replacement of ReverseSymbolLookupTable + SymbolTable<DecoderSymbol> for decoding
+
+#ifndef RANS_INTERNAL_PACKEDDECODERTABLE_H
+#define RANS_INTERNAL_PACKEDDECODERTABLE_H
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <fairlogger/Logger.h>
+
+#include "rANS/internal/helper.h"
+#include "rANS/internal/DecoderSymbol.h"
+#include "rANS/internal/SymbolStatistics.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// ReverseSymbolLookupTable has one entry per cumulative frequency, i.e. 2^precision entries, and the DecoderSymbol
+// of the found symbol has to be fetched from the SymbolTable in a second, indirect, lookup. For precisions above
+// ~14 Bits this does not fit in L1/L2 anymore and the decoding becomes memory bound.
+// Here the symbol, its frequency and cumulative frequency are packed into one 16 Byte entry, entries of used symbols
+// are stored sorted by cumulative frequency. The cumulative frequency range is split in 2^bucketBits buckets, each
+// pointing to the entry containing its lower edge, with bucketBits between MinBucketBits and MaxBucketBits chosen
+// to have ~2 buckets per used symbol. For precision <= bucketBits this is a direct (tANS like) lookup, otherwise
+// the few entries starting inside the bucket are scanned. The size of the tables is driven by the number of used
+// symbols rather than by the precision.
+class PackedDecoderTable
+{
+ public:
+  using symbol_t = SymbolStatistics::symbol_t;
+  using count_t = SymbolStatistics::count_t;
+
+  struct alignas(16) Entry {
+    DecoderSymbol decoderSymbol{};
+    symbol_t symbol{};
+    uint32_t isEscape{};
+  };
+
+  inline static constexpr size_t MinBucketBits = 10;
+  inline static constexpr size_t MaxBucketBits = 16;
+  inline static constexpr size_t MaxLinearScan = 8;
+
+  //TODO(milettri): fix once ROOT cling respects the standard http://wg21.link/p1286r2
+  PackedDecoderTable() noexcept {}; //NOLINT
+
+  explicit PackedDecoderTable(const SymbolStatistics& symbolStats);
+
+  inline const Entry& operator[](count_t cumul) const noexcept
+  {
+    const size_t bucket = cumul >> mBucketShift;
+    assert(bucket + 1 < mBuckets.size());
+    uint32_t first = mBuckets[bucket];
+    const uint32_t last = mBuckets[bucket + 1];
+    if (last - first <= MaxLinearScan) {
+      while (mEntries[first + 1].decoderSymbol.getCumulative() <= cumul) {
+        ++first;
+      }
+      return mEntries[first];
+    }
+    const auto next = std::upper_bound(mEntries.begin() + first + 1, mEntries.begin() + last + 1, cumul,
+                                       [](count_t c, const Entry& e) { return c < e.decoderSymbol.getCumulative(); });
+    return *(next - 1);
+  };
+
+  inline size_t getNEntries() const noexcept { return mEntries.size() - 1; };
+  inline size_t getNBuckets() const noexcept { return mBuckets.size() - 1; };
+  inline size_t getSizeB() const noexcept { return mEntries.size() * sizeof(Entry) + mBuckets.size() * sizeof(uint32_t); };
+
+ private:
+  std::vector<Entry> mEntries{};  // used symbols sorted in cumulative frequency + sentinel with cumulative 2^precision
+  std::vector<uint32_t> mBuckets{}; // index of the entry containing the lower edge of the bucket + sentinel
+  size_t mBucketShift{};
+};
+
+inline PackedDecoderTable::PackedDecoderTable(const SymbolStatistics& symbolStats)
+{
+  LOG(trace) << "start building packed decoder table";
+  const size_t precision = symbolStats.getSymbolTablePrecision();
+  const size_t bucketBits = std::min(precision, std::clamp(numBitsForNSymbols(symbolStats.getNUsedAlphabetSymbols()) + 1, MinBucketBits, MaxBucketBits));
+  mBucketShift = precision - bucketBits;
+
+  mEntries.reserve(symbolStats.getNUsedAlphabetSymbols() + 2);
+  for (size_t index = 0; index < symbolStats.size(); ++index) {
+    const auto [symFrequency, symCumulated] = symbolStats.at(index);
+    if (symFrequency) {
+      const uint32_t isEscape = index == symbolStats.size() - 1; // escape symbol is the last one
+      mEntries.push_back({DecoderSymbol{symFrequency, symCumulated, precision}, static_cast<symbol_t>(symbolStats.getMinSymbol() + index), isEscape});
+    }
+  }
+  // SymbolStatistics arranges the cumulative frequencies in symbol order, with the escape symbol last
+  assert(std::is_sorted(mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b) { return a.decoderSymbol.getCumulative() < b.decoderSymbol.getCumulative(); }));
+  Entry sentinel{};
+  sentinel.decoderSymbol = DecoderSymbol{0, static_cast<count_t>(pow2(precision)), precision};
+  mEntries.push_back(sentinel);
+
+  const size_t nBuckets = pow2(bucketBits);
+  mBuckets.resize(nBuckets + 1);
+  uint32_t entry = 0;
+  for (size_t bucket = 0; bucket < nBuckets; ++bucket) {
+    const count_t lowerEdge = bucket << mBucketShift;
+    while (mEntries[entry + 1].decoderSymbol.getCumulative() <= lowerEdge) {
+      ++entry;
+    }
+    mBuckets[bucket] = entry;
+  }
+  mBuckets[nBuckets] = mEntries.size() - 2; // last real entry
+
+// advanced diagnostics for debug builds
+#if !defined(NDEBUG)
+  LOG(debug2) << "packedDecoderTableProperties: {"
+              << "entries: " << getNEntries() << ", "
+              << "buckets: " << getNBuckets() << ", "
+              << "sizeB: " << getSizeB() << "}";
+#endif
+  LOG(trace) << "done building packed decoder table";
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_PACKEDDECODERTABLE_H */
@@ -30,6 +30,9 @@ namespace rans
 namespace internal
 {
 
+// number of interleaved rANS states used by the encoders/decoders unless requested otherwise
+inline constexpr size_t DefaultNStreams = 2;
+
 template <typename T>
 inline constexpr bool needs64Bit() noexcept
 {
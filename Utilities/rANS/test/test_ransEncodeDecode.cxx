@@ -121,27 +121,27 @@ struct EncodeDecodeBase {
   std::vector<typename Params<coder_T>::source_t> decodeBuffer{};
 };
 
-template <typename coder_T, class dictString_T, class testString_T>
+template <typename coder_T, class dictString_T, class testString_T, size_t nStreams_V = o2::rans::internal::DefaultNStreams>
 struct EncodeDecode : public EncodeDecodeBase<o2::rans::Encoder, o2::rans::Decoder, coder_T, dictString_T, testString_T> {
   void encode() override
   {
-    BOOST_CHECK_NO_THROW(this->encoder.process(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer)));
+    BOOST_CHECK_NO_THROW(this->encoder.template process<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer)));
   };
   void decode() override
   {
-    BOOST_CHECK_NO_THROW(this->decoder.process(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size()));
+    BOOST_CHECK_NO_THROW(this->decoder.template process<nStreams_V>(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size()));
   };
 };
 
-template <typename coder_T, class dictString_T, class testString_T>
+template <typename coder_T, class dictString_T, class testString_T, size_t nStreams_V = o2::rans::internal::DefaultNStreams>
 struct EncodeDecodeLiteral : public EncodeDecodeBase<o2::rans::LiteralEncoder, o2::rans::LiteralDecoder, coder_T, dictString_T, testString_T> {
   void encode() override
   {
-    BOOST_CHECK_NO_THROW(this->encoder.process(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer), literals));
+    BOOST_CHECK_NO_THROW(this->encoder.template process<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer), literals));
   };
   void decode() override
   {
-    BOOST_CHECK_NO_THROW(this->decoder.process(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size(), literals));
+    BOOST_CHECK_NO_THROW(this->decoder.template process<nStreams_V>(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size(), literals));
     BOOST_CHECK(literals.empty());
   };
 
@@ -181,6 +181,25 @@ using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, Em
                                       EncodeDecodeDedup<uint64_t, FullTestString, FullTestString>>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, testCase_T, testCase_t)
+{
+  testCase_T testCase;
+  testCase.encode();
+  testCase.decode();
+  testCase.check();
+};
+
+using interleavedTestCase_t = boost::mpl::vector<EncodeDecode<uint32_t, FullTestString, FullTestString, 4>,
+                                                 EncodeDecode<uint64_t, FullTestString, FullTestString, 4>,
+                                                 EncodeDecode<uint32_t, FullTestString, FullTestString, 8>,
+                                                 EncodeDecode<uint64_t, FullTestString, FullTestString, 8>,
+                                                 EncodeDecode<uint64_t, FullTestString, FullTestString, 16>,
+                                                 EncodeDecode<uint64_t, EmptyTestString, EmptyTestString, 16>,
+                                                 EncodeDecodeLiteral<uint32_t, EmptyTestString, FullTestString, 4>,
+                                                 EncodeDecodeLiteral<uint64_t, EmptyTestString, FullTestString, 4>,
+                                                 EncodeDecodeLiteral<uint64_t, FullTestString, FullTestString, 8>,
+                                                 EncodeDecodeLiteral<uint64_t, EmptyTestString, FullTestString, 16>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecodeInterleaved, testCase_T, interleavedTestCase_t)
 {
   testCase_T testCase;
   testCase.encode();
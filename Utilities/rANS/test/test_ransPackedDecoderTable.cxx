@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   test_ransPackedDecoderTable.cxx
+/// @author agent
+/// @since  2026-10-16
+/// @brief
+
+#define BOOST_TEST_MODULE Utility test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+
+#include "rANS/rans.h"
+#include "rANS/internal/ReverseSymbolLookupTable.h"
+
+// the packed table must reproduce the ReverseSymbolLookupTable + SymbolTable lookup for every cumulative frequency
+void checkAgainstReference(const o2::rans::internal::SymbolStatistics& symbolStats)
+{
+  using namespace o2::rans::internal;
+  const ReverseSymbolLookupTable rLut{symbolStats};
+  const SymbolTable<DecoderSymbol> symbolTable{symbolStats};
+  const PackedDecoderTable table{symbolStats};
+
+  BOOST_CHECK_EQUAL(table.getNEntries(), symbolTable.getNUsedAlphabetSymbols());
+  BOOST_CHECK(table.getNBuckets() <= o2::rans::internal::pow2(PackedDecoderTable::MaxBucketBits));
+  for (size_t cumul = 0; cumul < rLut.size(); ++cumul) {
+    const auto symbol = rLut[cumul];
+    const auto& entry = table[cumul];
+    BOOST_REQUIRE_EQUAL(entry.symbol, symbol);
+    BOOST_REQUIRE_EQUAL(bool(entry.isEscape), symbolTable.isEscapeSymbol(symbol));
+    BOOST_REQUIRE_EQUAL(entry.decoderSymbol.getFrequency(), symbolTable[symbol].getFrequency());
+    BOOST_REQUIRE_EQUAL(entry.decoderSymbol.getCumulative(), symbolTable[symbol].getCumulative());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+  const std::vector<int32_t> A{};
+  const o2::rans::internal::SymbolStatistics symbolStats{A.begin(), A.end(), 0, 0u, 0u};
+  checkAgainstReference(symbolStats);
+}
+
+BOOST_AUTO_TEST_CASE(test_small)
+{
+  const std::vector<int> A{5, 5, 6, 6, 8, 8, 8, 8, 8, -1, -5, 2, 7, 3};
+  for (size_t scaleBits : {8, 12, 17}) {
+    o2::rans::FrequencyTable ft;
+    ft.addSamples(A.begin(), A.end());
+    checkAgainstReference(o2::rans::internal::SymbolStatistics{std::move(ft), scaleBits});
+  }
+}
+
+const size_t precisions[] = {0, 10, 16, 20};
+
+BOOST_DATA_TEST_CASE(test_largeAlphabet, boost::unit_test::data::make(precisions), scaleBits)
+{
+  // many rare symbols, so that the buckets of the high precision tables contain many entries
+  std::mt19937 mt(42);
+  std::geometric_distribution<int> dist(0.002);
+  std::vector<int> A(100000);
+  std::generate(A.begin(), A.end(), [&]() { return dist(mt) - 100; });
+  o2::rans::FrequencyTable ft;
+  ft.addSamples(A.begin(), A.end());
+  checkAgainstReference(o2::rans::internal::SymbolStatistics{std::move(ft), scaleBits});
+}
@@ -22,6 +22,7 @@
 #include <boost/mpl/vector.hpp>
 
 #include "rANS/rans.h"
+#include "rANS/internal/ReverseSymbolLookupTable.h"
 
 template <typename T>
 size_t getNUniqueSymbols(const T& container)